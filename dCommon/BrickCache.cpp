@@ -0,0 +1,254 @@
+#include "BrickCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <thread>
+
+#include "tinyxml2.h"
+
+#include "AssetManager.h"
+#include "BinaryIO.h"
+#include "BinaryPathFinder.h"
+#include "Game.h"
+#include "GeneralUtils.h"
+
+namespace {
+	constexpr char MAGIC[4] = { 'B', 'R', 'K', 'C' };
+
+	bool ReadUInt32(const char* data, size_t size, size_t& offset, uint32_t& value) {
+		if (offset + sizeof(uint32_t) > size) return false;
+
+		std::memcpy(&value, data + offset, sizeof(uint32_t));
+		offset += sizeof(uint32_t);
+
+		return true;
+	}
+
+	/**
+	 * @return The element holding the bricks of a model, searchTerm is set to the name of the brick elements in it
+	 */
+	const tinyxml2::XMLElement* FindBrickList(const tinyxml2::XMLDocument& doc, const char*& searchTerm) {
+		auto* lxfml = doc.FirstChildElement("LXFML");
+		if (!lxfml) return nullptr;
+
+		searchTerm = "Brick";
+		auto* brickList = lxfml->FirstChildElement("Bricks");
+		if (brickList) return brickList;
+
+		searchTerm = "Part";
+		auto* scene = lxfml->FirstChildElement("Scene");
+		auto* model = scene ? scene->FirstChildElement("Model") : nullptr;
+
+		return model ? model->FirstChildElement("Group") : nullptr;
+	}
+}
+
+bool BrickCache::Load(const std::filesystem::path& filePath) {
+	m_Entries.clear();
+
+	if (!m_File.Open(filePath)) return false;
+
+	const auto* data = m_File.GetData();
+	const auto size = m_File.GetSize();
+	size_t offset = sizeof(MAGIC);
+
+	uint32_t version = 0;
+	uint32_t entryCount = 0;
+	if (size < sizeof(MAGIC) || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+		!ReadUInt32(data, size, offset, version) || version != VERSION ||
+		!ReadUInt32(data, size, offset, entryCount)) {
+		m_File.Close();
+		return false;
+	}
+
+	m_Entries.reserve(entryCount);
+
+	for (uint32_t i = 0; i < entryCount; i++) {
+		uint32_t pathLength = 0;
+		if (!ReadUInt32(data, size, offset, pathLength) || offset + pathLength > size) break;
+
+		std::string path(data + offset, pathLength);
+		offset += pathLength;
+
+		Entry entry{};
+		if (!ReadUInt32(data, size, offset, entry.fileStamp) || !ReadUInt32(data, size, offset, entry.brickCount)) break;
+
+		entry.offset = offset;
+		offset += static_cast<size_t>(entry.brickCount) * sizeof(Brick);
+		if (offset > size) break;
+
+		m_Entries.insert_or_assign(std::move(path), entry);
+	}
+
+	return true;
+}
+
+bool BrickCache::Find(const std::string& lxfmlPath, uint32_t fileStamp, std::vector<Brick>& bricks) const {
+	const auto entry = m_Entries.find(NormalizePath(lxfmlPath));
+
+	if (entry == m_Entries.end() || entry->second.fileStamp != fileStamp) return false;
+
+	bricks.resize(entry->second.brickCount);
+	std::memcpy(bricks.data(), m_File.GetData() + entry->second.offset, bricks.size() * sizeof(Brick));
+
+	return true;
+}
+
+int32_t BrickCache::Build(const std::vector<std::string>& lxfmlPaths, const std::filesystem::path& filePath) {
+	// Reading goes through the AssetManager, which is single threaded, so load every model up front
+	std::vector<std::string> files;
+	std::vector<std::pair<std::string, std::pair<uint32_t, std::vector<Brick>>>> entries;
+
+	for (const auto& path : lxfmlPaths) {
+		uint32_t stamp = 0;
+		if (!Game::assetManager->GetFileStamp(path.c_str(), &stamp)) continue;
+
+		auto buffer = Game::assetManager->GetFileAsBuffer(path.c_str());
+		if (!buffer.m_Success) continue;
+
+		files.emplace_back(buffer.m_Base, buffer.size());
+		entries.push_back({ path, { stamp, {} } });
+
+		buffer.close();
+	}
+
+	std::vector<uint8_t> parsed(files.size(), false);
+	const auto workerCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+	auto parseStripe = [&](size_t first) {
+		for (size_t i = first; i < files.size(); i += workerCount) {
+			parsed[i] = ParseLxfml(files[i].data(), files[i].size(), entries[i].second.second);
+		}
+	};
+
+	std::vector<std::future<void>> workers;
+	for (size_t i = 1; i < workerCount; i++) {
+		workers.push_back(std::async(std::launch::async, parseStripe, i));
+	}
+
+	parseStripe(0);
+	for (auto& worker : workers) worker.get();
+
+	// Drop models that failed to parse so they are retried at runtime
+	size_t written = 0;
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (parsed[i]) entries[written++] = std::move(entries[i]);
+	}
+	entries.resize(written);
+
+	if (!Write(filePath, entries)) return -1;
+
+	return static_cast<int32_t>(entries.size());
+}
+
+bool BrickCache::Write(const std::filesystem::path& filePath, const std::vector<std::pair<std::string, std::pair<uint32_t, std::vector<Brick>>>>& entries) {
+	// Write to a temporary file first so running servers never map a half written cache
+	auto tempPath = filePath;
+	tempPath += ".tmp";
+
+	{
+		std::ofstream file(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file.good()) return false;
+
+		file.write(MAGIC, sizeof(MAGIC));
+		BinaryIO::BinaryWrite<uint32_t>(file, VERSION);
+		BinaryIO::BinaryWrite<uint32_t>(file, entries.size());
+
+		for (const auto& [path, model] : entries) {
+			const auto key = NormalizePath(path);
+
+			BinaryIO::BinaryWrite<uint32_t>(file, key.size());
+			file.write(key.data(), key.size());
+			BinaryIO::BinaryWrite<uint32_t>(file, model.first);
+			BinaryIO::BinaryWrite<uint32_t>(file, model.second.size());
+			file.write(reinterpret_cast<const char*>(model.second.data()), model.second.size() * sizeof(Brick));
+		}
+
+		if (!file.good()) return false;
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempPath, filePath, error);
+
+	return !error;
+}
+
+bool BrickCache::ParseLxfml(const char* data, size_t length, std::vector<Brick>& bricks) {
+	if (data == nullptr || length == 0) return false;
+
+	tinyxml2::XMLDocument doc;
+	if (doc.Parse(data, length) != 0) return false;
+
+	const char* searchTerm = nullptr;
+	auto* brickList = FindBrickList(doc, searchTerm);
+	if (!brickList) return false;
+
+	auto* currentBrick = brickList->FirstChildElement(searchTerm);
+	while (currentBrick != nullptr) {
+
+		auto* part = currentBrick->FirstChildElement("Part");
+		if (part == nullptr) part = currentBrick;
+
+		if (part->Attribute("designID") != nullptr) {
+			Brick brick{ static_cast<uint32_t>(part->IntAttribute("designID")) };
+
+			// Depends on the file, some don't specify a list but just a single material
+			const auto* materialList = part->Attribute("materials");
+			const auto* materialID = part->Attribute("materialID");
+
+			if (materialList != nullptr) {
+				std::string materialString(materialList);
+				const auto materials = GeneralUtils::SplitString(materialString, ',');
+
+				if (!materials.empty()) {
+					brick.materialID = std::stoi(materials[0]);
+				} else {
+					brick.materialID = 0;
+				}
+			} else if (materialID != nullptr) {
+				brick.materialID = std::stoi(materialID);
+			} else {
+				brick.materialID = 0; // This is bad, makes it so the minigame can't be played
+			}
+
+			bricks.push_back(brick);
+		}
+
+		currentBrick = currentBrick->NextSiblingElement(searchTerm);
+	}
+
+	return true;
+}
+
+bool BrickCache::ParseDesignIds(const char* data, size_t length, std::vector<uint32_t>& designIds) {
+	if (data == nullptr || length == 0) return false;
+
+	tinyxml2::XMLDocument doc;
+	if (doc.Parse(data, length) != 0) return false;
+
+	const char* searchTerm = nullptr;
+	auto* brickList = FindBrickList(doc, searchTerm);
+	if (!brickList) return false;
+
+	for (auto* brick = brickList->FirstChildElement(searchTerm); brick != nullptr; brick = brick->NextSiblingElement(searchTerm)) {
+		if (brick->Attribute("designID") != nullptr) {
+			designIds.push_back(static_cast<uint32_t>(brick->IntAttribute("designID")));
+		}
+	}
+
+	return true;
+}
+
+std::string BrickCache::NormalizePath(const std::string& lxfmlPath) {
+	auto key = lxfmlPath;
+	std::transform(key.begin(), key.end(), key.begin(), [](uint8_t c) { return std::tolower(c); });
+	std::replace(key.begin(), key.end(), '\\', '/');
+
+	return key;
+}
+
+std::filesystem::path BrickCache::GetDefaultPath() {
+	return BinaryPathFinder::GetBinaryDir() / "resServer" / "brickcache.bin";
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dCommonVars.h"
+#include "MappedFile.h"
+
+/**
+ * An on-disk cache of the bricks in LXFML models, so models do not have to be parsed on every server start.
+ * Entries are keyed by the model path and the stamp of the model file (see AssetManager::GetFileStamp), so a
+ * changed model is never read from a stale cache, and an up to date model is found without reading it.
+ *
+ * File layout (little endian):
+ *   char[4] magic "BRKC", uint32 version, uint32 entry count, then for each entry:
+ *   uint32 path length, char[] path, uint32 file stamp, uint32 brick count, Brick[] bricks
+ */
+class BrickCache {
+public:
+	/**
+	 * Maps a cache file into memory.  A missing or invalid file leaves the cache empty.
+	 *
+	 * @param filePath The cache file to load
+	 * @return Whether or not the cache was loaded
+	 */
+	bool Load(const std::filesystem::path& filePath);
+
+	/**
+	 * Looks up the bricks of a model in the cache.
+	 *
+	 * @param lxfmlPath The path of the model
+	 * @param fileStamp The stamp of the model file
+	 * @param bricks Filled with the bricks of the model on success
+	 * @return Whether or not an up to date entry was found
+	 */
+	bool Find(const std::string& lxfmlPath, uint32_t fileStamp, std::vector<Brick>& bricks) const;
+
+	size_t GetEntryCount() const { return m_Entries.size(); }
+
+	/**
+	 * Reads and parses the given models and writes them to a cache file.  Parsing is spread across all cores.
+	 *
+	 * @param lxfmlPaths The asset paths of the models to include
+	 * @param filePath The cache file to write
+	 * @return The number of models written, or -1 if the file could not be written
+	 */
+	static int32_t Build(const std::vector<std::string>& lxfmlPaths, const std::filesystem::path& filePath);
+
+	/**
+	 * Writes a cache file.
+	 *
+	 * @param filePath The cache file to write
+	 * @param entries For each model its path, file stamp and bricks
+	 * @return Whether or not the file was written
+	 */
+	static bool Write(const std::filesystem::path& filePath, const std::vector<std::pair<std::string, std::pair<uint32_t, std::vector<Brick>>>>& entries);
+
+	/**
+	 * Parses the bricks out of an LXFML model.
+	 *
+	 * @param data The model file contents
+	 * @param length The length of the model file
+	 * @param bricks Filled with the bricks of the model
+	 * @return Whether or not the model was parsed
+	 */
+	static bool ParseLxfml(const char* data, size_t length, std::vector<Brick>& bricks);
+
+	/**
+	 * Parses the design IDs of the bricks in an LXFML model.  Unlike ParseLxfml, which reads the design ID of
+	 * the part inside a brick, this reads the design ID of the brick itself, which is what the brick items of
+	 * a disassembled model are looked up by.
+	 *
+	 * @param data The model file contents
+	 * @param length The length of the model file
+	 * @param designIds Filled with the design ID of every brick in the model
+	 * @return Whether or not the model was parsed
+	 */
+	static bool ParseDesignIds(const char* data, size_t length, std::vector<uint32_t>& designIds);
+
+	/**
+	 * @return The key a model path is stored under, lower case with forward slashes
+	 */
+	static std::string NormalizePath(const std::string& lxfmlPath);
+
+	/**
+	 * @return Where servers read the brick cache from
+	 */
+	static std::filesystem::path GetDefaultPath();
+
+	static constexpr uint32_t VERSION = 2;
+private:
+	struct Entry {
+		uint32_t fileStamp;
+		uint32_t brickCount;
+		size_t offset; // Offset of the first brick in the mapped file
+	};
+
+	MappedFile m_File;
+	std::unordered_map<std::string, Entry> m_Entries;
+};
@@ -0,0 +1,163 @@
+#include "Crc32.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CRC32_X86
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CRC32_TARGET
+#else
+#include <cpuid.h>
+#define CRC32_TARGET __attribute__((target("pclmul,ssse3")))
+#endif
+
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+#endif
+
+namespace {
+	constexpr uint32_t POLYNOMIAL = 0x04C11DB7;
+
+	// Lookup tables for slicing-by-8.  Table n holds the crc of a byte followed by n zero bytes.
+	struct Crc32Tables {
+		std::array<std::array<uint32_t, 256>, 8> tables{};
+
+		constexpr Crc32Tables() {
+			for (uint32_t i = 0; i < 256; i++) {
+				uint32_t crc = i << 24;
+				for (int j = 0; j < 8; j++) {
+					crc = (crc << 1) ^ ((crc & 0x80000000) ? POLYNOMIAL : 0);
+				}
+				tables[0][i] = crc;
+			}
+
+			for (uint32_t i = 0; i < 256; i++) {
+				for (size_t n = 1; n < 8; n++) {
+					const auto previous = tables[n - 1][i];
+					tables[n][i] = (previous << 8) ^ tables[0][previous >> 24];
+				}
+			}
+		}
+	};
+
+	constexpr Crc32Tables TABLES{};
+
+	// x^n mod P, used to fold 128 bit blocks forward
+	constexpr uint32_t XPowModP(uint32_t n) {
+		uint32_t value = POLYNOMIAL; // x^32 mod P
+		for (uint32_t i = 32; i < n; i++) {
+			value = (value << 1) ^ ((value & 0x80000000) ? POLYNOMIAL : 0);
+		}
+		return value;
+	}
+
+	inline uint32_t LoadBigEndian32(const uint8_t* data) {
+		return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | uint32_t(data[3]);
+	}
+
+	// Under this size the setup cost of folding is not worth it
+	constexpr size_t HARDWARE_MIN_LENGTH = 64;
+}
+
+uint32_t Crc32::CalculateBitwise(uint32_t crc, const uint8_t* data, size_t length) {
+	for (size_t i = 0; i < length; i++) {
+		// xor next byte to upper bits of crc
+		crc ^= (static_cast<uint32_t>(data[i]) << 24);
+		for (int j = 0; j < 8; j++) { // Do eight times.
+			const uint32_t msb = crc >> 31;
+			crc <<= 1;
+			crc ^= (0 - msb) & POLYNOMIAL;
+		}
+	}
+	return crc; // don't complement crc on output
+}
+
+uint32_t Crc32::CalculateSlicing8(uint32_t crc, const uint8_t* data, size_t length) {
+	const auto& t = TABLES.tables;
+
+	while (length >= 8) {
+		crc ^= LoadBigEndian32(data);
+		crc = t[7][crc >> 24] ^ t[6][(crc >> 16) & 0xFF] ^ t[5][(crc >> 8) & 0xFF] ^ t[4][crc & 0xFF] ^
+			t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+
+		data += 8;
+		length -= 8;
+	}
+
+	while (length--) {
+		crc = (crc << 8) ^ t[0][(crc >> 24) ^ *data++];
+	}
+
+	return crc;
+}
+
+#ifdef CRC32_X86
+CRC32_TARGET uint32_t Crc32::CalculateHardware(uint32_t crc, const uint8_t* data, size_t length) {
+	if (length < HARDWARE_MIN_LENGTH) return CalculateSlicing8(crc, data, length);
+
+	// The message is treated as one big polynomial with the first byte as the highest degree, so every
+	// block is byte swapped on load.  The initial crc is the same as xoring it into the first 4 bytes.
+	const __m128i byteSwap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m128i foldConstants = _mm_set_epi64x(XPowModP(192), XPowModP(128));
+
+	__m128i accumulator = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), byteSwap);
+	accumulator = _mm_xor_si128(accumulator, _mm_set_epi32(static_cast<int32_t>(crc), 0, 0, 0));
+
+	data += 16;
+	length -= 16;
+
+	// hi * x^192 + lo * x^128 is congruent to the accumulator moved forward by 128 bits, and fits in 96 bits
+	while (length >= 16) {
+		const __m128i block = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), byteSwap);
+		const __m128i high = _mm_clmulepi64_si128(accumulator, foldConstants, 0x11);
+		const __m128i low = _mm_clmulepi64_si128(accumulator, foldConstants, 0x00);
+		accumulator = _mm_xor_si128(_mm_xor_si128(high, low), block);
+
+		data += 16;
+		length -= 16;
+	}
+
+	// The remaining 128 bit value is congruent to everything folded so far, so finish with the tables
+	alignas(16) uint8_t remainder[16];
+	_mm_store_si128(reinterpret_cast<__m128i*>(remainder), _mm_shuffle_epi8(accumulator, byteSwap));
+
+	crc = CalculateSlicing8(0, remainder, sizeof(remainder));
+	return CalculateSlicing8(crc, data, length);
+}
+
+bool Crc32::HasHardwareSupport() {
+	static const bool supported = []() {
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 1);
+		const auto ecx = static_cast<uint32_t>(info[2]);
+#else
+		uint32_t eax, ebx, ecx, edx;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+#endif
+		const bool pclmul = (ecx >> 1) & 1;
+		const bool ssse3 = (ecx >> 9) & 1;
+		return pclmul && ssse3;
+	}();
+
+	return supported;
+}
+#else
+uint32_t Crc32::CalculateHardware(uint32_t crc, const uint8_t* data, size_t length) {
+	return CalculateSlicing8(crc, data, length);
+}
+
+bool Crc32::HasHardwareSupport() {
+	return false;
+}
+#endif
+
+uint32_t Crc32::Calculate(uint32_t crc, const uint8_t* data, size_t length) {
+	static const auto implementation = HasHardwareSupport() ? &Crc32::CalculateHardware : &Crc32::CalculateSlicing8;
+
+	return implementation(crc, data, length);
+}
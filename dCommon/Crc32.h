@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * The crc used by the client to identify files in its packs.  This is crc-32/mpeg-2: polynomial
+ * 0x04C11DB7, msb first, no reflection and no final xor.
+ * Reference: https://stackoverflow.com/questions/54339800/how-to-modify-crc-32-to-crc-32-mpeg-2
+ */
+namespace Crc32 {
+	/**
+	 * @brief Computes the crc one bit at a time.  Slow, but kept as the reference implementation.
+	 */
+	uint32_t CalculateBitwise(uint32_t crc, const uint8_t* data, size_t length);
+
+	/**
+	 * @brief Computes the crc with slicing-by-8 lookup tables.
+	 */
+	uint32_t CalculateSlicing8(uint32_t crc, const uint8_t* data, size_t length);
+
+	/**
+	 * @brief Computes the crc by folding 16 byte blocks with carry-less multiplication.
+	 * Only call this if HasHardwareSupport returns true.
+	 */
+	uint32_t CalculateHardware(uint32_t crc, const uint8_t* data, size_t length);
+
+	/**
+	 * @brief Whether or not this cpu supports CalculateHardware (PCLMULQDQ and SSSE3)
+	 */
+	bool HasHardwareSupport();
+
+	/**
+	 * @brief Computes the crc with the fastest implementation available on this cpu.
+	 */
+	uint32_t Calculate(uint32_t crc, const uint8_t* data, size_t length);
+}
@@ -0,0 +1,142 @@
+#include "MappedFile.h"
+
+#include "dPlatforms.h"
+
+#if defined(DARKFLAME_PLATFORM_WIN32)
+#include <Windows.h>
+#else
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& filePath, const bool copyOnWrite) {
+	Open(filePath, copyOnWrite);
+}
+
+MappedFile::~MappedFile() {
+	Close();
+}
+
+bool MappedFile::Open(const std::filesystem::path& filePath, const bool copyOnWrite) {
+	Close();
+
+#if defined(DARKFLAME_PLATFORM_WIN32)
+	auto file = CreateFileW(filePath.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	auto mapping = CreateFileMappingW(file, NULL, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) {
+		CloseHandle(file);
+		return false;
+	}
+
+	auto* data = MapViewOfFile(mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+	if (data == NULL) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	m_FileHandle = file;
+	m_MappingHandle = mapping;
+	m_Data = static_cast<const char*>(data);
+	m_Size = static_cast<size_t>(size.QuadPart);
+#else
+	int fd = open(filePath.string().c_str(), O_RDONLY);
+	if (fd == -1) return false;
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+		close(fd);
+		return false;
+	}
+
+	auto* data = copyOnWrite
+		? mmap(nullptr, fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0)
+		: mmap(nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+	// The mapping holds its own reference to the file, so the descriptor is no longer needed
+	close(fd);
+
+	if (data == MAP_FAILED) return false;
+
+	m_Data = static_cast<const char*>(data);
+	m_Size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+	m_CopyOnWrite = copyOnWrite;
+
+	return true;
+}
+
+void MappedFile::Close() {
+	if (!m_Data) return;
+
+#if defined(DARKFLAME_PLATFORM_WIN32)
+	UnmapViewOfFile(m_Data);
+	CloseHandle(m_MappingHandle);
+	CloseHandle(m_FileHandle);
+
+	m_MappingHandle = nullptr;
+	m_FileHandle = nullptr;
+#else
+	munmap(const_cast<char*>(m_Data), m_Size);
+#endif
+
+	m_Data = nullptr;
+	m_Size = 0;
+	m_CopyOnWrite = false;
+}
+
+bool MappedFile::GetPrivateBytes(size_t& bytes) const {
+	bytes = 0;
+
+	if (!m_Data) return false;
+
+	// Only a copy on write mapping can have private pages
+	if (!m_CopyOnWrite) return true;
+
+#if defined(DARKFLAME_PLATFORM_LINUX)
+	auto* smaps = fopen("/proc/self/smaps", "r");
+	if (!smaps) return false;
+
+	const auto start = reinterpret_cast<uintptr_t>(m_Data);
+
+	char line[512];
+	bool inMapping = false;
+	bool found = false;
+
+	while (fgets(line, sizeof(line), smaps)) {
+		unsigned long rangeStart;
+		unsigned long rangeEnd;
+
+		// Each mapping starts with its address range, followed by its statistics
+		if (sscanf(line, "%lx-%lx ", &rangeStart, &rangeEnd) == 2) {
+			inMapping = rangeStart >= start && rangeStart < start + m_Size;
+			continue;
+		}
+
+		size_t kilobytes;
+
+		if (inMapping && sscanf(line, "Private_Dirty: %zu kB", &kilobytes) == 1) {
+			bytes += kilobytes * 1024;
+			found = true;
+		}
+	}
+
+	fclose(smaps);
+
+	return found;
+#else
+	return false;
+#endif
+}
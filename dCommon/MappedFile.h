@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+/**
+ * A read-only memory mapping of a file on disk.  The mapping is shared with every other
+ * process that maps the same file, so the OS only needs to keep a single copy of its pages.
+ *
+ * A copy on write mapping may also be written to, which gives this process its own copy of just
+ * the pages it writes.  The file itself is never changed.
+ */
+class MappedFile {
+public:
+	MappedFile() = default;
+	MappedFile(const std::filesystem::path& filePath, bool copyOnWrite = false);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/**
+	 * Maps the given file into memory, closing any previous mapping.
+	 *
+	 * @param filePath The file to map
+	 * @param copyOnWrite Whether or not the mapping may be written to
+	 * @return Whether or not the file was mapped
+	 */
+	bool Open(const std::filesystem::path& filePath, bool copyOnWrite = false);
+
+	/**
+	 * Unmaps the file, invalidating any pointers into it.
+	 */
+	void Close();
+
+	bool IsOpen() const { return m_Data != nullptr; }
+	const char* GetData() const { return m_Data; }
+	size_t GetSize() const { return m_Size; }
+
+	/**
+	 * @return The mapping for writing, nullptr unless it was opened copy on write
+	 */
+	char* GetWritableData() const { return m_CopyOnWrite ? const_cast<char*>(m_Data) : nullptr; }
+
+	/**
+	 * Finds how much of the mapping this process holds its own copy of, the pages it wrote to
+	 *
+	 * @param bytes Set to the size of the private pages
+	 * @return Whether or not the platform could tell
+	 */
+	bool GetPrivateBytes(size_t& bytes) const;
+private:
+	const char* m_Data = nullptr;
+	size_t m_Size = 0;
+	bool m_CopyOnWrite = false;
+
+#ifdef _WIN32
+	void* m_FileHandle = nullptr;
+	void* m_MappingHandle = nullptr;
+#endif
+};
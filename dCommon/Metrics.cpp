@@ -15,6 +15,22 @@ std::vector<MetricVariable> Metrics::m_Variables = {
 	MetricVariable::Sleep,
 	MetricVariable::Frame,
 };
+std::unordered_map<MetricCounter, int64_t> Metrics::m_Counters = {};
+std::vector<MetricCounter> Metrics::m_CounterVariables = {
+	MetricCounter::BehaviorContextsAllocated,
+	MetricCounter::BehaviorContextsInUse,
+	MetricCounter::BehaviorContextsPeak,
+	MetricCounter::BehaviorContextsReused,
+	MetricCounter::LineOfSightChecks,
+	MetricCounter::LineOfSightCacheHits,
+	MetricCounter::LineOfSightBlocked,
+	MetricCounter::PathRequests,
+	MetricCounter::PathRequestsMerged,
+	MetricCounter::PathCacheHits,
+	MetricCounter::PathsComputed,
+	MetricCounter::HeightGridHits,
+	MetricCounter::CrowdAgents,
+};
 
 void Metrics::AddMeasurement(MetricVariable variable, int64_t value) {
 	const auto& iter = m_Metrics.find(variable);
@@ -142,12 +158,65 @@ const std::vector<MetricVariable>& Metrics::GetAllMetrics() {
 	return m_Variables;
 }
 
+void Metrics::SetCounter(MetricCounter counter, int64_t value) {
+	m_Counters[counter] = value;
+}
+
+void Metrics::AddToCounter(MetricCounter counter, int64_t value) {
+	m_Counters[counter] += value;
+}
+
+int64_t Metrics::GetCounter(MetricCounter counter) {
+	const auto& iter = m_Counters.find(counter);
+
+	return iter == m_Counters.end() ? 0 : iter->second;
+}
+
+std::string Metrics::MetricCounterToString(MetricCounter counter) {
+	switch (counter) {
+	case MetricCounter::BehaviorContextsAllocated:
+		return "BehaviorContextsAllocated";
+	case MetricCounter::BehaviorContextsInUse:
+		return "BehaviorContextsInUse";
+	case MetricCounter::BehaviorContextsPeak:
+		return "BehaviorContextsPeak";
+	case MetricCounter::BehaviorContextsReused:
+		return "BehaviorContextsReused";
+	case MetricCounter::LineOfSightChecks:
+		return "LineOfSightChecks";
+	case MetricCounter::LineOfSightCacheHits:
+		return "LineOfSightCacheHits";
+	case MetricCounter::LineOfSightBlocked:
+		return "LineOfSightBlocked";
+	case MetricCounter::PathRequests:
+		return "PathRequests";
+	case MetricCounter::PathRequestsMerged:
+		return "PathRequestsMerged";
+	case MetricCounter::PathCacheHits:
+		return "PathCacheHits";
+	case MetricCounter::PathsComputed:
+		return "PathsComputed";
+	case MetricCounter::HeightGridHits:
+		return "HeightGridHits";
+	case MetricCounter::CrowdAgents:
+		return "CrowdAgents";
+
+	default:
+		return "Invalid";
+	}
+}
+
+const std::vector<MetricCounter>& Metrics::GetAllCounters() {
+	return m_CounterVariables;
+}
+
 void Metrics::Clear() {
 	for (const auto& pair : m_Metrics) {
 		delete pair.second;
 	}
 
 	m_Metrics.clear();
+	m_Counters.clear();
 }
 
 /* RSS Memory utilities
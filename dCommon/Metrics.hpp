@@ -22,6 +22,26 @@ enum class MetricVariable : int32_t
 	Frame,
 };
 
+/**
+ * Values that are sampled rather than timed, like pool sizes and hit counts
+ */
+enum class MetricCounter : int32_t
+{
+	BehaviorContextsAllocated,
+	BehaviorContextsInUse,
+	BehaviorContextsPeak,
+	BehaviorContextsReused,
+	LineOfSightChecks,
+	LineOfSightCacheHits,
+	LineOfSightBlocked,
+	PathRequests,
+	PathRequestsMerged,
+	PathCacheHits,
+	PathsComputed,
+	HeightGridHits,
+	CrowdAgents,
+};
+
 struct Metric
 {
 	int64_t measurements[MAX_MEASURMENT_POINTS] = {};
@@ -47,6 +67,12 @@ public:
 	static std::string MetricVariableToString(MetricVariable variable);
 	static const std::vector<MetricVariable>& GetAllMetrics();
 
+	static void SetCounter(MetricCounter counter, int64_t value);
+	static void AddToCounter(MetricCounter counter, int64_t value);
+	static int64_t GetCounter(MetricCounter counter);
+	static std::string MetricCounterToString(MetricCounter counter);
+	static const std::vector<MetricCounter>& GetAllCounters();
+
 	static size_t GetPeakRSS();
 	static size_t GetCurrentRSS();
 	static size_t GetProcessID();
@@ -58,4 +84,6 @@ private:
 
 	static std::unordered_map<MetricVariable, Metric*> m_Metrics;
 	static std::vector<MetricVariable> m_Variables;
+	static std::unordered_map<MetricCounter, int64_t> m_Counters;
+	static std::vector<MetricCounter> m_CounterVariables;
 };
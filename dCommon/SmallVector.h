@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * A vector that stores its first N elements inline and only allocates once it grows past them.
+ * Meant for short lived lists that are almost always small, where the allocation of a std::vector
+ * would cost more than the work done on the list.  Erasing keeps the order of the remaining elements.
+ */
+template<typename T, size_t N>
+class SmallVector {
+public:
+	using value_type = T;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	SmallVector() = default;
+
+	SmallVector(const SmallVector& other) {
+		Reserve(other.m_Size);
+		for (const auto& value : other) new (m_Data + m_Size++) T(value);
+	}
+
+	SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		MoveFrom(other);
+	}
+
+	SmallVector& operator=(const SmallVector& other) {
+		if (this == &other) return *this;
+
+		clear();
+		Reserve(other.m_Size);
+		for (const auto& value : other) new (m_Data + m_Size++) T(value);
+
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		if (this == &other) return *this;
+
+		clear();
+		FreeHeap();
+		MoveFrom(other);
+
+		return *this;
+	}
+
+	~SmallVector() {
+		clear();
+		FreeHeap();
+	}
+
+	void push_back(const T& value) { emplace_back(value); }
+	void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args) {
+		if (m_Size == m_Capacity) {
+			// The argument may live in this vector, so construct it before growing
+			T value(std::forward<Args>(args)...);
+			Reserve(m_Capacity * 2);
+			return *new (m_Data + m_Size++) T(std::move(value));
+		}
+
+		return *new (m_Data + m_Size++) T(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Inserts value before position, moving the elements after it back by one
+	 */
+	iterator insert(const_iterator position, const T& value) {
+		const auto index = static_cast<size_t>(position - begin());
+
+		emplace_back(value);
+		std::rotate(begin() + index, end() - 1, end());
+
+		return begin() + index;
+	}
+
+	void pop_back() {
+		m_Data[--m_Size].~T();
+	}
+
+	iterator erase(const_iterator position) {
+		return erase(position, position + 1);
+	}
+
+	iterator erase(const_iterator first, const_iterator last) {
+		auto* target = const_cast<T*>(first);
+		const auto count = static_cast<size_t>(last - first);
+
+		if (count == 0) return target;
+
+		for (auto* source = target + count; source != end(); ++source, ++target) *target = std::move(*source);
+		while (m_Size > static_cast<size_t>(target - m_Data)) pop_back();
+
+		return const_cast<T*>(first);
+	}
+
+	void clear() {
+		while (m_Size > 0) pop_back();
+	}
+
+	/**
+	 * Makes room for at least capacity elements, never shrinks
+	 */
+	void Reserve(size_t capacity) {
+		if (capacity <= m_Capacity) return;
+
+		auto* data = static_cast<T*>(std::malloc(capacity * sizeof(T)));
+		if (data == nullptr) throw std::bad_alloc();
+
+		for (size_t i = 0; i < m_Size; ++i) {
+			new (data + i) T(std::move(m_Data[i]));
+			m_Data[i].~T();
+		}
+
+		FreeHeap();
+		m_Data = data;
+		m_Capacity = capacity;
+	}
+
+	/**
+	 * @return Whether or not the elements have outgrown the inline storage
+	 */
+	bool IsOnHeap() const { return m_Data != Inline(); }
+
+	T& operator[](size_t index) { return m_Data[index]; }
+	const T& operator[](size_t index) const { return m_Data[index]; }
+
+	T& at(size_t index) {
+		if (index >= m_Size) throw std::out_of_range("SmallVector index out of range");
+		return m_Data[index];
+	}
+
+	const T& at(size_t index) const {
+		if (index >= m_Size) throw std::out_of_range("SmallVector index out of range");
+		return m_Data[index];
+	}
+
+	T& back() { return m_Data[m_Size - 1]; }
+	const T& back() const { return m_Data[m_Size - 1]; }
+
+	iterator begin() { return m_Data; }
+	iterator end() { return m_Data + m_Size; }
+	const_iterator begin() const { return m_Data; }
+	const_iterator end() const { return m_Data + m_Size; }
+
+	size_t size() const { return m_Size; }
+	size_t capacity() const { return m_Capacity; }
+	bool empty() const { return m_Size == 0; }
+
+private:
+	T* Inline() { return reinterpret_cast<T*>(&m_Inline); }
+	const T* Inline() const { return reinterpret_cast<const T*>(&m_Inline); }
+
+	void FreeHeap() {
+		if (IsOnHeap()) std::free(m_Data);
+
+		m_Data = Inline();
+		m_Capacity = N;
+	}
+
+	// Expects this vector to be empty and using its inline storage
+	void MoveFrom(SmallVector& other) {
+		if (other.IsOnHeap()) {
+			m_Data = other.m_Data;
+			m_Size = other.m_Size;
+			m_Capacity = other.m_Capacity;
+
+			other.m_Data = other.Inline();
+			other.m_Size = 0;
+			other.m_Capacity = N;
+
+			return;
+		}
+
+		for (auto& value : other) new (m_Data + m_Size++) T(std::move(value));
+		other.clear();
+	}
+
+	static_assert(N > 0, "SmallVector needs room for at least one inline element");
+
+	std::aligned_storage_t<sizeof(T) * N, alignof(T)> m_Inline;
+	T* m_Data = Inline();
+	size_t m_Size = 0;
+	size_t m_Capacity = N;
+};
@@ -0,0 +1,87 @@
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(uint32_t threadCount) {
+	if (threadCount == 0) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+	for (uint32_t i = 1; i < threadCount; i++) {
+		m_Threads.emplace_back(&WorkerPool::WorkerLoop, this);
+	}
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopping = true;
+	}
+
+	m_WorkAvailable.notify_all();
+
+	for (auto& thread : m_Threads) {
+		thread.join();
+	}
+}
+
+void WorkerPool::Run(size_t taskCount, const std::function<void(size_t)>& task) {
+	if (taskCount == 0) return;
+
+	// Not worth waking anyone up for
+	if (taskCount == 1 || m_Threads.empty()) {
+		for (size_t i = 0; i < taskCount; i++) task(i);
+
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Task = &task;
+		m_TaskCount = taskCount;
+		m_NextTask = 0;
+		m_FinishedTasks = 0;
+		m_Generation++;
+	}
+
+	m_WorkAvailable.notify_all();
+
+	RunTasks();
+
+	// Wait for the last tasks and for every worker to be done with this run before the task goes out of scope
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	m_WorkDone.wait(lock, [this]() { return m_FinishedTasks == m_TaskCount && m_BusyWorkers == 0; });
+	m_Task = nullptr;
+}
+
+void WorkerPool::RunTasks() {
+	while (true) {
+		const auto index = m_NextTask++;
+		if (index >= m_TaskCount) return;
+
+		(*m_Task)(index);
+
+		m_FinishedTasks++;
+	}
+}
+
+void WorkerPool::WorkerLoop() {
+	uint64_t generation = 0;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_WorkAvailable.wait(lock, [this, generation]() { return m_Stopping || m_Generation != generation; });
+
+			if (m_Stopping) return;
+
+			generation = m_Generation;
+			m_BusyWorkers++;
+		}
+
+		RunTasks();
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_BusyWorkers--;
+		}
+
+		m_WorkDone.notify_one();
+	}
+}
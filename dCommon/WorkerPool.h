@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of threads for splitting per frame work into tasks, without the cost of starting a thread
+ * every frame like std::async does.  The thread calling Run works on the tasks as well.
+ */
+class WorkerPool {
+public:
+	/**
+	 * @param threadCount The number of threads working on tasks, including the thread calling Run.
+	 * 0 uses every hardware thread.
+	 */
+	explicit WorkerPool(uint32_t threadCount = 0);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	/**
+	 * Runs task once for each index in [0, taskCount) and waits for all of them to finish.
+	 * Tasks may run in any order and on any thread, so they must not depend on each other.
+	 * Must not be called from within a task.
+	 */
+	void Run(size_t taskCount, const std::function<void(size_t)>& task);
+
+	/**
+	 * @return The number of threads working on tasks, including the thread calling Run
+	 */
+	uint32_t GetThreadCount() const { return m_Threads.size() + 1; }
+
+private:
+	void WorkerLoop();
+
+	/**
+	 * Takes tasks of the current run until there are none left
+	 */
+	void RunTasks();
+
+	std::vector<std::thread> m_Threads;
+
+	std::mutex m_Mutex;
+	std::condition_variable m_WorkAvailable;
+	std::condition_variable m_WorkDone;
+
+	// The current run, guarded by m_Mutex except for the task counters
+	const std::function<void(size_t)>* m_Task = nullptr;
+	size_t m_TaskCount = 0;
+	std::atomic<size_t> m_NextTask{ 0 };
+	std::atomic<size_t> m_FinishedTasks{ 0 };
+	uint64_t m_Generation = 0;
+	uint32_t m_BusyWorkers = 0;
+	bool m_Stopping = false;
+};
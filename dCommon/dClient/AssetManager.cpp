@@ -1,10 +1,11 @@
 #include <filesystem>
+#include <cstring>
 
 #include "AssetManager.h"
 #include "Game.h"
 #include "dLogger.h"
-
-#include <zlib.h>
+#include "Crc32.h"
+#include "dConfig.h"
 
 AssetManager::AssetManager(const std::filesystem::path& path) {
 	if (!std::filesystem::is_directory(path)) {
@@ -48,10 +49,23 @@ AssetManager::AssetManager(const std::filesystem::path& path) {
 			break;
 		}
 	}
+
+	// Budget for decompressed assets kept in memory, 0 disables the cache
+	uint32_t cacheSizeMb = 64;
+	if (Game::config && !Game::config->GetValue("asset_cache_size_mb").empty()) {
+		GeneralUtils::TryParse(Game::config->GetValue("asset_cache_size_mb"), cacheSizeMb);
+	}
+	m_CacheBudget = static_cast<size_t>(cacheSizeMb) * 1024 * 1024;
 }
 
 void AssetManager::LoadPackIndex() {
+	const auto start = std::chrono::steady_clock::now();
+
 	m_PackIndex = new PackIndex(m_RootPath);
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+	Game::logger->Log("AssetManager", "Mapped and indexed %zu packs in %lli ms", m_PackIndex->GetPacks().size(), static_cast<long long>(elapsed));
 }
 
 std::filesystem::path AssetManager::GetResPath() {
@@ -63,33 +77,44 @@ eAssetBundleType AssetManager::GetAssetBundleType() {
 }
 
 bool AssetManager::HasFile(const char* name) {
-	auto fixedName = std::string(name);
-	std::transform(fixedName.begin(), fixedName.end(), fixedName.begin(), [](uint8_t c) { return std::tolower(c); });
-
-	// Special case for unpacked client have BrickModels in upper case
-	if (this->m_AssetBundleType == eAssetBundleType::Unpacked) GeneralUtils::ReplaceInString(fixedName, "brickmodels", "BrickModels");
-
-	std::replace(fixedName.begin(), fixedName.end(), '\\', '/');
+	auto fixedName = GetLoosePath(name);
 	if (std::filesystem::exists(m_ResPath / fixedName)) return true;
 
 	if (this->m_AssetBundleType == eAssetBundleType::Unpacked) return false;
 
-	std::replace(fixedName.begin(), fixedName.end(), '/', '\\');
-	if (fixedName.rfind("client\\res\\", 0) != 0) fixedName = "client\\res\\" + fixedName;
+	return this->m_PackIndex->GetPackFileIndex(GetPackCrc(fixedName)) != nullptr;
+}
+
+bool AssetManager::GetFileStamp(const char* name, uint32_t* stamp) {
+	auto fixedName = GetLoosePath(name);
 
-	uint32_t crc = crc32b(0xFFFFFFFF, (uint8_t*)fixedName.c_str(), fixedName.size());
-	crc = crc32b(crc, (Bytef*)"\0\0\0\0", 4);
+	std::error_code error;
+	const auto loosePath = m_ResPath / fixedName;
+	if (std::filesystem::exists(loosePath, error)) {
+		const uint64_t values[2] = {
+			static_cast<uint64_t>(std::filesystem::file_size(loosePath, error)),
+			static_cast<uint64_t>(std::filesystem::last_write_time(loosePath, error).time_since_epoch().count())
+		};
 
-	for (const auto& item : this->m_PackIndex->GetPackFileIndices()) {
-		if (item.m_Crc == crc) {
-			return true;
-		}
+		*stamp = Crc32::Calculate(0xFFFFFFFF, reinterpret_cast<const uint8_t*>(values), sizeof(values));
+		return true;
 	}
 
-	return false;
+	if (this->m_AssetBundleType == eAssetBundleType::Unpacked) return false;
+
+	const auto crc = GetPackCrc(fixedName);
+	const auto* item = this->m_PackIndex->GetPackFileIndex(crc);
+	if (item == nullptr || item->m_PackFileIndex >= this->m_PackIndex->GetPacks().size()) return false;
+
+	const auto* record = this->m_PackIndex->GetPacks()[item->m_PackFileIndex]->GetRecord(crc);
+	if (record == nullptr) return false;
+
+	*stamp = Crc32::Calculate(0xFFFFFFFF, reinterpret_cast<const uint8_t*>(record->m_UncompressedHash), sizeof(record->m_UncompressedHash));
+	*stamp = Crc32::Calculate(*stamp, reinterpret_cast<const uint8_t*>(&record->m_UncompressedSize), sizeof(record->m_UncompressedSize));
+	return true;
 }
 
-bool AssetManager::GetFile(const char* name, char** data, uint32_t* len) {
+std::string AssetManager::GetLoosePath(const char* name) {
 	auto fixedName = std::string(name);
 	std::transform(fixedName.begin(), fixedName.end(), fixedName.begin(), [](uint8_t c) { return std::tolower(c); });
 	std::replace(fixedName.begin(), fixedName.end(), '\\', '/'); // On the off chance someone has the wrong slashes, force forward slashes
@@ -97,6 +122,51 @@ bool AssetManager::GetFile(const char* name, char** data, uint32_t* len) {
 	// Special case for unpacked client have BrickModels in upper case
 	if (this->m_AssetBundleType == eAssetBundleType::Unpacked) GeneralUtils::ReplaceInString(fixedName, "brickmodels", "BrickModels");
 
+	return fixedName;
+}
+
+uint32_t AssetManager::GetPackCrc(std::string loosePath) {
+	// The crc in side of the pack always uses backslashes, so we need to convert them again...
+	std::replace(loosePath.begin(), loosePath.end(), '/', '\\');
+	if (loosePath.rfind("client\\res\\", 0) != 0) {
+		loosePath = "client\\res\\" + loosePath;
+	}
+
+	uint32_t crc = Crc32::Calculate(0xFFFFFFFF, (uint8_t*)loosePath.c_str(), loosePath.size());
+	return Crc32::Calculate(crc, (uint8_t*)"\0\0\0\0", 4);
+}
+
+bool AssetManager::GetFile(const char* name, char** data, uint32_t* len) {
+	bool isView = false;
+	std::shared_ptr<char> cachedData;
+
+	if (!this->ReadFile(name, data, len, &isView, &cachedData)) return false;
+
+	// Callers of this function own the returned data, so views into a pack or the cache have to be copied
+	if (isView) {
+		auto* copy = (char*)malloc(*len);
+		memcpy(copy, *data, *len);
+		*data = copy;
+	}
+
+	return true;
+}
+
+bool AssetManager::ReadFile(const char* name, char** data, uint32_t* len, bool* isView, std::shared_ptr<char>* cachedData) {
+	const auto start = std::chrono::steady_clock::now();
+	const auto success = this->ReadFileInternal(name, data, len, isView, cachedData);
+
+	m_LookupTime += std::chrono::steady_clock::now() - start;
+	m_LookupCount++;
+
+	return success;
+}
+
+bool AssetManager::ReadFileInternal(const char* name, char** data, uint32_t* len, bool* isView, std::shared_ptr<char>* cachedData) {
+	*isView = false;
+
+	auto fixedName = GetLoosePath(name);
+
 	if (std::filesystem::exists(m_ResPath / fixedName)) {
 		FILE* file;
 #ifdef _WIN32
@@ -119,59 +189,86 @@ bool AssetManager::GetFile(const char* name, char** data, uint32_t* len) {
 
 	if (this->m_AssetBundleType == eAssetBundleType::Unpacked) return false;
 
-	// The crc in side of the pack always uses backslashes, so we need to convert them again...
-	std::replace(fixedName.begin(), fixedName.end(), '/', '\\');
-	if (fixedName.rfind("client\\res\\", 0) != 0) {
-		fixedName = "client\\res\\" + fixedName;
-	}
-	int32_t packIndex = -1;
-	uint32_t crc = crc32b(0xFFFFFFFF, (uint8_t*)fixedName.c_str(), fixedName.size());
-	crc = crc32b(crc, (Bytef*)"\0\0\0\0", 4);
-
-	for (const auto& item : this->m_PackIndex->GetPackFileIndices()) {
-		if (item.m_Crc == crc) {
-			packIndex = item.m_PackFileIndex;
-			crc = item.m_Crc;
-			break;
-		}
-	}
+	const auto crc = GetPackCrc(fixedName);
+	const auto* item = this->m_PackIndex->GetPackFileIndex(crc);
 
-	if (packIndex == -1 || !crc) {
+	if (item == nullptr || !crc) {
 		return false;
 	}
 
-	auto packs = this->m_PackIndex->GetPacks();
-	auto* pack = packs.at(packIndex);
+	const auto& packs = this->m_PackIndex->GetPacks();
+	if (item->m_PackFileIndex >= packs.size()) return false;
 
-	bool success = pack->ReadFileFromPack(crc, data, len);
+	const auto* cached = GetCachedAsset(crc, len);
+	if (cached) {
+		*data = cached->get();
+		*isView = true;
+		*cachedData = *cached;
 
-	return success;
+		return true;
+	}
+
+	auto* pack = packs[item->m_PackFileIndex];
+
+	if (!pack->ReadFileFromPack(crc, data, len, isView)) return false;
+
+	// Uncompressed files are already views into the pack, only inflated files are worth caching
+	if (!*isView) {
+		m_CacheMisses++;
+
+		cached = CacheAsset(crc, *data, *len);
+		if (cached) {
+			*isView = true;
+			*cachedData = *cached;
+		}
+	}
+
+	return true;
 }
 
 AssetMemoryBuffer AssetManager::GetFileAsBuffer(const char* name) {
-	char* buf;
-	uint32_t len;
+	char* buf = nullptr;
+	uint32_t len = 0;
+	bool isView = false;
+	std::shared_ptr<char> cachedData;
 
-	bool success = this->GetFile(name, &buf, &len);
+	bool success = this->ReadFile(name, &buf, &len, &isView, &cachedData);
 
-	return AssetMemoryBuffer(buf, len, success);
+	return AssetMemoryBuffer(buf, len, success, isView, std::move(cachedData));
 }
 
-uint32_t AssetManager::crc32b(uint32_t base, uint8_t* message, size_t l) {
-	size_t i, j;
-	uint32_t crc, msb;
-
-	crc = base;
-	for (i = 0; i < l; i++) {
-		// xor next byte to upper bits of crc
-		crc ^= (((unsigned int)message[i]) << 24);
-		for (j = 0; j < 8; j++) { // Do eight times.
-			msb = crc >> 31;
-			crc <<= 1;
-			crc ^= (0 - msb) & 0x04C11DB7;
-		}
+const std::shared_ptr<char>* AssetManager::GetCachedAsset(uint32_t crc, uint32_t* len) {
+	auto it = m_Cache.find(crc);
+
+	if (it == m_Cache.end()) return nullptr;
+
+	m_CacheHits++;
+	m_CacheOrder.splice(m_CacheOrder.begin(), m_CacheOrder, it->second.lruPosition);
+
+	*len = it->second.length;
+	return &it->second.data;
+}
+
+const std::shared_ptr<char>* AssetManager::CacheAsset(uint32_t crc, char* data, uint32_t len) {
+	if (len > m_CacheBudget) return nullptr;
+
+	// Evicted assets stay alive until every buffer reading them has been closed
+	while (m_CacheSize + len > m_CacheBudget && !m_CacheOrder.empty()) {
+		auto oldest = m_Cache.find(m_CacheOrder.back());
+		m_CacheSize -= oldest->second.length;
+		m_Cache.erase(oldest);
+		m_CacheOrder.pop_back();
 	}
-	return crc; // don't complement crc on output
+
+	m_CacheOrder.push_front(crc);
+	m_CacheSize += len;
+
+	auto& asset = m_Cache[crc];
+	asset.data = std::shared_ptr<char>(data, free);
+	asset.length = len;
+	asset.lruPosition = m_CacheOrder.begin();
+
+	return &asset.data;
 }
 
 AssetManager::~AssetManager() {
@@ -4,6 +4,9 @@
 #include <vector>
 #include <unordered_map>
 #include <filesystem>
+#include <chrono>
+#include <list>
+#include <memory>
 
 #include "Pack.h"
 #include "PackIndex.h"
@@ -17,10 +20,18 @@ enum class eAssetBundleType {
 struct AssetMemoryBuffer : std::streambuf {
 	char* m_Base;
 	bool m_Success;
-
-	AssetMemoryBuffer(char* base, std::ptrdiff_t n, bool success) {
+	bool m_IsView;
+	std::shared_ptr<char> m_CachedData;
+
+	/**
+	 * @param isView If true the buffer points into a memory mapped pack or the asset cache and is not freed on close
+	 * @param cachedData Keeps a cached asset alive for as long as this buffer is open
+	 */
+	AssetMemoryBuffer(char* base, std::ptrdiff_t n, bool success, bool isView = false, std::shared_ptr<char> cachedData = nullptr) {
 		m_Base = base;
 		m_Success = success;
+		m_IsView = isView;
+		m_CachedData = std::move(cachedData);
 		if (!m_Success) return;
 		this->setg(base, base, base + n);
 	}
@@ -41,8 +52,13 @@ struct AssetMemoryBuffer : std::streambuf {
 		return gptr() - eback();
 	}
 
+	std::ptrdiff_t size() const {
+		return egptr() - eback();
+	}
+
 	void close() {
-		delete m_Base;
+		if (m_Success && !m_IsView) free(m_Base);
+		m_CachedData.reset();
 	}
 };
 
@@ -58,12 +74,63 @@ public:
 	bool GetFile(const char* name, char** data, uint32_t* len);
 	AssetMemoryBuffer GetFileAsBuffer(const char* name);
 
+	/**
+	 * Gets a value that changes whenever the contents of a file change, without reading the file.
+	 * Packed files use the hash stored in the pack, loose files their size and modification time.
+	 *
+	 * @param name The file to stamp
+	 * @param stamp Where to store the stamp
+	 * @return Whether or not the file exists
+	 */
+	bool GetFileStamp(const char* name, uint32_t* stamp);
+
+	uint64_t GetLookupCount() const { return m_LookupCount; }
+	float GetLookupTimeMs() const { return static_cast<float>(m_LookupTime.count()) / 1e6f; }
+
+	uint64_t GetCacheHits() const { return m_CacheHits; }
+	uint64_t GetCacheMisses() const { return m_CacheMisses; }
+	size_t GetCacheSize() const { return m_CacheSize; }
+
 private:
 	void LoadPackIndex();
 
-	// Modified crc algorithm (mpeg2)
-	// Reference: https://stackoverflow.com/questions/54339800/how-to-modify-crc-32-to-crc-32-mpeg-2
-	inline uint32_t crc32b(uint32_t base, uint8_t* message, size_t l);
+	/**
+	 * Reads a file, returning a view into the memory mapped pack or the asset cache when possible.
+	 *
+	 * @param isView Set to true if data points into a pack or the cache and must not be freed
+	 * @param cachedData Set to the cache entry backing data, if any
+	 */
+	bool ReadFile(const char* name, char** data, uint32_t* len, bool* isView, std::shared_ptr<char>* cachedData);
+	bool ReadFileInternal(const char* name, char** data, uint32_t* len, bool* isView, std::shared_ptr<char>* cachedData);
+
+	/**
+	 * Converts a file name to its path relative to the res folder, as used for loose files
+	 */
+	std::string GetLoosePath(const char* name);
+
+	/**
+	 * Gets the crc a file is stored under in the packs from its loose path
+	 */
+	uint32_t GetPackCrc(std::string loosePath);
+
+	/**
+	 * Finds a decompressed asset in the cache and marks it as most recently used
+	 */
+	const std::shared_ptr<char>* GetCachedAsset(uint32_t crc, uint32_t* len);
+
+	/**
+	 * Takes ownership of a decompressed asset and adds it to the cache, evicting the least recently used
+	 * assets to stay under budget.
+	 *
+	 * @return The cache entry, or nullptr if the asset does not fit in the cache and was not taken
+	 */
+	const std::shared_ptr<char>* CacheAsset(uint32_t crc, char* data, uint32_t len);
+
+	struct CachedAsset {
+		std::shared_ptr<char> data;
+		uint32_t length;
+		std::list<uint32_t>::iterator lruPosition;
+	};
 
 	bool m_SuccessfullyLoaded;
 
@@ -73,5 +140,17 @@ private:
 
 	eAssetBundleType m_AssetBundleType = eAssetBundleType::None;
 
-	PackIndex* m_PackIndex;
+	PackIndex* m_PackIndex = nullptr;
+
+	// Total number of file lookups and the time spent on them
+	uint64_t m_LookupCount = 0;
+	std::chrono::nanoseconds m_LookupTime{ 0 };
+
+	// LRU cache of decompressed pack files, keyed by crc
+	std::unordered_map<uint32_t, CachedAsset> m_Cache;
+	std::list<uint32_t> m_CacheOrder; // Most recently used first
+	size_t m_CacheSize = 0;
+	size_t m_CacheBudget = 0;
+	uint64_t m_CacheHits = 0;
+	uint64_t m_CacheMisses = 0;
 };
@@ -1,119 +1,187 @@
 #include "Pack.h"
 
-#include "BinaryIO.h"
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <system_error>
+#include <thread>
+
+#include "Game.h"
+#include "dLogger.h"
 #include "ZCompression.h"
 
 Pack::Pack(const std::filesystem::path& filePath) {
 	m_FilePath = filePath;
+	m_RecordCount = 0;
 
-	if (!std::filesystem::exists(filePath)) {
+	// The pack stays mapped for the lifetime of the process so files can be served without any file IO
+	if (!m_File.Open(filePath)) {
+		Game::logger->Log("Pack", "Failed to map pack file (%s)", filePath.string().c_str());
 		return;
 	}
 
-	m_FileStream = std::ifstream(filePath, std::ios::in | std::ios::binary);
+	const auto* data = m_File.GetData();
+	const auto size = m_File.GetSize();
 
-	m_FileStream.read(m_Version, 7);
+	if (size < sizeof(m_Version) + 8) return;
 
-	m_FileStream.seekg(-8, std::ios::end); // move file pointer to 8 bytes before the end (location of the address of the record count)
+	std::memcpy(m_Version, data, sizeof(m_Version));
 
+	// 8 bytes before the end of the file is the address of the record count
 	uint32_t recordCountPos = 0;
-	BinaryIO::BinaryRead<uint32_t>(m_FileStream, recordCountPos);
+	std::memcpy(&recordCountPos, data + size - 8, sizeof(uint32_t));
 
-	m_FileStream.seekg(recordCountPos, std::ios::beg);
+	if (recordCountPos + sizeof(uint32_t) > size) return;
 
-	BinaryIO::BinaryRead<uint32_t>(m_FileStream, m_RecordCount);
+	std::memcpy(&m_RecordCount, data + recordCountPos, sizeof(uint32_t));
 
-	for (int i = 0; i < m_RecordCount; i++) {
-		PackRecord record;
-		BinaryIO::BinaryRead<PackRecord>(m_FileStream, record);
-
-		m_Records.push_back(record);
+	if (recordCountPos + sizeof(uint32_t) + static_cast<size_t>(m_RecordCount) * sizeof(PackRecord) > size) {
+		Game::logger->Log("Pack", "Pack file (%s) has a truncated record table", filePath.string().c_str());
+		m_RecordCount = 0;
+		return;
 	}
 
-	m_FileStream.close();
-}
+	m_Records.resize(m_RecordCount);
+	std::memcpy(m_Records.data(), data + recordCountPos + sizeof(uint32_t), m_RecordCount * sizeof(PackRecord));
 
-bool Pack::HasFile(uint32_t crc) {
-	for (const auto& record : m_Records) {
-		if (record.m_Crc == crc) {
-			return true;
-		}
+	m_RecordIndices.reserve(m_RecordCount);
+	for (uint32_t i = 0; i < m_RecordCount; i++) {
+		m_RecordIndices.emplace(m_Records[i].m_Crc, i);
 	}
-
-	return false;
 }
 
-bool Pack::ReadFileFromPack(uint32_t crc, char** data, uint32_t* len) {
-	// Time for some wacky C file reading for speed reasons
+const PackRecord* Pack::GetRecord(uint32_t crc) {
+	const auto& index = m_RecordIndices.find(crc);
 
-	PackRecord pkRecord{};
+	if (index == m_RecordIndices.end()) return nullptr;
 
-	for (const auto& record : m_Records) {
-		if (record.m_Crc == crc) {
-			pkRecord = record;
-			break;
-		}
-	}
+	return &m_Records[index->second];
+}
 
-	if (pkRecord.m_Crc == 0) return false;
+bool Pack::HasFile(uint32_t crc) {
+	return GetRecord(crc) != nullptr;
+}
 
-	size_t pos = 0;
-	pos += pkRecord.m_FilePointer;
+bool Pack::ReadFileFromPack(uint32_t crc, char** data, uint32_t* len, bool* isView) {
+	const auto* pkRecord = GetRecord(crc);
 
-	bool isCompressed = (pkRecord.m_IsCompressed & 0xff) > 0;
-	auto inPackSize = isCompressed ? pkRecord.m_CompressedSize : pkRecord.m_UncompressedSize;
+	if (pkRecord == nullptr || pkRecord->m_Crc == 0) return false;
 
-	FILE* file;
-#ifdef _WIN32
-	fopen_s(&file, m_FilePath.string().c_str(), "rb");
-#elif __APPLE__
-	// macOS has 64bit file IO by default
-	file = fopen(m_FilePath.string().c_str(), "rb");
-#else
-	file = fopen64(m_FilePath.string().c_str(), "rb");
-#endif
+	const auto* packData = m_File.GetData();
+	const auto packSize = m_File.GetSize();
 
-	fseek(file, pos, SEEK_SET);
+	size_t pos = pkRecord->m_FilePointer;
 
-	if (!isCompressed) {
-		char* tempData = (char*)malloc(pkRecord.m_UncompressedSize);
-		fread(tempData, sizeof(uint8_t), pkRecord.m_UncompressedSize, file);
+	bool isCompressed = (pkRecord->m_IsCompressed & 0xff) > 0;
+	auto inPackSize = isCompressed ? pkRecord->m_CompressedSize : pkRecord->m_UncompressedSize;
 
-		*data = tempData;
-		*len = pkRecord.m_UncompressedSize;
-		fclose(file);
+	if (pos + inPackSize > packSize) return false;
+
+	if (!isCompressed) {
+		// Hand out a view into the mapping, no copy needed
+		*data = const_cast<char*>(packData + pos);
+		*len = pkRecord->m_UncompressedSize;
+		*isView = true;
 
 		return true;
 	}
 
 	pos += 5; // skip header
 
-	fseek(file, pos, SEEK_SET);
-
-	char* decompressedData = (char*)malloc(pkRecord.m_UncompressedSize);
-	uint32_t currentReadPos = 0;
-
-	while (true) {
-		if (currentReadPos >= pkRecord.m_UncompressedSize) break;
+	// Find all of the sd0 chunks up front so large files can be inflated in parallel
+	std::vector<SD0Chunk> chunks;
+	const auto end = pkRecord->m_FilePointer + inPackSize;
 
+	while (pos + sizeof(uint32_t) <= end) {
 		uint32_t size;
-		fread(&size, sizeof(uint32_t), 1, file);
+		std::memcpy(&size, packData + pos, sizeof(uint32_t));
 		pos += 4; // Move pointer position 4 to the right
 
-		char* chunk = (char*)malloc(size);
-		fread(chunk, sizeof(int8_t), size, file);
+		if (pos + size > end) break;
+
+		chunks.push_back({ reinterpret_cast<const uint8_t*>(packData + pos), size });
 		pos += size; // Move pointer position the amount of bytes read to the right
+	}
 
-		int32_t err;
-		currentReadPos += ZCompression::Decompress((uint8_t*)chunk, size, reinterpret_cast<uint8_t*>(decompressedData + currentReadPos), ZCompression::MAX_SD0_CHUNK_SIZE, err);
+	char* decompressedData = (char*)malloc(pkRecord->m_UncompressedSize);
 
-		free(chunk);
+	if (!InflateChunks(chunks, reinterpret_cast<uint8_t*>(decompressedData), pkRecord->m_UncompressedSize)) {
+		free(decompressedData);
+		return false;
 	}
 
 	*data = decompressedData;
-	*len = pkRecord.m_UncompressedSize;
+	*len = pkRecord->m_UncompressedSize;
+	*isView = false;
+
+	return true;
+}
+
+bool Pack::InflateChunks(const std::vector<SD0Chunk>& chunks, uint8_t* output, uint32_t outputSize) {
+	const auto expectedChunkCount = (outputSize + ZCompression::MAX_SD0_CHUNK_SIZE - 1) / ZCompression::MAX_SD0_CHUNK_SIZE;
 
-	fclose(file);
+	// Every chunk but the last inflates to exactly MAX_SD0_CHUNK_SIZE, so the output offset of each chunk is known
+	// without inflating the ones before it.  If the chunk count doesn't line up with that, inflate them in order.
+	if (chunks.size() < PARALLEL_INFLATE_MIN_CHUNKS || chunks.size() != expectedChunkCount) {
+		return InflateChunksSerial(chunks, output, outputSize);
+	}
+
+	const auto workerCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), chunks.size());
+
+	auto inflateStripe = [&chunks, output, outputSize, workerCount](size_t firstChunk) {
+		for (size_t i = firstChunk; i < chunks.size(); i += workerCount) {
+			const auto offset = static_cast<uint32_t>(i) * ZCompression::MAX_SD0_CHUNK_SIZE;
+			const auto expected = std::min(outputSize - offset, ZCompression::MAX_SD0_CHUNK_SIZE);
+
+			int32_t err;
+			if (ZCompression::Decompress(chunks[i].data, chunks[i].size, output + offset, expected, err) != static_cast<int32_t>(expected)) return false;
+		}
+
+		return true;
+	};
+
+	bool success = true;
+	{
+		// The calling thread takes the first stripe itself
+		std::vector<std::future<bool>> workers;
+		workers.reserve(workerCount - 1);
+		try {
+			for (size_t i = 1; i < workerCount; i++) {
+				workers.push_back(std::async(std::launch::async, inflateStripe, i));
+			}
+		} catch (const std::system_error&) {
+			// Out of threads, the stripes that were not started are covered by the serial inflate below
+			success = false;
+		}
+
+		success &= inflateStripe(0);
+		for (auto& worker : workers) {
+			success &= worker.get();
+		}
+	}
+
+	if (success) return true;
+
+	// A chunk that doesn't inflate to its full size means the offsets were guessed wrong, inflate them in order instead
+	Game::logger->Log("Pack", "Parallel inflate failed, retrying %llu chunks serially", static_cast<unsigned long long>(chunks.size()));
+
+	return InflateChunksSerial(chunks, output, outputSize);
+}
+
+bool Pack::InflateChunksSerial(const std::vector<SD0Chunk>& chunks, uint8_t* output, uint32_t outputSize) {
+	uint32_t currentReadPos = 0;
+
+	for (const auto& chunk : chunks) {
+		if (currentReadPos >= outputSize) break;
+
+		const auto remaining = std::min(outputSize - currentReadPos, ZCompression::MAX_SD0_CHUNK_SIZE);
+
+		int32_t err;
+		const auto inflated = ZCompression::Decompress(chunk.data, chunk.size, output + currentReadPos, remaining, err);
+		if (inflated < 0) return false;
+
+		currentReadPos += inflated;
+	}
 
 	return true;
 }
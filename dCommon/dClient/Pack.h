@@ -3,6 +3,9 @@
 #include <vector>
 #include <string>
 #include <filesystem>
+#include <unordered_map>
+
+#include "MappedFile.h"
 
 #pragma pack(push, 1)
 struct PackRecord {
@@ -26,13 +29,53 @@ public:
 	~Pack() = default;
 
 	bool HasFile(uint32_t crc);
-	bool ReadFileFromPack(uint32_t crc, char** data, uint32_t* len);
+
+	/**
+	 * Reads a file out of the pack.  Uncompressed files are returned as a view directly into the
+	 * memory mapped pack and must not be freed, compressed files are inflated into a malloc'd buffer.
+	 *
+	 * @param crc The crc of the file to read
+	 * @param data Where to store the pointer to the file data
+	 * @param len Where to store the length of the file
+	 * @param isView Where to store whether the data points into the pack (true) or is owned by the caller (false)
+	 * @return Whether or not the file was read
+	 */
+	bool ReadFileFromPack(uint32_t crc, char** data, uint32_t* len, bool* isView);
+
+	const PackRecord* GetRecord(uint32_t crc);
 private:
-	std::ifstream m_FileStream;
+	struct SD0Chunk {
+		const uint8_t* data;
+		uint32_t size;
+	};
+
+	/**
+	 * Files with at least this many sd0 chunks are inflated on multiple threads
+	 */
+	static constexpr size_t PARALLEL_INFLATE_MIN_CHUNKS = 4;
+
+	/**
+	 * Inflates the sd0 chunks of a compressed file into output
+	 *
+	 * @return Whether or not every chunk inflated successfully
+	 */
+	static bool InflateChunks(const std::vector<SD0Chunk>& chunks, uint8_t* output, uint32_t outputSize);
+
+	/**
+	 * Inflates the sd0 chunks of a compressed file into output one after another on the calling thread
+	 *
+	 * @return Whether or not every chunk inflated successfully
+	 */
+	static bool InflateChunksSerial(const std::vector<SD0Chunk>& chunks, uint8_t* output, uint32_t outputSize);
+
+	MappedFile m_File;
 	std::filesystem::path m_FilePath;
 
 	char m_Version[7];
 
 	uint32_t m_RecordCount;
 	std::vector<PackRecord> m_Records;
+
+	// Map of crc to index in m_Records
+	std::unordered_map<uint32_t, uint32_t> m_RecordIndices;
 };
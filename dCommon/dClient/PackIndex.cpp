@@ -27,10 +27,14 @@ PackIndex::PackIndex(const std::filesystem::path& filePath) {
 
 	BinaryIO::BinaryRead<uint32_t>(m_FileStream, m_PackFileIndexCount);
 
+	m_PackFileIndices.reserve(m_PackFileIndexCount);
+	m_PackFileIndexLookup.reserve(m_PackFileIndexCount);
+
 	for (int i = 0; i < m_PackFileIndexCount; i++) {
 		PackFileIndex packFileIndex;
 		BinaryIO::BinaryRead<PackFileIndex>(m_FileStream, packFileIndex);
 
+		m_PackFileIndexLookup.emplace(packFileIndex.m_Crc, m_PackFileIndices.size());
 		m_PackFileIndices.push_back(packFileIndex);
 	}
 
@@ -47,6 +51,14 @@ PackIndex::PackIndex(const std::filesystem::path& filePath) {
 	m_FileStream.close();
 }
 
+const PackFileIndex* PackIndex::GetPackFileIndex(uint32_t crc) {
+	const auto& index = m_PackFileIndexLookup.find(crc);
+
+	if (index == m_PackFileIndexLookup.end()) return nullptr;
+
+	return &m_PackFileIndices[index->second];
+}
+
 PackIndex::~PackIndex() {
 	for (const auto* item : m_Packs) {
 		delete item;
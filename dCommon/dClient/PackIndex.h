@@ -3,8 +3,10 @@
 #include <cstdint>
 
 #include <string>
+#include <fstream>
 #include <vector>
 #include <filesystem>
+#include <unordered_map>
 
 #include "Pack.h"
 
@@ -26,6 +28,14 @@ public:
 	const std::vector<std::string>& GetPackPaths() { return m_PackPaths; }
 	const std::vector<PackFileIndex>& GetPackFileIndices() { return m_PackFileIndices; }
 	const std::vector<Pack*>& GetPacks() { return m_Packs; }
+
+	/**
+	 * Finds the index entry for a file by its crc.
+	 *
+	 * @param crc The crc of the file
+	 * @return The index entry, or nullptr if no pack contains the file
+	 */
+	const PackFileIndex* GetPackFileIndex(uint32_t crc);
 private:
 	std::ifstream m_FileStream;
 
@@ -36,5 +46,8 @@ private:
 	uint32_t m_PackFileIndexCount;
 	std::vector<PackFileIndex> m_PackFileIndices;
 
+	// Map of crc to index in m_PackFileIndices
+	std::unordered_map<uint32_t, uint32_t> m_PackFileIndexLookup;
+
 	std::vector<Pack*> m_Packs;
 };
@@ -0,0 +1,276 @@
+#ifndef __EBEHAVIORPARAMETER__H__
+#define __EBEHAVIORPARAMETER__H__
+
+#include <cstdint>
+
+/**
+ * The BehaviorParameter names the server reads, so behaviors can look their parameters up by index
+ * instead of hashing the name on every call.  Parameters with names not listed here are still loaded
+ * and can be looked up by name.
+ *
+ * BehaviorParameterNames must be kept in the same order as this enum.
+ */
+enum class eBehaviorParameter : uint32_t {
+	ABSORB_AMOUNT,
+	ACTION,
+	ACTION_FALSE,
+	ACTION_TRUE,
+	ADD_IMMUNITY,
+	AFFECTS_CASTER,
+	AIR_ACTION,
+	AIRSPEED,
+	ANGLE,
+	ARMOR,
+	BLOCKED_ACTION,
+	BUFF_ID,
+	BYPASS_CHECKS,
+	CANCEL_IF_INTERACTING,
+	CANCEL_ON_DAMAGED,
+	CANCEL_ON_DEATH,
+	CANCEL_ON_LOGOUT,
+	CANCEL_ON_REMOVE_BUFF,
+	CANCEL_ON_UI,
+	CANCEL_ON_UNEQUIP,
+	CANCEL_ON_ZONE,
+	CHECK_BLOCKING,
+	CHECK_ENV,
+	CHECK_RANGE,
+	CLEAR_IF_CASTER,
+	DELAY,
+	DISTANCE,
+	DOUBLE_JUMP_ACTION,
+	DURATION,
+	DURATION_SECS,
+	ENABLE_HOVER,
+	FACTION_LIST,
+	FALLING_ACTION,
+	FAR_HEIGHT,
+	FAR_WIDTH,
+	FLAGS_OFF,
+	FLAGS_ON,
+	FORWARD,
+	GROUND_ACTION,
+	HEALTH,
+	HIT_ACTION,
+	HIT_ACTION_ENEMY,
+	HIT_ACTION_FACTION,
+	IGNORE_FACTION,
+	IGNORE_INTERRUPTS,
+	IMAG,
+	IMAGINATION,
+	IMMUNE_BASIC_ATTACK,
+	IMMUNE_DAMAGE_OVER_TIME,
+	IMMUNE_IMAGINATION_GAIN,
+	IMMUNE_IMAGINATION_LOSS,
+	IMMUNE_INTERRUPT,
+	IMMUNE_KNOCKBACK,
+	IMMUNE_PULLTOPOINT,
+	IMMUNE_QUICKBUILD_INTERRUPTS,
+	IMMUNE_SPEED,
+	IMMUNE_STUN_ATTACK,
+	IMMUNE_STUN_EQUIP,
+	IMMUNE_STUN_INTERACT,
+	IMMUNE_STUN_MOVE,
+	IMMUNE_STUN_ROTATE,
+	INCLUDE_FACTION,
+	INTERRUPT_BLOCK,
+	IS_ENEMY_FACTION,
+	JETPACK_ACTION,
+	JUMP_ACTION,
+	LEFT,
+	LIFE,
+	LOT_ID,
+	LOWER_BOUND,
+	MAP_ID,
+	MAX_DAMAGE,
+	MAX_RANGE,
+	MAX_TARGETS,
+	MAX_AIRSPEED,
+	MAX_DISTANCE,
+	METHOD,
+	MIN_DAMAGE,
+	MIN_RANGE,
+	MISS_ACTION,
+	MOVING_ACTION,
+	NPC_SKILL_TIME,
+	NUM_ATTACKS_CAN_BLOCK,
+	NUM_INTERVALS,
+	OFFSET_X,
+	OFFSET_Y,
+	OFFSET_Z,
+	ON_FAIL_ARMOR,
+	ON_FAIL_BLOCKED,
+	ON_FAIL_IMMUNE,
+	ON_SUCCESS,
+	ORIENT_CASTER,
+	PROJECTILE_SPEED,
+	PROJECTILE_TYPE,
+	RADIUS,
+	RANGE,
+	REDUCTION_AMOUNT,
+	RELATIVE,
+	REMOVE_IMMUNITY,
+	RUN_SPEED,
+	SCALE,
+	SHOW_COLLECTIBLES,
+	SHOW_MINIBOSSES,
+	SHOW_PET_DIGS,
+	SPREAD_ANGLE,
+	SPREAD_COUNT,
+	START_ACTION,
+	STRENGTH,
+	STUN_CASTER,
+	TARGET,
+	TARGET_ENEMY,
+	TARGET_FRIEND,
+	TARGET_HAS_BUFF,
+	TARGET_SELF,
+	TARGET_TEAM,
+	THREAT_TO_ADD,
+	TIME,
+	TIME_MS,
+	TO_TARGET,
+	TRACK_RADIUS,
+	TRACK_TARGET,
+	UPPER_BOUND,
+	USE_MOUSEPOSIT,
+	USE_PICKED_TARGET,
+	VERTICAL_VELOCITY,
+	WARNING_EFFECT_ID,
+	YAW,
+	COUNT
+};
+
+inline constexpr const char* BehaviorParameterNames[] = {
+	"absorb_amount",
+	"action",
+	"action_false",
+	"action_true",
+	"add_immunity",
+	"affects_caster",
+	"air_action",
+	"airspeed",
+	"angle",
+	"armor",
+	"blocked action",
+	"buff_id",
+	"bypass_checks",
+	"cancel_if_interacting",
+	"cancel_on_damaged",
+	"cancel_on_death",
+	"cancel_on_logout",
+	"cancel_on_remove_buff",
+	"cancel_on_ui",
+	"cancel_on_unequip",
+	"cancel_on_zone",
+	"check blocking",
+	"check_env",
+	"check_range",
+	"clear_if_caster",
+	"delay",
+	"distance",
+	"double_jump_action",
+	"duration",
+	"duration_secs",
+	"enable_hover",
+	"faction_list",
+	"falling_action",
+	"far_height",
+	"far_width",
+	"flags_off",
+	"flags_on",
+	"forward",
+	"ground_action",
+	"health",
+	"hit_action",
+	"hit_action_enemy",
+	"hit_action_faction",
+	"ignore_faction",
+	"ignore_interrupts",
+	"imag",
+	"imagination",
+	"immune_basic_attack",
+	"immune_damage_over_time",
+	"immune_imagination_gain",
+	"immune_imagination_loss",
+	"immune_interrupt",
+	"immune_knockback",
+	"immune_pulltopoint",
+	"immune_quickbuild_interrupts",
+	"immune_speed",
+	"immune_stun_attack",
+	"immune_stun_equip",
+	"immune_stun_interact",
+	"immune_stun_move",
+	"immune_stun_rotate",
+	"include_faction",
+	"interrupt_block",
+	"isEnemyFaction",
+	"jetpack_action",
+	"jump_action",
+	"left",
+	"life",
+	"LOT_ID",
+	"lower_bound",
+	"mapID",
+	"max damage",
+	"max range",
+	"max targets",
+	"max_airspeed",
+	"max_distance",
+	"method",
+	"min damage",
+	"min range",
+	"miss action",
+	"moving_action",
+	"npc skill time",
+	"num_attacks_can_block",
+	"num_intervals",
+	"offset_x",
+	"offset_y",
+	"offset_z",
+	"on_fail_armor",
+	"on_fail_blocked",
+	"on_fail_immune",
+	"on_success",
+	"orient_caster",
+	"projectile_speed",
+	"projectile_type",
+	"radius",
+	"range",
+	"reduction_amount",
+	"relative",
+	"remove_immunity",
+	"run_speed",
+	"scale",
+	"show_collectibles",
+	"show_minibosses",
+	"show_pet_digs",
+	"spread_angle",
+	"spread_count",
+	"start_action",
+	"strength",
+	"stun_caster",
+	"target",
+	"target_enemy",
+	"target_friend",
+	"target_has_buff",
+	"target_self",
+	"target_team",
+	"threat to add",
+	"time",
+	"time_ms",
+	"to_target",
+	"track_radius",
+	"track_target",
+	"upper_bound",
+	"use_mouseposit",
+	"use_picked_target",
+	"vertical_velocity",
+	"warning_effect_id",
+	"yaw",
+};
+
+static_assert(sizeof(BehaviorParameterNames) / sizeof(BehaviorParameterNames[0]) == static_cast<uint32_t>(eBehaviorParameter::COUNT), "Every behavior parameter needs a name");
+
+#endif  //!__EBEHAVIORPARAMETER__H__
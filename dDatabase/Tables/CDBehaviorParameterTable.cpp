@@ -3,29 +3,54 @@
 
 //! Constructor
 CDBehaviorParameterTable::CDBehaviorParameterTable(void) {
+	// Known parameters get their compile time IDs, anything else is numbered after them
+	for (uint32_t i = 0; i < static_cast<uint32_t>(eBehaviorParameter::COUNT); i++) {
+		m_ParametersList.insert(std::make_pair(BehaviorParameterNames[i], i));
+		m_ParameterNames.push_back(BehaviorParameterNames[i]);
+	}
+
+	struct Row {
+		uint32_t behaviorID;
+		CDBehaviorParameter parameter;
+	};
+
+	std::vector<Row> rows;
+	uint32_t maxBehaviorID = 0;
+
 	auto tableData = CDClientDatabase::ExecuteQuery("SELECT * FROM BehaviorParameter");
-	uint32_t uniqueParameterId = 0;
-	uint64_t hash = 0;
 	while (!tableData.eof()) {
-		CDBehaviorParameter entry;
-		entry.behaviorID = tableData.getIntField("behaviorID", -1);
-		auto candidateStringToAdd = std::string(tableData.getStringField("parameterID", ""));
-		auto parameter = m_ParametersList.find(candidateStringToAdd);
-		if (parameter != m_ParametersList.end()) {
-			entry.parameterID = parameter;
-		} else {
-			entry.parameterID = m_ParametersList.insert(std::make_pair(candidateStringToAdd, uniqueParameterId)).first;
-			uniqueParameterId++;
-		}
-		hash = entry.behaviorID;
-		hash = (hash << 31U) | entry.parameterID->second;
-		entry.value = tableData.getFloatField("value", -1.0f);
+		const auto behaviorID = tableData.getIntField("behaviorID", -1);
+		if (behaviorID >= 0) {
+			Row row;
+			row.behaviorID = behaviorID;
+			row.parameter.parameterID = GetParameterID(tableData.getStringField("parameterID", ""));
+			row.parameter.value = tableData.getFloatField("value", -1.0f);
 
-		m_Entries.insert(std::make_pair(hash, entry));
+			maxBehaviorID = std::max(maxBehaviorID, row.behaviorID);
+			rows.push_back(row);
+		}
 
 		tableData.nextRow();
 	}
 	tableData.finalize();
+
+	// Stable so that, like before, the first row wins if a behavior has a parameter twice
+	std::stable_sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+		return a.behaviorID != b.behaviorID ? a.behaviorID < b.behaviorID : a.parameter.parameterID < b.parameter.parameterID;
+	});
+
+	m_BehaviorRanges.resize(rows.empty() ? 0 : maxBehaviorID + 1, { 0, 0 });
+	m_Entries.reserve(rows.size());
+
+	for (size_t i = 0; i < rows.size(); i++) {
+		if (i > 0 && rows[i].behaviorID == rows[i - 1].behaviorID && rows[i].parameter.parameterID == rows[i - 1].parameter.parameterID) continue;
+
+		auto& range = m_BehaviorRanges[rows[i].behaviorID];
+		if (range.first == range.second) range.first = m_Entries.size();
+
+		m_Entries.push_back(rows[i].parameter);
+		range.second = m_Entries.size();
+	}
 }
 
 //! Destructor
@@ -36,30 +61,49 @@ std::string CDBehaviorParameterTable::GetName(void) const {
 	return "BehaviorParameter";
 }
 
+uint32_t CDBehaviorParameterTable::GetParameterID(const std::string& name) {
+	const auto parameter = m_ParametersList.find(name);
+	if (parameter != m_ParametersList.end()) return parameter->second;
+
+	const auto parameterID = static_cast<uint32_t>(m_ParameterNames.size());
+	m_ParametersList.insert(std::make_pair(name, parameterID));
+	m_ParameterNames.push_back(name);
+
+	return parameterID;
+}
+
+float CDBehaviorParameterTable::GetValue(const uint32_t behaviorID, const uint32_t parameterID, const float defaultValue) const {
+	if (behaviorID >= m_BehaviorRanges.size()) return defaultValue;
+
+	// Behaviors only have a handful of parameters, so a scan of the range beats any kind of search
+	const auto& range = m_BehaviorRanges[behaviorID];
+	for (auto i = range.first; i < range.second; i++) {
+		if (m_Entries[i].parameterID == parameterID) return m_Entries[i].value;
+		if (m_Entries[i].parameterID > parameterID) break;
+	}
+
+	return defaultValue;
+}
+
+float CDBehaviorParameterTable::GetValue(const uint32_t behaviorID, const eBehaviorParameter parameter, const float defaultValue) const {
+	return GetValue(behaviorID, static_cast<uint32_t>(parameter), defaultValue);
+}
+
 float CDBehaviorParameterTable::GetValue(const uint32_t behaviorID, const std::string& name, const float defaultValue) {
 	auto parameterID = this->m_ParametersList.find(name);
 	if (parameterID == this->m_ParametersList.end()) return defaultValue;
 
-	uint64_t hash = behaviorID;
-
-	hash = (hash << 31U) | parameterID->second;
-
-	// Search for specific parameter
-	const auto& it = m_Entries.find(hash);
-	return it != m_Entries.end() ? it->second.value : defaultValue;
+	return GetValue(behaviorID, parameterID->second, defaultValue);
 }
 
-std::map<std::string, float> CDBehaviorParameterTable::GetParametersByBehaviorID(uint32_t behaviorID) {
-	uint64_t hashBase = behaviorID;
+std::map<std::string, float> CDBehaviorParameterTable::GetParametersByBehaviorID(uint32_t behaviorID) const {
 	std::map<std::string, float> returnInfo;
-	uint64_t hash;
-	for (auto& parameterCandidate : m_ParametersList) {
-		hash = (hashBase << 31U) | parameterCandidate.second;
-		auto infoCandidate = m_Entries.find(hash);
-		if (infoCandidate != m_Entries.end()) {
-			returnInfo.insert(std::make_pair(infoCandidate->second.parameterID->first, infoCandidate->second.value));
-		}
+	if (behaviorID >= m_BehaviorRanges.size()) return returnInfo;
+
+	const auto& range = m_BehaviorRanges[behaviorID];
+	for (auto i = range.first; i < range.second; i++) {
+		returnInfo.insert(std::make_pair(m_ParameterNames[m_Entries[i].parameterID], m_Entries[i].value));
 	}
+
 	return returnInfo;
 }
-
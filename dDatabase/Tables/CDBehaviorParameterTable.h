@@ -2,8 +2,9 @@
 
 // Custom Classes
 #include "CDTable.h"
+#include "eBehaviorParameter.h"
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 /*!
  \file CDBehaviorParameterTable.hpp
@@ -12,16 +13,24 @@
 
  //! BehaviorParameter Entry Struct
 struct CDBehaviorParameter {
-	unsigned int behaviorID;											//!< The Behavior ID
-	std::unordered_map<std::string, uint32_t>::iterator parameterID;   	//!< The Parameter ID
-	float value;            											//!< The value of the behavior template
+	uint32_t parameterID;   //!< The Parameter ID, an eBehaviorParameter or an ID past eBehaviorParameter::COUNT for unknown names
+	float value;            //!< The value of the behavior template
 };
 
 //! BehaviorParameter table
 class CDBehaviorParameterTable : public CDTable {
 private:
-	std::unordered_map<uint64_t, CDBehaviorParameter> m_Entries;
+	//! All parameters, grouped by behavior and sorted by parameter ID within a behavior
+	std::vector<CDBehaviorParameter> m_Entries;
+
+	//! The range of each behavior's parameters in m_Entries, indexed by behavior ID
+	std::vector<std::pair<uint32_t, uint32_t>> m_BehaviorRanges;
+
 	std::unordered_map<std::string, uint32_t> m_ParametersList;
+	std::vector<std::string> m_ParameterNames;
+
+	uint32_t GetParameterID(const std::string& name);
+	float GetValue(const uint32_t behaviorID, const uint32_t parameterID, const float defaultValue) const;
 public:
 
 	//! Constructor
@@ -36,7 +45,10 @@ public:
 	 */
 	std::string GetName(void) const override;
 
+	float GetValue(const uint32_t behaviorID, const eBehaviorParameter parameter, const float defaultValue = 0) const;
+
+	//! Looks a parameter up by name, prefer the eBehaviorParameter overload for names known at compile time
 	float GetValue(const uint32_t behaviorID, const std::string& name, const float defaultValue = 0);
 
-	std::map<std::string, float> GetParametersByBehaviorID(uint32_t behaviorID);
+	std::map<std::string, float> GetParametersByBehaviorID(uint32_t behaviorID) const;
 };
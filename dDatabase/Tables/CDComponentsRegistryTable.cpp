@@ -1,6 +1,8 @@
 #include "CDComponentsRegistryTable.h"
 #include "eReplicaComponentType.h"
 
+#include <algorithm>
+
 #define CDCLIENT_CACHE_ALL
 
 //! Constructor
@@ -31,6 +33,10 @@ CDComponentsRegistryTable::CDComponentsRegistryTable(void) {
 
 		this->mappedEntries.insert_or_assign(((uint64_t)entry.component_type) << 32 | ((uint64_t)entry.id), entry.component_id);
 
+		if (std::find(this->componentTypes.begin(), this->componentTypes.end(), entry.component_type) == this->componentTypes.end()) {
+			this->componentTypes.push_back(entry.component_type);
+		}
+
 		//this->entries.push_back(entry);
 
 		/*
@@ -128,3 +134,17 @@ int32_t CDComponentsRegistryTable::GetByIDAndType(uint32_t id, eReplicaComponent
 #endif
 }
 
+std::vector<std::pair<eReplicaComponentType, int32_t>> CDComponentsRegistryTable::GetComponentsByID(uint32_t id) {
+	std::vector<std::pair<eReplicaComponentType, int32_t>> components;
+
+	// Entries are keyed by type first, so look the object up under each type
+	for (const auto componentType : this->componentTypes) {
+		const auto& iter = this->mappedEntries.find(((uint64_t)componentType) << 32 | ((uint64_t)id));
+
+		if (iter != this->mappedEntries.end()) {
+			components.emplace_back(componentType, iter->second);
+		}
+	}
+
+	return components;
+}
@@ -21,6 +21,7 @@ class CDComponentsRegistryTable : public CDTable {
 private:
 	//std::vector<CDComponentsRegistry> entries;
 	std::map<uint64_t, uint32_t> mappedEntries; //id, component_type, component_id
+	std::vector<eReplicaComponentType> componentTypes; //Every component type in the table
 
 public:
 
@@ -37,4 +38,11 @@ public:
 	std::string GetName(void) const override;
 
 	int32_t GetByIDAndType(uint32_t id, eReplicaComponentType componentType, int32_t defaultValue = 0);
+
+	//! Returns every component an object has
+	/*!
+	  \param id The LOT of the object
+	  \return The component types of the object with their component IDs
+	 */
+	std::vector<std::pair<eReplicaComponentType, int32_t>> GetComponentsByID(uint32_t id);
 };
@@ -59,5 +59,8 @@ public:
 
 	//! Gets an entry by ID
 	const CDSkillBehavior& GetSkillByID(unsigned int skillID);
+
+	//! Gets all the entries in the table, keyed by skill ID
+	const std::map<unsigned int, CDSkillBehavior>& GetEntries() const { return entries; }
 };
 
@@ -24,6 +24,7 @@
 #include "Loot.h"
 #include "eMissionTaskType.h"
 #include "eTriggerEventType.h"
+#include "EntityPrefab.h"
 
 //Component includes:
 #include "Component.h"
@@ -157,15 +158,15 @@ void Entity::Initialize() {
 		m_ParentEntity->AddChild(this);
 	}
 
-	// Get the registry table
-	CDComponentsRegistryTable* compRegistryTable = CDClientManager::Instance()->GetTable<CDComponentsRegistryTable>("ComponentsRegistry");
+	// Get the components and database rows shared by every entity of this LOT
+	const auto& prefab = EntityPrefab::GetPrefab(m_TemplateID);
 
 	/**
 	 * Special case for BBB models. They have components not corresponding to the registry.
 	 */
 
 	if (m_TemplateID == 14) {
-		const auto simplePhysicsComponentID = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::SIMPLE_PHYSICS);
+		const auto simplePhysicsComponentID = prefab.GetComponentId(eReplicaComponentType::SIMPLE_PHYSICS);
 
 		SimplePhysicsComponent* comp = new SimplePhysicsComponent(simplePhysicsComponentID, this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::SIMPLE_PHYSICS, comp));
@@ -198,43 +199,43 @@ void Entity::Initialize() {
 		missions->LoadFromXml(m_Character->GetXMLDoc());
 	}
 
-	uint32_t petComponentId = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::PET);
+	uint32_t petComponentId = prefab.GetComponentId(eReplicaComponentType::PET);
 	if (petComponentId > 0) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::PET, new PetComponent(this, petComponentId)));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::ZONE_CONTROL) > 0) {
+	if (prefab.GetComponentId(eReplicaComponentType::ZONE_CONTROL) > 0) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::ZONE_CONTROL, nullptr));
 	}
 
-	uint32_t possessableComponentId = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::POSSESSABLE);
+	uint32_t possessableComponentId = prefab.GetComponentId(eReplicaComponentType::POSSESSABLE);
 	if (possessableComponentId > 0) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::POSSESSABLE, new PossessableComponent(this, possessableComponentId)));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::MODULE_ASSEMBLY) > 0) {
+	if (prefab.GetComponentId(eReplicaComponentType::MODULE_ASSEMBLY) > 0) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::MODULE_ASSEMBLY, new ModuleAssemblyComponent(this)));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::RACING_STATS) > 0) {
+	if (prefab.GetComponentId(eReplicaComponentType::RACING_STATS) > 0) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::RACING_STATS, nullptr));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::LUP_EXHIBIT, -1) >= 0) {
+	if (prefab.GetComponentId(eReplicaComponentType::LUP_EXHIBIT, -1) >= 0) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::LUP_EXHIBIT, new LUPExhibitComponent(this)));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::RACING_CONTROL) > 0) {
+	if (prefab.GetComponentId(eReplicaComponentType::RACING_CONTROL) > 0) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::RACING_CONTROL, new RacingControlComponent(this)));
 	}
 
-	const auto propertyEntranceComponentID = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::PROPERTY_ENTRANCE);
+	const auto propertyEntranceComponentID = prefab.GetComponentId(eReplicaComponentType::PROPERTY_ENTRANCE);
 	if (propertyEntranceComponentID > 0) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::PROPERTY_ENTRANCE,
 			new PropertyEntranceComponent(propertyEntranceComponentID, this)));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::CONTROLLABLE_PHYSICS) > 0) {
+	if (prefab.GetComponentId(eReplicaComponentType::CONTROLLABLE_PHYSICS) > 0) {
 		ControllablePhysicsComponent* controllablePhysics = new ControllablePhysicsComponent(this);
 
 		if (m_Character) {
@@ -275,31 +276,31 @@ void Entity::Initialize() {
 	// If an entity is marked a phantom, simple physics is made into phantom phyics.
 	bool markedAsPhantom = GetVar<bool>(u"markedAsPhantom");
 
-	const auto simplePhysicsComponentID = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::SIMPLE_PHYSICS);
+	const auto simplePhysicsComponentID = prefab.GetComponentId(eReplicaComponentType::SIMPLE_PHYSICS);
 	if (!markedAsPhantom && simplePhysicsComponentID > 0) {
 		SimplePhysicsComponent* comp = new SimplePhysicsComponent(simplePhysicsComponentID, this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::SIMPLE_PHYSICS, comp));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::RIGID_BODY_PHANTOM_PHYSICS) > 0) {
+	if (prefab.GetComponentId(eReplicaComponentType::RIGID_BODY_PHANTOM_PHYSICS) > 0) {
 		RigidbodyPhantomPhysicsComponent* comp = new RigidbodyPhantomPhysicsComponent(this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::RIGID_BODY_PHANTOM_PHYSICS, comp));
 	}
 
-	if (markedAsPhantom || compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::PHANTOM_PHYSICS) > 0) {
+	if (markedAsPhantom || prefab.GetComponentId(eReplicaComponentType::PHANTOM_PHYSICS) > 0) {
 		PhantomPhysicsComponent* phantomPhysics = new PhantomPhysicsComponent(this);
 		phantomPhysics->SetPhysicsEffectActive(false);
 		m_Components.insert(std::make_pair(eReplicaComponentType::PHANTOM_PHYSICS, phantomPhysics));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::VEHICLE_PHYSICS) > 0) {
+	if (prefab.GetComponentId(eReplicaComponentType::VEHICLE_PHYSICS) > 0) {
 		VehiclePhysicsComponent* vehiclePhysicsComponent = new VehiclePhysicsComponent(this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::VEHICLE_PHYSICS, vehiclePhysicsComponent));
 		vehiclePhysicsComponent->SetPosition(m_DefaultPosition);
 		vehiclePhysicsComponent->SetRotation(m_DefaultRotation);
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::SOUND_TRIGGER, -1) != -1) {
+	if (prefab.GetComponentId(eReplicaComponentType::SOUND_TRIGGER, -1) != -1) {
 		auto* comp = new SoundTriggerComponent(this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::SOUND_TRIGGER, comp));
 	}
@@ -307,12 +308,12 @@ void Entity::Initialize() {
 	//Also check for the collectible id:
 	m_CollectibleID = GetVarAs<int32_t>(u"collectible_id");
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::BUFF) > 0) {
+	if (prefab.GetComponentId(eReplicaComponentType::BUFF) > 0) {
 		BuffComponent* comp = new BuffComponent(this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::BUFF, comp));
 	}
 
-	int collectibleComponentID = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::COLLECTIBLE);
+	int collectibleComponentID = prefab.GetComponentId(eReplicaComponentType::COLLECTIBLE);
 
 	if (collectibleComponentID > 0) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::COLLECTIBLE, nullptr));
@@ -322,16 +323,15 @@ void Entity::Initialize() {
 	 * Multiple components require the destructible component.
 	 */
 
-	int buffComponentID = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::BUFF);
-	int rebuildComponentID = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::QUICK_BUILD);
+	int buffComponentID = prefab.GetComponentId(eReplicaComponentType::BUFF);
+	int rebuildComponentID = prefab.GetComponentId(eReplicaComponentType::QUICK_BUILD);
 
 	int componentID = 0;
 	if (collectibleComponentID > 0) componentID = collectibleComponentID;
 	if (rebuildComponentID > 0) componentID = rebuildComponentID;
 	if (buffComponentID > 0) componentID = buffComponentID;
 
-	CDDestructibleComponentTable* destCompTable = CDClientManager::Instance()->GetTable<CDDestructibleComponentTable>("DestructibleComponent");
-	std::vector<CDDestructibleComponent> destCompData = destCompTable->Query([=](CDDestructibleComponent entry) { return (entry.id == componentID); });
+	const auto* destCompData = prefab.GetDestructible();
 
 	if (buffComponentID > 0 || collectibleComponentID > 0) {
 		DestroyableComponent* comp = new DestroyableComponent(this);
@@ -339,36 +339,29 @@ void Entity::Initialize() {
 			comp->LoadFromXml(m_Character->GetXMLDoc());
 		} else {
 			if (componentID > 0) {
-				std::vector<CDDestructibleComponent> destCompData = destCompTable->Query([=](CDDestructibleComponent entry) { return (entry.id == componentID); });
+				if (destCompData != nullptr) {
+					// A race car has 60 imagination
+					const auto imagination = HasComponent(eReplicaComponentType::RACING_STATS) ? 60 : destCompData->imagination;
 
-				if (destCompData.size() > 0) {
-					if (HasComponent(eReplicaComponentType::RACING_STATS)) {
-						destCompData[0].imagination = 60;
-					}
-
-					comp->SetHealth(destCompData[0].life);
-					comp->SetImagination(destCompData[0].imagination);
-					comp->SetArmor(destCompData[0].armor);
+					comp->SetHealth(destCompData->life);
+					comp->SetImagination(imagination);
+					comp->SetArmor(destCompData->armor);
 
-					comp->SetMaxHealth(destCompData[0].life);
-					comp->SetMaxImagination(destCompData[0].imagination);
-					comp->SetMaxArmor(destCompData[0].armor);
+					comp->SetMaxHealth(destCompData->life);
+					comp->SetMaxImagination(imagination);
+					comp->SetMaxArmor(destCompData->armor);
 
-					comp->SetIsSmashable(destCompData[0].isSmashable);
+					comp->SetIsSmashable(destCompData->isSmashable);
 
-					comp->SetLootMatrixID(destCompData[0].LootMatrixIndex);
+					comp->SetLootMatrixID(destCompData->LootMatrixIndex);
 
-					// Now get currency information
-					uint32_t npcMinLevel = destCompData[0].level;
-					uint32_t currencyIndex = destCompData[0].CurrencyIndex;
+					uint32_t minCoins;
+					uint32_t maxCoins;
 
-					CDCurrencyTableTable* currencyTable = CDClientManager::Instance()->GetTable<CDCurrencyTableTable>("CurrencyTable");
-					std::vector<CDCurrencyTable> currencyValues = currencyTable->Query([=](CDCurrencyTable entry) { return (entry.currencyIndex == currencyIndex && entry.npcminlevel == npcMinLevel); });
-
-					if (currencyValues.size() > 0) {
+					if (prefab.GetCoins(minCoins, maxCoins)) {
 						// Set the coins
-						comp->SetMinCoins(currencyValues[0].minvalue);
-						comp->SetMaxCoins(currencyValues[0].maxvalue);
+						comp->SetMinCoins(minCoins);
+						comp->SetMaxCoins(maxCoins);
 					}
 
 					// extraInfo overrides
@@ -391,13 +384,13 @@ void Entity::Initialize() {
 			}
 		}
 
-		if (destCompData.size() > 0) {
-			comp->AddFaction(destCompData[0].faction);
-			std::stringstream ss(destCompData[0].factionList);
+		if (destCompData != nullptr) {
+			comp->AddFaction(destCompData->faction);
+			std::stringstream ss(destCompData->factionList);
 			std::string token;
 
 			while (std::getline(ss, token, ',')) {
-				if (std::stoi(token) == destCompData[0].faction) continue;
+				if (std::stoi(token) == destCompData->faction) continue;
 
 				if (token != "") {
 					comp->AddFaction(std::stoi(token));
@@ -408,7 +401,7 @@ void Entity::Initialize() {
 		m_Components.insert(std::make_pair(eReplicaComponentType::DESTROYABLE, comp));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::CHARACTER) > 0 || m_Character) {
+	if (prefab.GetComponentId(eReplicaComponentType::CHARACTER) > 0 || m_Character) {
 		// Character Component always has a possessor, level, and forced movement components
 		m_Components.insert(std::make_pair(eReplicaComponentType::POSSESSOR, new PossessorComponent(this)));
 
@@ -424,14 +417,14 @@ void Entity::Initialize() {
 		m_Components.insert(std::make_pair(eReplicaComponentType::CHARACTER, charComp));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::INVENTORY) > 0 || m_Character) {
+	if (prefab.GetComponentId(eReplicaComponentType::INVENTORY) > 0 || m_Character) {
 		InventoryComponent* comp = nullptr;
 		if (m_Character) comp = new InventoryComponent(this, m_Character->GetXMLDoc());
 		else comp = new InventoryComponent(this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::INVENTORY, comp));
 	}
 	// if this component exists, then we initialize it. it's value is always 0
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::ROCKET_LAUNCH_LUP, -1) != -1) {
+	if (prefab.GetComponentId(eReplicaComponentType::ROCKET_LAUNCH_LUP, -1) != -1) {
 		auto comp = new RocketLaunchLupComponent(this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::ROCKET_LAUNCH_LUP, comp));
 	}
@@ -440,17 +433,15 @@ void Entity::Initialize() {
 	 * This is a bit of a mess
 	 */
 
-	CDScriptComponentTable* scriptCompTable = CDClientManager::Instance()->GetTable<CDScriptComponentTable>("ScriptComponent");
-	int32_t scriptComponentID = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::SCRIPT, -1);
+	int32_t scriptComponentID = prefab.GetComponentId(eReplicaComponentType::SCRIPT, -1);
 
 	std::string scriptName = "";
 	bool client = false;
 	if (scriptComponentID > 0 || m_Character) {
 		std::string clientScriptName;
 		if (!m_Character) {
-			CDScriptComponent scriptCompData = scriptCompTable->GetByID(scriptComponentID);
-			scriptName = scriptCompData.script_name;
-			clientScriptName = scriptCompData.client_script_name;
+			scriptName = prefab.GetScriptName();
+			clientScriptName = prefab.GetClientScriptName();
 		} else {
 			scriptName = "";
 		}
@@ -495,6 +486,7 @@ void Entity::Initialize() {
 
 		if (zoneData != nullptr) {
 			int zoneScriptID = zoneData->scriptID;
+			CDScriptComponentTable* scriptCompTable = CDClientManager::Instance()->GetTable<CDScriptComponentTable>("ScriptComponent");
 			CDScriptComponent zoneScriptData = scriptCompTable->GetByID(zoneScriptID);
 
 			ScriptComponent* comp = new ScriptComponent(this, zoneScriptData.script_name, true);
@@ -502,33 +494,32 @@ void Entity::Initialize() {
 		}
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::SKILL, -1) != -1 || m_Character) {
+	if (prefab.GetComponentId(eReplicaComponentType::SKILL, -1) != -1 || m_Character) {
 		SkillComponent* comp = new SkillComponent(this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::SKILL, comp));
 	}
 
-	const auto combatAiId = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::BASE_COMBAT_AI);
+	const auto combatAiId = prefab.GetComponentId(eReplicaComponentType::BASE_COMBAT_AI);
 	if (combatAiId > 0) {
-		BaseCombatAIComponent* comp = new BaseCombatAIComponent(this, combatAiId);
+		BaseCombatAIComponent* comp = new BaseCombatAIComponent(this, prefab);
 		m_Components.insert(std::make_pair(eReplicaComponentType::BASE_COMBAT_AI, comp));
 	}
 
-	if (int componentID = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::QUICK_BUILD) > 0) {
+	if (int componentID = prefab.GetComponentId(eReplicaComponentType::QUICK_BUILD) > 0) {
 		RebuildComponent* comp = new RebuildComponent(this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::QUICK_BUILD, comp));
 
-		CDRebuildComponentTable* rebCompTable = CDClientManager::Instance()->GetTable<CDRebuildComponentTable>("RebuildComponent");
-		std::vector<CDRebuildComponent> rebCompData = rebCompTable->Query([=](CDRebuildComponent entry) { return (entry.id == rebuildComponentID); });
+		const auto* rebCompData = prefab.GetRebuild();
 
-		if (rebCompData.size() > 0) {
-			comp->SetResetTime(rebCompData[0].reset_time);
-			comp->SetCompleteTime(rebCompData[0].complete_time);
-			comp->SetTakeImagination(rebCompData[0].take_imagination);
-			comp->SetInterruptible(rebCompData[0].interruptible);
-			comp->SetSelfActivator(rebCompData[0].self_activator);
-			comp->SetActivityId(rebCompData[0].activityID);
-			comp->SetPostImaginationCost(rebCompData[0].post_imagination_cost);
-			comp->SetTimeBeforeSmash(rebCompData[0].time_before_smash);
+		if (rebCompData != nullptr) {
+			comp->SetResetTime(rebCompData->reset_time);
+			comp->SetCompleteTime(rebCompData->complete_time);
+			comp->SetTakeImagination(rebCompData->take_imagination);
+			comp->SetInterruptible(rebCompData->interruptible);
+			comp->SetSelfActivator(rebCompData->self_activator);
+			comp->SetActivityId(rebCompData->activityID);
+			comp->SetPostImaginationCost(rebCompData->post_imagination_cost);
+			comp->SetTimeBeforeSmash(rebCompData->time_before_smash);
 
 			const auto rebuildResetTime = GetVar<float>(u"rebuild_reset_time");
 
@@ -555,51 +546,51 @@ void Entity::Initialize() {
 		}
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::SWITCH, -1) != -1) {
+	if (prefab.GetComponentId(eReplicaComponentType::SWITCH, -1) != -1) {
 		SwitchComponent* comp = new SwitchComponent(this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::SWITCH, comp));
 	}
 
-	if ((compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::VENDOR) > 0)) {
+	if ((prefab.GetComponentId(eReplicaComponentType::VENDOR) > 0)) {
 		VendorComponent* comp = new VendorComponent(this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::VENDOR, comp));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::PROPERTY_VENDOR, -1) != -1) {
+	if (prefab.GetComponentId(eReplicaComponentType::PROPERTY_VENDOR, -1) != -1) {
 		auto* component = new PropertyVendorComponent(this);
 		m_Components.insert_or_assign(eReplicaComponentType::PROPERTY_VENDOR, component);
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::PROPERTY_MANAGEMENT, -1) != -1) {
+	if (prefab.GetComponentId(eReplicaComponentType::PROPERTY_MANAGEMENT, -1) != -1) {
 		auto* component = new PropertyManagementComponent(this);
 		m_Components.insert_or_assign(eReplicaComponentType::PROPERTY_MANAGEMENT, component);
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::BOUNCER, -1) != -1) { // you have to determine it like this because all bouncers have a componentID of 0
+	if (prefab.GetComponentId(eReplicaComponentType::BOUNCER, -1) != -1) { // you have to determine it like this because all bouncers have a componentID of 0
 		BouncerComponent* comp = new BouncerComponent(this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::BOUNCER, comp));
 	}
 
-	if ((compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::RENDER) > 0 && m_TemplateID != 2365) || m_Character) {
+	if ((prefab.GetComponentId(eReplicaComponentType::RENDER) > 0 && m_TemplateID != 2365) || m_Character) {
 		RenderComponent* render = new RenderComponent(this);
 		m_Components.insert(std::make_pair(eReplicaComponentType::RENDER, render));
 	}
 
-	if ((compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::MISSION_OFFER) > 0) || m_Character) {
+	if ((prefab.GetComponentId(eReplicaComponentType::MISSION_OFFER) > 0) || m_Character) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::MISSION_OFFER, new MissionOfferComponent(this, m_TemplateID)));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::BUILD_BORDER, -1) != -1) {
+	if (prefab.GetComponentId(eReplicaComponentType::BUILD_BORDER, -1) != -1) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::BUILD_BORDER, new BuildBorderComponent(this)));
 	}
 
 	// Scripted activity component
-	int scriptedActivityID = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::SCRIPTED_ACTIVITY);
+	int scriptedActivityID = prefab.GetComponentId(eReplicaComponentType::SCRIPTED_ACTIVITY);
 	if ((scriptedActivityID > 0)) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::SCRIPTED_ACTIVITY, new ScriptedActivityComponent(this, scriptedActivityID)));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::MODEL, -1) != -1 && !GetComponent<PetComponent>()) {
+	if (prefab.GetComponentId(eReplicaComponentType::MODEL, -1) != -1 && !GetComponent<PetComponent>()) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::MODEL, new ModelComponent(this)));
 		if (m_Components.find(eReplicaComponentType::DESTROYABLE) == m_Components.end()) {
 			auto destroyableComponent = new DestroyableComponent(this);
@@ -612,43 +603,42 @@ void Entity::Initialize() {
 	}
 
 	PetComponent* petComponent;
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::ITEM) > 0 && !TryGetComponent(eReplicaComponentType::PET, petComponent) && !HasComponent(eReplicaComponentType::MODEL)) {
+	if (prefab.GetComponentId(eReplicaComponentType::ITEM) > 0 && !TryGetComponent(eReplicaComponentType::PET, petComponent) && !HasComponent(eReplicaComponentType::MODEL)) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::ITEM, nullptr));
 	}
 
 	// Shooting gallery component
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::SHOOTING_GALLERY) > 0) {
+	if (prefab.GetComponentId(eReplicaComponentType::SHOOTING_GALLERY) > 0) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::SHOOTING_GALLERY, new ShootingGalleryComponent(this)));
 	}
 
-	if (compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::PROPERTY, -1) != -1) {
+	if (prefab.GetComponentId(eReplicaComponentType::PROPERTY, -1) != -1) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::PROPERTY, new PropertyComponent(this)));
 	}
 
-	const int rocketId = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::ROCKET_LAUNCH);
+	const int rocketId = prefab.GetComponentId(eReplicaComponentType::ROCKET_LAUNCH);
 	if ((rocketId > 0)) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::ROCKET_LAUNCH, new RocketLaunchpadControlComponent(this, rocketId)));
 	}
 
-	const int32_t railComponentID = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::RAIL_ACTIVATOR);
+	const int32_t railComponentID = prefab.GetComponentId(eReplicaComponentType::RAIL_ACTIVATOR);
 	if (railComponentID > 0) {
 		m_Components.insert(std::make_pair(eReplicaComponentType::RAIL_ACTIVATOR, new RailActivatorComponent(this, railComponentID)));
 	}
 
-	int movementAIID = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::MOVEMENT_AI);
+	int movementAIID = prefab.GetComponentId(eReplicaComponentType::MOVEMENT_AI);
 	if (movementAIID > 0) {
-		CDMovementAIComponentTable* moveAITable = CDClientManager::Instance()->GetTable<CDMovementAIComponentTable>("MovementAIComponent");
-		std::vector<CDMovementAIComponent> moveAIComp = moveAITable->Query([=](CDMovementAIComponent entry) {return (entry.id == movementAIID); });
+		const auto* moveAIComp = prefab.GetMovementAI();
 
-		if (moveAIComp.size() > 0) {
+		if (moveAIComp != nullptr) {
 			MovementAIInfo moveInfo = MovementAIInfo();
 
-			moveInfo.movementType = moveAIComp[0].MovementType;
-			moveInfo.wanderChance = moveAIComp[0].WanderChance;
-			moveInfo.wanderRadius = moveAIComp[0].WanderRadius;
-			moveInfo.wanderSpeed = moveAIComp[0].WanderSpeed;
-			moveInfo.wanderDelayMax = moveAIComp[0].WanderDelayMax;
-			moveInfo.wanderDelayMin = moveAIComp[0].WanderDelayMin;
+			moveInfo.movementType = moveAIComp->MovementType;
+			moveInfo.wanderChance = moveAIComp->WanderChance;
+			moveInfo.wanderRadius = moveAIComp->WanderRadius;
+			moveInfo.wanderSpeed = moveAIComp->WanderSpeed;
+			moveInfo.wanderDelayMax = moveAIComp->WanderDelayMax;
+			moveInfo.wanderDelayMin = moveAIComp->WanderDelayMin;
 
 			bool useWanderDB = GetVar<bool>(u"usewanderdb");
 
@@ -694,15 +684,10 @@ void Entity::Initialize() {
 		}*/
 	}
 
-	int proximityMonitorID = compRegistryTable->GetByIDAndType(m_TemplateID, eReplicaComponentType::PROXIMITY_MONITOR);
-	if (proximityMonitorID > 0) {
-		CDProximityMonitorComponentTable* proxCompTable = CDClientManager::Instance()->GetTable<CDProximityMonitorComponentTable>("ProximityMonitorComponent");
-		std::vector<CDProximityMonitorComponent> proxCompData = proxCompTable->Query([=](CDProximityMonitorComponent entry) { return (entry.id == proximityMonitorID); });
-		if (proxCompData.size() > 0) {
-			std::vector<std::string> proximityStr = GeneralUtils::SplitString(proxCompData[0].Proximities, ',');
-			ProximityMonitorComponent* comp = new ProximityMonitorComponent(this, std::stoi(proximityStr[0]), std::stoi(proximityStr[1]));
-			m_Components.insert(std::make_pair(eReplicaComponentType::PROXIMITY_MONITOR, comp));
-		}
+	const auto* proximities = prefab.GetProximities();
+	if (proximities != nullptr) {
+		ProximityMonitorComponent* comp = new ProximityMonitorComponent(this, proximities->first, proximities->second);
+		m_Components.insert(std::make_pair(eReplicaComponentType::PROXIMITY_MONITOR, comp));
 	}
 
 	// Hacky way to trigger these when the object has had a chance to get constructed
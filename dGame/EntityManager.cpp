@@ -22,6 +22,9 @@
 #include "eTriggerEventType.h"
 #include "eReplicaComponentType.h"
 
+#include <memory>
+#include <unordered_set>
+
 EntityManager* EntityManager::m_Address = nullptr;
 
 // Configure which zones have ghosting disabled, mostly small worlds.
@@ -310,20 +313,37 @@ const std::unordered_map<std::string, LWOOBJID>& EntityManager::GetSpawnPointEnt
 	return m_SpawnPoints;
 }
 
-void EntityManager::ConstructEntity(Entity* entity, const SystemAddress& sysAddr, const bool skipChecks) {
-	if (entity->GetNetworkId() == 0) {
-		uint16_t networkId;
+void EntityManager::AssignNetworkId(Entity* entity) {
+	if (entity->GetNetworkId() != 0) {
+		return;
+	}
 
-		if (!m_LostNetworkIds.empty()) {
-			networkId = m_LostNetworkIds.top();
-			m_LostNetworkIds.pop();
-		} else {
-			networkId = ++m_NetworkIdCounter;
-		}
+	uint16_t networkId;
 
-		entity->SetNetworkId(networkId);
+	if (!m_LostNetworkIds.empty()) {
+		networkId = m_LostNetworkIds.top();
+		m_LostNetworkIds.pop();
+	} else {
+		networkId = ++m_NetworkIdCounter;
 	}
 
+	entity->SetNetworkId(networkId);
+}
+
+void EntityManager::WriteConstruction(Entity* entity, RakNet::BitStream& stream) {
+	m_SerializationCounter++;
+
+	stream.Write(static_cast<char>(ID_REPLICA_MANAGER_CONSTRUCTION));
+	stream.Write(true);
+	stream.Write(static_cast<unsigned short>(entity->GetNetworkId()));
+
+	entity->WriteBaseReplicaData(&stream, PACKET_TYPE_CONSTRUCTION);
+	entity->WriteComponents(&stream, PACKET_TYPE_CONSTRUCTION);
+}
+
+void EntityManager::ConstructEntity(Entity* entity, const SystemAddress& sysAddr, const bool skipChecks) {
+	AssignNetworkId(entity);
+
 	const auto checkGhosting = entity->GetIsGhostingCandidate();
 
 	if (checkGhosting) {
@@ -340,16 +360,9 @@ void EntityManager::ConstructEntity(Entity* entity, const SystemAddress& sysAddr
 		return;
 	}
 
-	m_SerializationCounter++;
-
 	RakNet::BitStream stream;
 
-	stream.Write(static_cast<char>(ID_REPLICA_MANAGER_CONSTRUCTION));
-	stream.Write(true);
-	stream.Write(static_cast<unsigned short>(entity->GetNetworkId()));
-
-	entity->WriteBaseReplicaData(&stream, PACKET_TYPE_CONSTRUCTION);
-	entity->WriteComponents(&stream, PACKET_TYPE_CONSTRUCTION);
+	WriteConstruction(entity, stream);
 
 	if (sysAddr == UNASSIGNED_SYSTEM_ADDRESS) {
 		if (skipChecks) {
@@ -376,6 +389,85 @@ void EntityManager::ConstructEntity(Entity* entity, const SystemAddress& sysAddr
 	}
 }
 
+void EntityManager::ConstructEntities(const std::vector<Entity*>& entities) {
+	if (entities.empty()) {
+		return;
+	}
+
+	// Register the new ghosting candidates with a single pass over the known ones
+	std::unordered_set<Entity*> newCandidates;
+
+	for (auto* entity : entities) {
+		AssignNetworkId(entity);
+
+		if (entity->GetIsGhostingCandidate()) {
+			newCandidates.insert(entity);
+		}
+	}
+
+	if (!newCandidates.empty()) {
+		for (auto* candidate : m_EntitiesToGhost) {
+			newCandidates.erase(candidate);
+		}
+
+		for (auto* entity : entities) {
+			if (newCandidates.erase(entity) != 0) {
+				m_EntitiesToGhost.push_back(entity);
+			}
+		}
+	}
+
+	// Serialized when first sent, ghosted entities nobody is near are never serialized
+	std::vector<std::unique_ptr<RakNet::BitStream>> streams(entities.size());
+
+	const auto getStream = [&](size_t index) {
+		if (streams[index] == nullptr) {
+			streams[index] = std::make_unique<RakNet::BitStream>();
+
+			WriteConstruction(entities[index], *streams[index]);
+		}
+
+		return streams[index].get();
+	};
+
+	for (auto* player : Player::GetAllPlayers()) {
+		const auto& sysAddr = player->GetSystemAddress();
+		const auto readyForUpdates = player->GetPlayerReadyForUpdates();
+
+		for (size_t i = 0; i < entities.size(); ++i) {
+			auto* entity = entities[i];
+
+			if (!entity->GetIsGhostingCandidate()) {
+				if (readyForUpdates) {
+					Game::server->Send(getStream(i), sysAddr, false);
+				} else {
+					player->AddLimboConstruction(entity->GetObjectID());
+				}
+
+				continue;
+			}
+
+			const int32_t id = entity->GetObjectID();
+
+			const auto action = GetGhostingAction(entity, player);
+
+			if (action == GhostingAction::Ghost) {
+				player->GhostEntity(id);
+
+				DestructEntity(entity, sysAddr);
+
+				entity->SetObservers(entity->GetObservers() - 1);
+			} else if (action == GhostingAction::Observe) {
+				player->ObserveEntity(id);
+
+				Game::server->Send(getStream(i), sysAddr, false);
+
+				entity->SetObservers(entity->GetObservers() + 1);
+			}
+		}
+	}
+}
+
 void EntityManager::ConstructAllEntities(const SystemAddress& sysAddr) {
 	//ZoneControl is special:
 	ConstructEntity(m_ZoneControlEntity, sysAddr);
@@ -475,34 +567,20 @@ void EntityManager::UpdateGhosting(Player* player) {
 		return;
 	}
 
-	const auto& referencePoint = player->GetGhostReferencePoint();
 	const auto isOverride = player->GetGhostOverride();
 
 	for (auto* entity : m_EntitiesToGhost) {
-		const auto isAudioEmitter = entity->GetLOT() == 6368;
-
-		const auto& entityPoint = entity->GetPosition();
-
 		const int32_t id = entity->GetObjectID();
 
-		const auto observed = player->IsObserved(id);
-
-		const auto distance = NiPoint3::DistanceSquared(referencePoint, entityPoint);
-
-		auto ghostingDistanceMax = m_GhostDistanceMaxSquared;
-		auto ghostingDistanceMin = m_GhostDistanceMinSqaured;
-
-		if (isAudioEmitter) {
-			ghostingDistanceMax = ghostingDistanceMin;
-		}
+		const auto action = GetGhostingAction(entity, player);
 
-		if (observed && distance > ghostingDistanceMax && !isOverride) {
+		if (action == GhostingAction::Ghost && !isOverride) {
 			player->GhostEntity(id);
 
 			DestructEntity(entity, player->GetSystemAddress());
 
 			entity->SetObservers(entity->GetObservers() - 1);
-		} else if (!observed && ghostingDistanceMin > distance) {
+		} else if (action == GhostingAction::Observe) {
 			// Check collectables, don't construct if it has been collected
 			uint32_t collectionId = entity->GetCollectibleID();
 
@@ -528,29 +606,18 @@ void EntityManager::CheckGhosting(Entity* entity) {
 		return;
 	}
 
-	const auto& referencePoint = entity->GetPosition();
-
-	auto ghostingDistanceMax = m_GhostDistanceMaxSquared;
-	auto ghostingDistanceMin = m_GhostDistanceMinSqaured;
-
-	const auto isAudioEmitter = entity->GetLOT() == 6368;
-
 	for (auto* player : Player::GetAllPlayers()) {
-		const auto& entityPoint = player->GetGhostReferencePoint();
-
 		const int32_t id = entity->GetObjectID();
 
-		const auto observed = player->IsObserved(id);
+		const auto action = GetGhostingAction(entity, player);
 
-		const auto distance = NiPoint3::DistanceSquared(referencePoint, entityPoint);
-
-		if (observed && distance > ghostingDistanceMax) {
+		if (action == GhostingAction::Ghost) {
 			player->GhostEntity(id);
 
 			DestructEntity(entity, player->GetSystemAddress());
 
 			entity->SetObservers(entity->GetObservers() - 1);
-		} else if (!observed && ghostingDistanceMin > distance) {
+		} else if (action == GhostingAction::Observe) {
 			player->ObserveEntity(id);
 
 			ConstructEntity(entity, player->GetSystemAddress());
@@ -560,6 +627,26 @@ void EntityManager::CheckGhosting(Entity* entity) {
 	}
 }
 
+EntityManager::GhostingAction EntityManager::GetGhostingAction(const Entity* entity, Player* player) const {
+	const auto observed = player->IsObserved(entity->GetObjectID());
+
+	const auto distance = NiPoint3::DistanceSquared(player->GetGhostReferencePoint(), entity->GetPosition());
+
+	auto ghostingDistanceMax = m_GhostDistanceMaxSquared;
+	const auto ghostingDistanceMin = m_GhostDistanceMinSqaured;
+
+	// Audio emitters are ghosted as soon as they leave the range they are constructed in
+	if (entity->GetLOT() == 6368) {
+		ghostingDistanceMax = ghostingDistanceMin;
+	}
+
+	if (observed && distance > ghostingDistanceMax) return GhostingAction::Ghost;
+
+	if (!observed && ghostingDistanceMin > distance) return GhostingAction::Observe;
+
+	return GhostingAction::None;
+}
+
 Entity* EntityManager::GetGhostCandidate(int32_t id) {
 	for (auto* entity : m_EntitiesToGhost) {
 		if (entity->GetObjectID() == id) {
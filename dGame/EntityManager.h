@@ -15,6 +15,10 @@ enum class eReplicaComponentType : uint32_t;
 
 struct SystemAddress;
 
+namespace RakNet {
+	class BitStream;
+};
+
 class EntityManager {
 public:
 	static EntityManager* Instance() {
@@ -52,6 +56,14 @@ public:
 #endif
 
 	void ConstructEntity(Entity* entity, const SystemAddress& sysAddr = UNASSIGNED_SYSTEM_ADDRESS, bool skipChecks = false);
+
+	/**
+	 * Constructs many new entities for every player at once, as ConstructEntity would one at a time.
+	 * Each entity is serialized once, what each player can see is worked out in one pass over the players,
+	 * and each player gets its constructions back to back so they share datagrams.
+	 * Meant for spawned entities, players go through ConstructEntity.
+	 */
+	void ConstructEntities(const std::vector<Entity*>& entities);
 	void DestructEntity(Entity* entity, const SystemAddress& sysAddr = UNASSIGNED_SYSTEM_ADDRESS);
 	void SerializeEntity(Entity* entity);
 
@@ -85,6 +97,20 @@ public:
 	const uint32_t GetHardcoreUscoreEnemiesMultiplier() { return m_HardcoreUscoreEnemiesMultiplier; };
 
 private:
+	enum class GhostingAction {
+		None,
+		Ghost,
+		Observe
+	};
+
+	void AssignNetworkId(Entity* entity);
+	void WriteConstruction(Entity* entity, RakNet::BitStream& stream);
+
+	/**
+	 * Decides whether a player should stop or start observing a ghosting candidate, based on how far it is from them
+	 */
+	GhostingAction GetGhostingAction(const Entity* entity, Player* player) const;
+
 	static EntityManager* m_Address; //For singleton method
 	static std::vector<LWOMAPID> m_GhostingExcludedZones;
 	static std::vector<LOT> m_GhostingExcludedLOTs;
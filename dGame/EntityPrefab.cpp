@@ -0,0 +1,171 @@
+#include "EntityPrefab.h"
+
+#include "CDClientDatabase.h"
+#include "CDClientManager.h"
+#include "CDComponentsRegistryTable.h"
+#include "CDCurrencyTableTable.h"
+#include "CDProximityMonitorComponentTable.h"
+#include "CDScriptComponentTable.h"
+#include "GeneralUtils.h"
+#include "eReplicaComponentType.h"
+
+std::unordered_map<LOT, std::unique_ptr<EntityPrefab>> EntityPrefab::m_Prefabs{};
+
+const EntityPrefab& EntityPrefab::GetPrefab(const LOT lot) {
+	const auto& iter = m_Prefabs.find(lot);
+
+	if (iter != m_Prefabs.end()) {
+		return *iter->second;
+	}
+
+	auto* prefab = new EntityPrefab(lot);
+
+	m_Prefabs.emplace(lot, prefab);
+
+	return *prefab;
+}
+
+int32_t EntityPrefab::GetComponentId(const eReplicaComponentType componentType, const int32_t defaultValue) const {
+	// Few LOTs have more than a dozen components, a scan beats hashing
+	for (const auto& [type, id] : m_ComponentIds) {
+		if (type == componentType) return id;
+	}
+
+	return defaultValue;
+}
+
+bool EntityPrefab::GetCoins(uint32_t& minCoins, uint32_t& maxCoins) const {
+	if (!m_HasCoins) return false;
+
+	minCoins = m_MinCoins;
+	maxCoins = m_MaxCoins;
+
+	return true;
+}
+
+EntityPrefab::EntityPrefab(const LOT lot) {
+	m_LOT = lot;
+
+	auto* compRegistryTable = CDClientManager::Instance()->GetTable<CDComponentsRegistryTable>("ComponentsRegistry");
+
+	m_ComponentIds = compRegistryTable->GetComponentsByID(lot);
+
+	LoadDestructible();
+
+	const auto scriptComponentID = GetComponentId(eReplicaComponentType::SCRIPT, -1);
+	if (scriptComponentID > 0) {
+		auto* scriptCompTable = CDClientManager::Instance()->GetTable<CDScriptComponentTable>("ScriptComponent");
+		const auto& scriptCompData = scriptCompTable->GetByID(scriptComponentID);
+
+		m_ScriptName = scriptCompData.script_name;
+		m_ClientScriptName = scriptCompData.client_script_name;
+	}
+
+	const auto rebuildComponentID = GetComponentId(eReplicaComponentType::QUICK_BUILD);
+	if (rebuildComponentID > 0) {
+		auto* rebCompTable = CDClientManager::Instance()->GetTable<CDRebuildComponentTable>("RebuildComponent");
+		const auto rebCompData = rebCompTable->Query([=](CDRebuildComponent entry) { return (entry.id == rebuildComponentID); });
+
+		if (!rebCompData.empty()) {
+			m_HasRebuild = true;
+			m_Rebuild = rebCompData[0];
+		}
+	}
+
+	const auto movementAIID = GetComponentId(eReplicaComponentType::MOVEMENT_AI);
+	if (movementAIID > 0) {
+		auto* moveAITable = CDClientManager::Instance()->GetTable<CDMovementAIComponentTable>("MovementAIComponent");
+		const auto moveAIComp = moveAITable->Query([=](CDMovementAIComponent entry) { return (entry.id == movementAIID); });
+
+		if (!moveAIComp.empty()) {
+			m_HasMovementAI = true;
+			m_MovementAI = moveAIComp[0];
+		}
+	}
+
+	const auto proximityMonitorID = GetComponentId(eReplicaComponentType::PROXIMITY_MONITOR);
+	if (proximityMonitorID > 0) {
+		auto* proxCompTable = CDClientManager::Instance()->GetTable<CDProximityMonitorComponentTable>("ProximityMonitorComponent");
+		const auto proxCompData = proxCompTable->Query([=](CDProximityMonitorComponent entry) { return (entry.id == proximityMonitorID); });
+
+		if (!proxCompData.empty()) {
+			const auto proximityStr = GeneralUtils::SplitString(proxCompData[0].Proximities, ',');
+
+			m_HasProximities = true;
+			m_Proximities = std::make_pair(std::stoi(proximityStr[0]), std::stoi(proximityStr[1]));
+		}
+	}
+
+	const auto combatAiId = GetComponentId(eReplicaComponentType::BASE_COMBAT_AI);
+	if (combatAiId > 0) {
+		LoadCombatAI();
+	}
+}
+
+void EntityPrefab::LoadDestructible() {
+	const auto buffComponentID = GetComponentId(eReplicaComponentType::BUFF);
+	const auto collectibleComponentID = GetComponentId(eReplicaComponentType::COLLECTIBLE);
+	const auto rebuildComponentID = GetComponentId(eReplicaComponentType::QUICK_BUILD);
+
+	int32_t componentID = 0;
+	if (collectibleComponentID > 0) componentID = collectibleComponentID;
+	if (rebuildComponentID > 0) componentID = rebuildComponentID;
+	if (buffComponentID > 0) componentID = buffComponentID;
+
+	auto* destCompTable = CDClientManager::Instance()->GetTable<CDDestructibleComponentTable>("DestructibleComponent");
+	const auto destCompData = destCompTable->Query([=](CDDestructibleComponent entry) { return (entry.id == componentID); });
+
+	if (destCompData.empty()) return;
+
+	m_HasDestructible = true;
+	m_Destructible = destCompData[0];
+
+	const uint32_t npcMinLevel = m_Destructible.level;
+	const uint32_t currencyIndex = m_Destructible.CurrencyIndex;
+
+	auto* currencyTable = CDClientManager::Instance()->GetTable<CDCurrencyTableTable>("CurrencyTable");
+	const auto currencyValues = currencyTable->Query([=](CDCurrencyTable entry) { return (entry.currencyIndex == currencyIndex && entry.npcminlevel == npcMinLevel); });
+
+	if (!currencyValues.empty()) {
+		m_HasCoins = true;
+		m_MinCoins = currencyValues[0].minvalue;
+		m_MaxCoins = currencyValues[0].maxvalue;
+	}
+}
+
+void EntityPrefab::LoadCombatAI() {
+	auto componentQuery = CDClientDatabase::CreatePreppedStmt(
+		"SELECT aggroRadius, tetherSpeed, pursuitSpeed, softTetherRadius, hardTetherRadius FROM BaseCombatAIComponent WHERE id = ?;");
+	componentQuery.bind(1, GetComponentId(eReplicaComponentType::BASE_COMBAT_AI));
+
+	auto componentResult = componentQuery.execQuery();
+
+	if (!componentResult.eof()) {
+		if (!componentResult.fieldIsNull(0)) m_CombatAI.aggroRadius = componentResult.getFloatField(0);
+		if (!componentResult.fieldIsNull(1)) m_CombatAI.tetherSpeed = componentResult.getFloatField(1);
+		if (!componentResult.fieldIsNull(2)) m_CombatAI.pursuitSpeed = componentResult.getFloatField(2);
+		if (!componentResult.fieldIsNull(3)) m_CombatAI.softTetherRadius = componentResult.getFloatField(3);
+		if (!componentResult.fieldIsNull(4)) m_CombatAI.hardTetherRadius = componentResult.getFloatField(4);
+	}
+
+	componentResult.finalize();
+
+	auto skillQuery = CDClientDatabase::CreatePreppedStmt(
+		"SELECT skillID, cooldown, behaviorID FROM SkillBehavior WHERE skillID IN (SELECT skillID FROM ObjectSkills WHERE objectTemplate = ?);");
+	skillQuery.bind(1, (int)m_LOT);
+
+	auto result = skillQuery.execQuery();
+
+	while (!result.eof()) {
+		PrefabSkill skill;
+		skill.skillId = static_cast<uint32_t>(result.getIntField(0));
+		skill.cooldown = static_cast<float>(result.getFloatField(1));
+		skill.behaviorId = static_cast<uint32_t>(result.getIntField(2));
+
+		m_Skills.push_back(skill);
+
+		result.nextRow();
+	}
+
+	result.finalize();
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dCommonVars.h"
+#include "CDDestructibleComponentTable.h"
+#include "CDMovementAIComponentTable.h"
+#include "CDRebuildComponentTable.h"
+
+enum class eReplicaComponentType : uint32_t;
+
+/**
+ * The aggro settings of an enemy, fields left empty in the database keep the defaults of BaseCombatAIComponent
+ */
+struct PrefabCombatAI {
+	std::optional<float> aggroRadius;
+	std::optional<float> tetherSpeed;
+	std::optional<float> pursuitSpeed;
+	std::optional<float> softTetherRadius;
+	std::optional<float> hardTetherRadius;
+};
+
+/**
+ * A skill an enemy may cast
+ */
+struct PrefabSkill {
+	uint32_t skillId;
+	float cooldown;
+	uint32_t behaviorId;
+};
+
+/**
+ * Everything an entity of a LOT reads from the client database when it is created: which components it has and
+ * the rows those components are set up from.  A prefab is resolved the first time an entity of its LOT is created
+ * and never changes after that, so creating more entities of the LOT only applies their own settings on top of it.
+ *
+ * Only use from the main thread.
+ */
+class EntityPrefab {
+public:
+	/**
+	 * @return The prefab of a LOT, resolved on first use
+	 */
+	static const EntityPrefab& GetPrefab(LOT lot);
+
+	/**
+	 * @return The ID of a component in its table, or defaultValue if the LOT does not have the component
+	 */
+	int32_t GetComponentId(eReplicaComponentType componentType, int32_t defaultValue = 0) const;
+
+	/**
+	 * @return The stats of the destroyable component, taken from the buff, quickbuild or collectible component
+	 */
+	const CDDestructibleComponent* GetDestructible() const { return m_HasDestructible ? &m_Destructible : nullptr; }
+
+	/**
+	 * @return Whether or not coins drop when the entity is smashed, minCoins and maxCoins are set to how many
+	 */
+	bool GetCoins(uint32_t& minCoins, uint32_t& maxCoins) const;
+
+	const std::string& GetScriptName() const { return m_ScriptName; }
+
+	const std::string& GetClientScriptName() const { return m_ClientScriptName; }
+
+	const CDRebuildComponent* GetRebuild() const { return m_HasRebuild ? &m_Rebuild : nullptr; }
+
+	const CDMovementAIComponent* GetMovementAI() const { return m_HasMovementAI ? &m_MovementAI : nullptr; }
+
+	/**
+	 * @return The radii of the proximity monitor, or nullptr if the LOT does not have one
+	 */
+	const std::pair<int32_t, int32_t>* GetProximities() const { return m_HasProximities ? &m_Proximities : nullptr; }
+
+	const PrefabCombatAI& GetCombatAI() const { return m_CombatAI; }
+
+	const std::vector<PrefabSkill>& GetSkills() const { return m_Skills; }
+
+	LOT GetLOT() const { return m_LOT; }
+
+private:
+	explicit EntityPrefab(LOT lot);
+
+	void LoadDestructible();
+
+	void LoadCombatAI();
+
+	static std::unordered_map<LOT, std::unique_ptr<EntityPrefab>> m_Prefabs;
+
+	LOT m_LOT;
+
+	std::vector<std::pair<eReplicaComponentType, int32_t>> m_ComponentIds;
+
+	bool m_HasDestructible = false;
+	CDDestructibleComponent m_Destructible;
+
+	bool m_HasCoins = false;
+	uint32_t m_MinCoins = 0;
+	uint32_t m_MaxCoins = 0;
+
+	std::string m_ScriptName;
+	std::string m_ClientScriptName;
+
+	bool m_HasRebuild = false;
+	CDRebuildComponent m_Rebuild;
+
+	bool m_HasMovementAI = false;
+	CDMovementAIComponent m_MovementAI;
+
+	bool m_HasProximities = false;
+	std::pair<int32_t, int32_t> m_Proximities;
+
+	PrefabCombatAI m_CombatAI;
+	std::vector<PrefabSkill> m_Skills;
+};
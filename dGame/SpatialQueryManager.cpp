@@ -0,0 +1,272 @@
+#include "SpatialQueryManager.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Entity.h"
+#include "DestroyableComponent.h"
+
+SpatialQueryManager* SpatialQueryManager::m_Address = nullptr;
+
+SpatialQuery SpatialQuery::All() {
+	return SpatialQuery();
+}
+
+SpatialQuery SpatialQuery::Sphere(const NiPoint3& center, const float radius) {
+	SpatialQuery query;
+
+	query.shape = Shape::Sphere;
+	query.center = center;
+	query.maxDistance = radius;
+
+	return query;
+}
+
+SpatialQuery SpatialQuery::Arc(const NiPoint3& center, const NiPoint3& forward, const float minDistance, const float maxDistance, const float angle) {
+	SpatialQuery query;
+
+	query.shape = Shape::Arc;
+	query.center = center;
+	query.forward = forward;
+	query.minDistance = minDistance;
+	query.maxDistance = maxDistance;
+	query.angle = angle;
+
+	return query;
+}
+
+SpatialQuery SpatialQuery::Box(const NiPoint3& min, const NiPoint3& max) {
+	SpatialQuery query;
+
+	query.shape = Shape::Box;
+	query.min = min;
+	query.max = max;
+
+	return query;
+}
+
+bool SpatialQuery::Contains(const NiPoint3& position) const {
+	switch (shape) {
+	case Shape::All:
+		return true;
+	case Shape::Sphere:
+		return NiPoint3::DistanceSquared(center, position) <= maxDistance * maxDistance;
+	case Shape::Arc: {
+		const auto offset = position - center;
+		const auto distanceSquared = offset.SquaredLength();
+
+		if (distanceSquared < minDistance * minDistance || distanceSquared > maxDistance * maxDistance) return false;
+
+		// Every direction is within the arc when standing on its tip
+		if (angle >= 180.0f || distanceSquared == 0.0f) return true;
+
+		const auto cosine = forward.DotProduct(offset) / std::sqrt(distanceSquared);
+
+		return cosine >= std::cos(angle * PI / 180.0f);
+	}
+	case Shape::Box:
+		return position.x >= min.x && position.x <= max.x
+			&& position.y >= min.y && position.y <= max.y
+			&& position.z >= min.z && position.z <= max.z;
+	}
+
+	return false;
+}
+
+uint64_t SpatialQueryManager::GetFactionMask(const std::vector<int32_t>& factions) {
+	uint64_t mask = 0;
+
+	for (const auto faction : factions) {
+		mask |= 1ULL << (static_cast<uint32_t>(faction) & 63);
+	}
+
+	return mask;
+}
+
+int32_t SpatialQueryManager::GetCellCoordinate(const float value) {
+	const auto cell = std::floor(value / CELL_SIZE);
+
+	// Keeps invalid positions from overflowing the key, they all end up in the same cell
+	if (!(cell > -1e9f && cell < 1e9f)) return 0;
+
+	return static_cast<int32_t>(cell);
+}
+
+int64_t SpatialQueryManager::GetCellKey(const int32_t x, const int32_t z) {
+	return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(z);
+}
+
+void SpatialQueryManager::Add(Entity* entity, const NiPoint3& position) {
+	const auto id = entity->GetObjectID();
+
+	if (m_Index.find(id) != m_Index.end()) {
+		Move(id, position);
+
+		return;
+	}
+
+	uint32_t entryIndex;
+
+	if (!m_FreeEntries.empty()) {
+		entryIndex = m_FreeEntries.back();
+		m_FreeEntries.pop_back();
+	} else {
+		entryIndex = m_Entries.size();
+		m_Entries.emplace_back();
+	}
+
+	auto& entry = m_Entries[entryIndex];
+
+	entry.id = id;
+	entry.position = position;
+	entry.factionMask = 0;
+
+	auto* destroyableComponent = entity->GetComponent<DestroyableComponent>();
+
+	if (destroyableComponent != nullptr) {
+		entry.factionMask = GetFactionMask(destroyableComponent->GetFactionIDs());
+	}
+
+	m_Index[id] = entryIndex;
+
+	AddToCell(entryIndex);
+}
+
+void SpatialQueryManager::Move(const LWOOBJID id, const NiPoint3& position) {
+	const auto index = m_Index.find(id);
+
+	if (index == m_Index.end()) return;
+
+	auto& entry = m_Entries[index->second];
+
+	entry.position = position;
+
+	// Most moves stay within the same cell
+	if (GetCellKey(GetCellCoordinate(position.x), GetCellCoordinate(position.z)) == entry.cell) return;
+
+	RemoveFromCell(index->second);
+	AddToCell(index->second);
+}
+
+void SpatialQueryManager::SetFactionMask(const LWOOBJID id, const uint64_t factionMask) {
+	const auto index = m_Index.find(id);
+
+	if (index == m_Index.end()) return;
+
+	m_Entries[index->second].factionMask = factionMask;
+}
+
+void SpatialQueryManager::Remove(const LWOOBJID id) {
+	const auto index = m_Index.find(id);
+
+	if (index == m_Index.end()) return;
+
+	RemoveFromCell(index->second);
+
+	m_Entries[index->second].id = LWOOBJID_EMPTY;
+	m_FreeEntries.push_back(index->second);
+
+	m_Index.erase(index);
+}
+
+void SpatialQueryManager::AddToCell(const uint32_t entryIndex) {
+	auto& entry = m_Entries[entryIndex];
+
+	entry.cell = GetCellKey(GetCellCoordinate(entry.position.x), GetCellCoordinate(entry.position.z));
+
+	auto& cell = m_Cells[entry.cell];
+
+	entry.cellSlot = cell.size();
+	cell.push_back(entryIndex);
+}
+
+void SpatialQueryManager::RemoveFromCell(const uint32_t entryIndex) {
+	const auto& entry = m_Entries[entryIndex];
+
+	auto cell = m_Cells.find(entry.cell);
+
+	if (cell == m_Cells.end()) return;
+
+	auto& entries = cell->second;
+
+	// Swap the last entry of the cell into the removed slot
+	const auto moved = entries.back();
+	entries[entry.cellSlot] = moved;
+	m_Entries[moved].cellSlot = entry.cellSlot;
+	entries.pop_back();
+
+	if (entries.empty()) m_Cells.erase(cell);
+}
+
+void SpatialQueryManager::Query(const SpatialQuery& query, const uint64_t factionFilter, std::vector<LWOOBJID>& results) const {
+	if (factionFilter == 0 || m_Cells.empty()) return;
+
+	NiPoint3 min;
+	NiPoint3 max;
+
+	switch (query.shape) {
+	case SpatialQuery::Shape::All:
+		for (const auto& cell : m_Cells) {
+			QueryCell(cell.second, query, factionFilter, results);
+		}
+
+		return;
+	case SpatialQuery::Shape::Sphere:
+	case SpatialQuery::Shape::Arc: {
+		const auto extent = NiPoint3(query.maxDistance, query.maxDistance, query.maxDistance);
+
+		min = query.center - extent;
+		max = query.center + extent;
+
+		break;
+	}
+	case SpatialQuery::Shape::Box:
+		min = query.min;
+		max = query.max;
+
+		break;
+	}
+
+	const auto minX = GetCellCoordinate(min.x);
+	const auto minZ = GetCellCoordinate(min.z);
+	const auto maxX = GetCellCoordinate(max.x);
+	const auto maxZ = GetCellCoordinate(max.z);
+
+	const auto cellCount = (static_cast<int64_t>(maxX) - minX + 1) * (static_cast<int64_t>(maxZ) - minZ + 1);
+
+	// A query covering more cells than are occupied is cheaper to answer by walking the occupied cells
+	if (cellCount > static_cast<int64_t>(m_Cells.size())) {
+		for (const auto& cell : m_Cells) {
+			const auto x = static_cast<int32_t>(cell.first >> 32);
+			const auto z = static_cast<int32_t>(static_cast<uint32_t>(cell.first));
+
+			if (x < minX || x > maxX || z < minZ || z > maxZ) continue;
+
+			QueryCell(cell.second, query, factionFilter, results);
+		}
+
+		return;
+	}
+
+	for (auto x = minX; x <= maxX; ++x) {
+		for (auto z = minZ; z <= maxZ; ++z) {
+			const auto cell = m_Cells.find(GetCellKey(x, z));
+
+			if (cell == m_Cells.end()) continue;
+
+			QueryCell(cell->second, query, factionFilter, results);
+		}
+	}
+}
+
+void SpatialQueryManager::QueryCell(const std::vector<uint32_t>& cell, const SpatialQuery& query, const uint64_t factionFilter, std::vector<LWOOBJID>& results) const {
+	for (const auto entryIndex : cell) {
+		const auto& entry = m_Entries[entryIndex];
+
+		if (factionFilter != ANY_FACTION && (entry.factionMask & factionFilter) == 0) continue;
+
+		if (!query.Contains(entry.position)) continue;
+
+		results.push_back(entry.id);
+	}
+}
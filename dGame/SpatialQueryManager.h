@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "dCommonVars.h"
+#include "NiPoint3.h"
+
+class Entity;
+
+/**
+ * The shape of a spatial query.  Use the static functions to create one.
+ */
+struct SpatialQuery
+{
+	enum class Shape : uint8_t {
+		All,
+		Sphere,
+		Arc,
+		Box
+	};
+
+	Shape shape = Shape::All;
+
+	// Sphere and arc
+	NiPoint3 center{};
+	float minDistance = 0;
+	float maxDistance = 0;
+
+	// Arc, forward must be normalized
+	NiPoint3 forward{};
+	float angle = 0;
+
+	// Box
+	NiPoint3 min{};
+	NiPoint3 max{};
+
+	/**
+	 * Everything in the zone, for callers that have no range to limit the query to
+	 */
+	static SpatialQuery All();
+
+	static SpatialQuery Sphere(const NiPoint3& center, float radius);
+
+	/**
+	 * A slice of a sphere, with its tip at center
+	 *
+	 * @param forward The normalized direction the arc faces
+	 * @param angle The maximum angle between forward and an object, in degrees
+	 */
+	static SpatialQuery Arc(const NiPoint3& center, const NiPoint3& forward, float minDistance, float maxDistance, float angle);
+
+	static SpatialQuery Box(const NiPoint3& min, const NiPoint3& max);
+
+	/**
+	 * @return Whether or not a position lies within the shape
+	 */
+	bool Contains(const NiPoint3& position) const;
+};
+
+/**
+ * Keeps the positions of the controllable entities of the zone in a grid on the x/z plane, so skills can
+ * find their targets by only looking at the cells around them instead of at every entity in the zone.
+ * Entities are moved between cells as their position changes, and the factions of each entity are kept
+ * as a bitmask next to its position so queries can reject entities of the wrong faction without touching them.
+ */
+class SpatialQueryManager {
+public:
+	static SpatialQueryManager* Instance() {
+		if (!m_Address) {
+			m_Address = new SpatialQueryManager();
+		}
+
+		return m_Address;
+	}
+
+	/**
+	 * Passing this as the faction filter of a query disables faction filtering
+	 */
+	static constexpr uint64_t ANY_FACTION = ~0ULL;
+
+	/**
+	 * Folds a list of factions into a bitmask.  Factions may share a bit, so two masks sharing a bit
+	 * does not mean the lists share a faction, but two masks sharing no bit means they do not.
+	 */
+	static uint64_t GetFactionMask(const std::vector<int32_t>& factions);
+
+	/**
+	 * Starts tracking an entity, taking its factions from its destroyable component if it has one
+	 */
+	void Add(Entity* entity, const NiPoint3& position);
+
+	/**
+	 * Updates the position of a tracked entity, does nothing if the entity is not tracked
+	 */
+	void Move(LWOOBJID id, const NiPoint3& position);
+
+	/**
+	 * Updates the factions of a tracked entity, does nothing if the entity is not tracked
+	 */
+	void SetFactionMask(LWOOBJID id, uint64_t factionMask);
+
+	void Remove(LWOOBJID id);
+
+	/**
+	 * Finds the tracked entities within a shape
+	 *
+	 * @param query The shape to search
+	 * @param factionFilter Only return entities with a faction in this mask, or ANY_FACTION
+	 * @param results Where to add the found entities, in no particular order
+	 */
+	void Query(const SpatialQuery& query, uint64_t factionFilter, std::vector<LWOOBJID>& results) const;
+
+	size_t GetCount() const { return m_Index.size(); }
+
+private:
+	SpatialQueryManager() = default;
+
+	/**
+	 * Size of a cell on the x and z axis, most skills reach less than one cell away
+	 */
+	static constexpr float CELL_SIZE = 32.0f;
+
+	struct Entry {
+		LWOOBJID id = LWOOBJID_EMPTY;
+		NiPoint3 position{};
+		uint64_t factionMask = 0;
+		int64_t cell = 0;
+		uint32_t cellSlot = 0; // Index of this entry in its cell
+	};
+
+	static int32_t GetCellCoordinate(float value);
+	static int64_t GetCellKey(int32_t x, int32_t z);
+
+	void AddToCell(uint32_t entryIndex);
+	void RemoveFromCell(uint32_t entryIndex);
+
+	/**
+	 * Tests the entries of a cell against a query
+	 */
+	void QueryCell(const std::vector<uint32_t>& cell, const SpatialQuery& query, uint64_t factionFilter, std::vector<LWOOBJID>& results) const;
+
+	static SpatialQueryManager* m_Address;
+
+	std::vector<Entry> m_Entries;
+	std::vector<uint32_t> m_FreeEntries;
+	std::unordered_map<LWOOBJID, uint32_t> m_Index;
+
+	// Entry indices per cell, cells are removed once empty
+	std::unordered_map<int64_t, std::vector<uint32_t>> m_Cells;
+};
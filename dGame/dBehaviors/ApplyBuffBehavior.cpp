@@ -35,14 +35,14 @@ void ApplyBuffBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* b
 }
 
 void ApplyBuffBehavior::Load() {
-	m_BuffId = GetInt("buff_id");
-	m_Duration = GetFloat("duration_secs");
-	addImmunity = GetBoolean("add_immunity");
-	cancelOnDamaged = GetBoolean("cancel_on_damaged");
-	cancelOnDeath = GetBoolean("cancel_on_death");
-	cancelOnLogout = GetBoolean("cancel_on_logout");
-	cancelonRemoveBuff = GetBoolean("cancel_on_remove_buff");
-	cancelOnUi = GetBoolean("cancel_on_ui");
-	cancelOnUnequip = GetBoolean("cancel_on_unequip");
-	cancelOnZone = GetBoolean("cancel_on_zone");
+	m_BuffId = GetInt(eBehaviorParameter::BUFF_ID);
+	m_Duration = GetFloat(eBehaviorParameter::DURATION_SECS);
+	addImmunity = GetBoolean(eBehaviorParameter::ADD_IMMUNITY);
+	cancelOnDamaged = GetBoolean(eBehaviorParameter::CANCEL_ON_DAMAGED);
+	cancelOnDeath = GetBoolean(eBehaviorParameter::CANCEL_ON_DEATH);
+	cancelOnLogout = GetBoolean(eBehaviorParameter::CANCEL_ON_LOGOUT);
+	cancelonRemoveBuff = GetBoolean(eBehaviorParameter::CANCEL_ON_REMOVE_BUFF);
+	cancelOnUi = GetBoolean(eBehaviorParameter::CANCEL_ON_UI);
+	cancelOnUnequip = GetBoolean(eBehaviorParameter::CANCEL_ON_UNEQUIP);
+	cancelOnZone = GetBoolean(eBehaviorParameter::CANCEL_ON_ZONE);
 }
@@ -9,6 +9,7 @@
 #include "BehaviorContext.h"
 #include "RebuildComponent.h"
 #include "DestroyableComponent.h"
+#include "SpatialQueryManager.h"
 #include "Game.h"
 #include "dLogger.h"
 
@@ -74,7 +75,9 @@ void AreaOfEffectBehavior::Calculate(BehaviorContext* context, RakNet::BitStream
 	}
 
 	// Gets all of the valid targets, passing in if should target enemies and friends
-	for (auto validTarget : context->GetValidTargets(m_ignoreFaction, includeFaction, m_TargetSelf == 1, m_targetEnemy == 1, m_targetFriend == 1)) {
+	const auto query = SpatialQuery::Sphere(reference, this->m_radius);
+
+	for (auto validTarget : context->GetValidTargets(query, m_ignoreFaction, includeFaction, m_TargetSelf == 1, m_targetEnemy == 1, m_targetFriend == 1)) {
 		auto* entity = EntityManager::Instance()->GetEntity(validTarget);
 
 		if (entity == nullptr) {
@@ -135,19 +138,19 @@ void AreaOfEffectBehavior::Calculate(BehaviorContext* context, RakNet::BitStream
 }
 
 void AreaOfEffectBehavior::Load() {
-	this->m_action = GetAction("action");
+	this->m_action = GetAction(eBehaviorParameter::ACTION);
 
-	this->m_radius = GetFloat("radius");
+	this->m_radius = GetFloat(eBehaviorParameter::RADIUS);
 
-	this->m_maxTargets = GetInt("max targets");
+	this->m_maxTargets = GetInt(eBehaviorParameter::MAX_TARGETS);
 
-	this->m_ignoreFaction = GetInt("ignore_faction");
+	this->m_ignoreFaction = GetInt(eBehaviorParameter::IGNORE_FACTION);
 
-	this->m_includeFaction = GetInt("include_faction");
+	this->m_includeFaction = GetInt(eBehaviorParameter::INCLUDE_FACTION);
 
-	this->m_TargetSelf = GetInt("target_self");
+	this->m_TargetSelf = GetInt(eBehaviorParameter::TARGET_SELF);
 
-	this->m_targetEnemy = GetInt("target_enemy");
+	this->m_targetEnemy = GetInt(eBehaviorParameter::TARGET_ENEMY);
 
-	this->m_targetFriend = GetInt("target_friend");
+	this->m_targetFriend = GetInt(eBehaviorParameter::TARGET_FRIEND);
 }
@@ -42,13 +42,13 @@ void AttackDelayBehavior::SyncCalculation(BehaviorContext* context, RakNet::BitS
 }
 
 void AttackDelayBehavior::Load() {
-	this->m_numIntervals = GetInt("num_intervals");
+	this->m_numIntervals = GetInt(eBehaviorParameter::NUM_INTERVALS);
 
-	this->m_action = GetAction("action");
+	this->m_action = GetAction(eBehaviorParameter::ACTION);
 
-	this->m_delay = GetFloat("delay");
+	this->m_delay = GetFloat(eBehaviorParameter::DELAY);
 
-	this->m_ignoreInterrupts = GetBoolean("ignore_interrupts");
+	this->m_ignoreInterrupts = GetBoolean(eBehaviorParameter::IGNORE_INTERRUPTS);
 
 	if (this->m_numIntervals == 0) {
 		this->m_numIntervals = 1;
@@ -236,20 +236,20 @@ void BasicAttackBehavior::DoBehaviorCalculation(BehaviorContext* context, RakNet
 }
 
 void BasicAttackBehavior::Load() {
-	this->m_MinDamage = GetInt("min damage");
+	this->m_MinDamage = GetInt(eBehaviorParameter::MIN_DAMAGE);
 	if (this->m_MinDamage == 0) this->m_MinDamage = 1;
 
-	this->m_MaxDamage = GetInt("max damage");
+	this->m_MaxDamage = GetInt(eBehaviorParameter::MAX_DAMAGE);
 	if (this->m_MaxDamage == 0) this->m_MaxDamage = 1;
 
 	// The client sets the minimum damage to maximum, so we'll do the same.  These are usually the same value anyways.
 	if (this->m_MinDamage < this->m_MaxDamage) this->m_MinDamage = this->m_MaxDamage;
 
-	this->m_OnSuccess = GetAction("on_success");
+	this->m_OnSuccess = GetAction(eBehaviorParameter::ON_SUCCESS);
 
-	this->m_OnFailArmor = GetAction("on_fail_armor");
+	this->m_OnFailArmor = GetAction(eBehaviorParameter::ON_FAIL_ARMOR);
 
-	this->m_OnFailImmune = GetAction("on_fail_immune");
+	this->m_OnFailImmune = GetAction(eBehaviorParameter::ON_FAIL_IMMUNE);
 
-	this->m_OnFailBlocked = GetAction("on_fail_blocked");
+	this->m_OnFailBlocked = GetAction(eBehaviorParameter::ON_FAIL_BLOCKED);
 }
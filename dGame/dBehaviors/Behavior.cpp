@@ -1,5 +1,7 @@
 #include <sstream>
 #include <algorithm>
+#include <chrono>
+#include <unordered_set>
 
 #include "Behavior.h"
 #include "CDActivitiesTable.h"
@@ -66,6 +68,8 @@
 
  //CDClient includes
 #include "CDBehaviorParameterTable.h"
+#include "CDObjectSkillsTable.h"
+#include "CDSkillBehaviorTable.h"
 #include "CDClientDatabase.h"
 #include "CDClientManager.h"
 
@@ -73,6 +77,8 @@
 #include "EntityManager.h"
 #include "RenderComponent.h"
 #include "DestroyableComponent.h"
+#include "dZoneManager.h"
+#include "eReplicaComponentType.h"
 
 std::unordered_map<uint32_t, Behavior*> Behavior::Cache = {};
 CDBehaviorParameterTable* Behavior::BehaviorParameterTable = nullptr;
@@ -289,6 +295,58 @@ Behavior* Behavior::CreateBehavior(const uint32_t behaviorId) {
 	return behavior;
 }
 
+void Behavior::Precompile(const bool zoneSkillsOnly) {
+	const auto start = std::chrono::steady_clock::now();
+
+	if (BehaviorParameterTable == nullptr) {
+		BehaviorParameterTable = CDClientManager::Instance()->GetTable<CDBehaviorParameterTable>("BehaviorParameter");
+	}
+
+	auto* skillBehaviorTable = CDClientManager::Instance()->GetTable<CDSkillBehaviorTable>("SkillBehavior");
+
+	std::vector<CDSkillBehavior> skills;
+	if (zoneSkillsOnly) {
+		// Objects that can cast skills, and whatever the spawners may spawn later
+		std::unordered_set<LOT> lots;
+		for (auto* entity : EntityManager::Instance()->GetEntitiesByComponent(eReplicaComponentType::SKILL)) {
+			lots.insert(entity->GetLOT());
+		}
+
+		for (const auto& [spawnerId, spawner] : dZoneManager::Instance()->GetSpawners()) {
+			lots.insert(spawner->m_Info.templateID);
+		}
+
+		auto* objectSkillsTable = CDClientManager::Instance()->GetTable<CDObjectSkillsTable>("ObjectSkills");
+		const auto objectSkills = objectSkillsTable->Query([&lots](const CDObjectSkills& entry) {
+			return lots.find(entry.objectTemplate) != lots.end();
+		});
+
+		for (const auto& objectSkill : objectSkills) {
+			skills.push_back(skillBehaviorTable->GetSkillByID(objectSkill.skillID));
+		}
+	} else {
+		for (const auto& [skillId, skill] : skillBehaviorTable->GetEntries()) {
+			skills.push_back(skill);
+		}
+	}
+
+	std::vector<uint32_t> roots;
+	std::unordered_set<uint32_t> uniqueRoots;
+	for (const auto& skill : skills) {
+		if (skill.behaviorID != 0 && uniqueRoots.insert(skill.behaviorID).second) roots.push_back(skill.behaviorID);
+	}
+
+	const auto cachedBefore = Cache.size();
+
+	for (const auto behaviorId : roots) {
+		CreateBehavior(behaviorId);
+	}
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+	Game::logger->Log("Behavior", "Precompiled %llu behaviors for %llu skills in %lli ms", (unsigned long long)(Cache.size() - cachedBefore), (unsigned long long)roots.size(), (long long)elapsed);
+}
+
 BehaviorTemplates Behavior::GetBehaviorTemplate(const uint32_t behaviorId) {
 	auto behaviorTemplateTable = CDClientManager::Instance()->GetTable<CDBehaviorTemplateTable>("BehaviorTemplate");
 
@@ -439,6 +497,27 @@ Behavior::Behavior(const uint32_t behaviorId) {
 }
 
 
+float Behavior::GetFloat(const eBehaviorParameter parameter, const float defaultValue) const {
+	if (!BehaviorParameterTable) BehaviorParameterTable = CDClientManager::Instance()->GetTable<CDBehaviorParameterTable>("BehaviorParameter");
+	return BehaviorParameterTable->GetValue(this->m_behaviorId, parameter, defaultValue);
+}
+
+
+bool Behavior::GetBoolean(const eBehaviorParameter parameter, const bool defaultValue) const {
+	return GetFloat(parameter, defaultValue) > 0;
+}
+
+
+int32_t Behavior::GetInt(const eBehaviorParameter parameter, const int defaultValue) const {
+	return static_cast<int32_t>(GetFloat(parameter, defaultValue));
+}
+
+
+Behavior* Behavior::GetAction(const eBehaviorParameter parameter) const {
+	return CreateBehavior(GetInt(parameter));
+}
+
+
 float Behavior::GetFloat(const std::string& name, const float defaultValue) const {
 	// Get the behavior parameter entry and return its value.
 	if (!BehaviorParameterTable) BehaviorParameterTable = CDClientManager::Instance()->GetTable<CDBehaviorParameterTable>("BehaviorParameter");
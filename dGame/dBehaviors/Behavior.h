@@ -8,6 +8,7 @@
 #include "BitStream.h"
 #include "BehaviorTemplates.h"
 #include "dCommonVars.h"
+#include "eBehaviorParameter.h"
 
 struct BehaviorContext;
 struct BehaviorBranchContext;
@@ -28,6 +29,14 @@ public:
 
 	static BehaviorTemplates GetBehaviorTemplate(uint32_t behaviorId);
 
+	/**
+	 * Builds the behaviors of skills ahead of time, so the first cast of a skill does not have to.
+	 * The behaviors stay in the cache for the lifetime of the server.
+	 *
+	 * @param zoneSkillsOnly Only build the skills of objects currently in the zone
+	 */
+	static void Precompile(bool zoneSkillsOnly);
+
 	/*
 	 * Utilities
 	 */
@@ -49,6 +58,16 @@ public:
 	 * Behavior parameters
 	 */
 
+	float GetFloat(eBehaviorParameter parameter, const float defaultValue = 0) const;
+
+	bool GetBoolean(eBehaviorParameter parameter, const bool defaultValue = false) const;
+
+	int32_t GetInt(eBehaviorParameter parameter, const int32_t defaultValue = 0) const;
+
+	Behavior* GetAction(eBehaviorParameter parameter) const;
+
+	// By name, for parameters whose names are only known at runtime
+
 	float GetFloat(const std::string& name, const float defaultValue = 0) const;
 
 	bool GetBoolean(const std::string& name, const bool defaultValue = false) const;
@@ -9,6 +9,7 @@
 #include "PacketUtils.h"
 
 #include <sstream>
+#include <algorithm>
 
 #include "dMessageIdentifiers.h"
 #include "DestroyableComponent.h"
@@ -16,6 +17,7 @@
 #include "PhantomPhysicsComponent.h"
 #include "RebuildComponent.h"
 #include "eReplicaComponentType.h"
+#include "SpatialQueryManager.h"
 
 BehaviorSyncEntry::BehaviorSyncEntry() {
 }
@@ -157,17 +159,12 @@ void BehaviorContext::Update(const float deltaTime) {
 		entry.behavior->Timer(this, entry.branchContext, entry.second);
 	}
 
-	std::vector<BehaviorTimerEntry> valid;
+	// Drop the timers that went off, in place
+	const auto expired = std::remove_if(this->timerEntries.begin(), this->timerEntries.end(), [](const BehaviorTimerEntry& entry) {
+		return entry.time <= 0;
+	});
 
-	for (const auto& entry : this->timerEntries) {
-		if (entry.time <= 0) {
-			continue;
-		}
-
-		valid.push_back(entry);
-	}
-
-	this->timerEntries = valid;
+	this->timerEntries.erase(expired, this->timerEntries.end());
 }
 
 
@@ -184,19 +181,23 @@ void BehaviorContext::SyncCalculation(const uint32_t syncId, const float time, B
 }
 
 void BehaviorContext::InvokeEnd(const uint32_t id) {
-	std::vector<BehaviorEndEntry> entries;
+	// Take the entries out before ending them, ending a behavior may register new ones
+	SmallVector<BehaviorEndEntry, 2> ended;
 
-	for (const auto& entry : this->endEntries) {
+	auto kept = this->endEntries.begin();
+	for (auto& entry : this->endEntries) {
 		if (entry.start == id) {
-			entry.behavior->End(this, entry.branchContext, entry.second);
-
-			continue;
+			ended.push_back(entry);
+		} else {
+			*kept++ = entry;
 		}
-
-		entries.push_back(entry);
 	}
 
-	this->endEntries = entries;
+	this->endEntries.erase(kept, this->endEntries.end());
+
+	for (const auto& entry : ended) {
+		entry.behavior->End(this, entry.branchContext, entry.second);
+	}
 }
 
 bool BehaviorContext::CalculateUpdate(const float deltaTime) {
@@ -247,31 +248,21 @@ bool BehaviorContext::CalculateUpdate(const float deltaTime) {
 		delete bitStream;
 	}
 
-	std::vector<BehaviorSyncEntry> valid;
-
-	for (const auto& entry : this->syncEntries) {
-		if (entry.time <= 0) {
-			continue;
-		}
-
-		valid.push_back(entry);
-	}
+	const auto finished = std::remove_if(this->syncEntries.begin(), this->syncEntries.end(), [](const BehaviorSyncEntry& entry) {
+		return entry.time <= 0;
+	});
 
-	this->syncEntries = valid;
+	this->syncEntries.erase(finished, this->syncEntries.end());
 
 	return any;
 }
 
 void BehaviorContext::Interrupt() {
-	std::vector<BehaviorSyncEntry> keptSync{};
+	const auto interrupted = std::remove_if(this->syncEntries.begin(), this->syncEntries.end(), [](const BehaviorSyncEntry& entry) {
+		return !entry.ignoreInterrupts;
+	});
 
-	for (const auto& entry : this->syncEntries) {
-		if (!entry.ignoreInterrupts) continue;
-
-		keptSync.push_back(entry);
-	}
-
-	this->syncEntries = keptSync;
+	this->syncEntries.erase(interrupted, this->syncEntries.end());
 }
 
 void BehaviorContext::Reset() {
@@ -290,6 +281,10 @@ void BehaviorContext::Reset() {
 }
 
 std::vector<LWOOBJID> BehaviorContext::GetValidTargets(int32_t ignoreFaction, int32_t includeFaction, bool targetSelf, bool targetEnemy, bool targetFriend) const {
+	return GetValidTargets(SpatialQuery::All(), ignoreFaction, includeFaction, targetSelf, targetEnemy, targetFriend);
+}
+
+std::vector<LWOOBJID> BehaviorContext::GetValidTargets(const SpatialQuery& query, int32_t ignoreFaction, int32_t includeFaction, bool targetSelf, bool targetEnemy, bool targetFriend) const {
 	auto* entity = EntityManager::Instance()->GetEntity(this->caster);
 
 	std::vector<LWOOBJID> targets;
@@ -318,11 +313,19 @@ std::vector<LWOOBJID> BehaviorContext::GetValidTargets(int32_t ignoreFaction, in
 			return targets;
 		}
 
-		auto entities = EntityManager::Instance()->GetEntitiesByComponent(eReplicaComponentType::CONTROLLABLE_PHYSICS);
-		for (auto* candidate : entities) {
-			const auto id = candidate->GetObjectID();
+		const auto ignoreFactions = ignoreFaction || includeFaction;
 
-			if ((id != entity->GetObjectID() || targetSelf) && destroyableComponent->CheckValidity(id, ignoreFaction || includeFaction, targetEnemy, targetFriend)) {
+		// Only enemies share a faction with our enemy factions, friends are everyone else
+		auto factionFilter = SpatialQueryManager::ANY_FACTION;
+		if (!ignoreFactions && !targetFriend) {
+			factionFilter = targetEnemy ? SpatialQueryManager::GetFactionMask(destroyableComponent->GetEnemyFactionsIDs()) : 0;
+		}
+
+		std::vector<LWOOBJID> candidates;
+		SpatialQueryManager::Instance()->Query(query, factionFilter, candidates);
+
+		for (const auto id : candidates) {
+			if ((id != entity->GetObjectID() || targetSelf) && destroyableComponent->CheckValidity(id, ignoreFactions, targetEnemy, targetFriend)) {
 				targets.push_back(id);
 			}
 		}
@@ -332,10 +335,21 @@ std::vector<LWOOBJID> BehaviorContext::GetValidTargets(int32_t ignoreFaction, in
 }
 
 
-BehaviorContext::BehaviorContext(const LWOOBJID originator, const bool calculation) {
+void BehaviorContext::Initialize(const LWOOBJID originator, const bool calculation) {
 	this->originator = originator;
-	this->syncEntries = {};
-	this->timerEntries = {};
+	this->foundTarget = false;
+	this->skillTime = 0;
+	this->skillID = 0;
+	this->failed = false;
+	this->clientInitalized = false;
+	this->unmanaged = false;
+	this->caster = LWOOBJID_EMPTY;
+	this->nextFree = nullptr;
+
+	this->syncEntries.clear();
+	this->timerEntries.clear();
+	this->endEntries.clear();
+	this->scheduledUpdates.clear();
 
 	if (calculation) {
 		this->skillUId = GetUniqueSkillId();
@@ -344,6 +358,10 @@ BehaviorContext::BehaviorContext(const LWOOBJID originator, const bool calculati
 	}
 }
 
+BehaviorContext::BehaviorContext(const LWOOBJID originator, const bool calculation) {
+	Initialize(originator, calculation);
+}
+
 BehaviorContext::~BehaviorContext() {
 	Reset();
 }
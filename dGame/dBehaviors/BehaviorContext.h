@@ -4,10 +4,12 @@
 #include "dCommonVars.h"
 #include "BehaviorBranchContext.h"
 #include "GameMessages.h"
+#include "SmallVector.h"
 
 #include <vector>
 
 class Behavior;
+struct SpatialQuery;
 
 struct BehaviorSyncEntry
 {
@@ -66,13 +68,14 @@ struct BehaviorContext
 
 	bool clientInitalized = false;
 
-	std::vector<BehaviorSyncEntry> syncEntries;
+	// Most skills only ever have a handful of pending entries, so these rarely allocate
+	SmallVector<BehaviorSyncEntry, 4> syncEntries;
 
-	std::vector<BehaviorTimerEntry> timerEntries;
+	SmallVector<BehaviorTimerEntry, 4> timerEntries;
 
-	std::vector<BehaviorEndEntry> endEntries;
+	SmallVector<BehaviorEndEntry, 2> endEntries;
 
-	std::vector<LWOOBJID> scheduledUpdates;
+	SmallVector<LWOOBJID, 4> scheduledUpdates;
 
 	bool unmanaged = false;
 
@@ -106,6 +109,25 @@ struct BehaviorContext
 
 	std::vector<LWOOBJID> GetValidTargets(int32_t ignoreFaction = 0, int32_t includeFaction = 0, const bool targetSelf = false, const bool targetEnemy = true, const bool targetFriend = false) const;
 
+	/**
+	 * Gets the valid targets of the caster, only searching the zone within a shape when the caster has no
+	 * phantom to pick targets from.  Targets from the phantom are not limited to the shape.
+	 */
+	std::vector<LWOOBJID> GetValidTargets(const SpatialQuery& query, int32_t ignoreFaction = 0, int32_t includeFaction = 0, const bool targetSelf = false, const bool targetEnemy = true, const bool targetFriend = false) const;
+
+	/**
+	 * Prepares the context for a new skill, clearing everything left over from a previous one
+	 *
+	 * @param originator The object that started the skill
+	 * @param calculation Whether the server calculates the skill, which gives it a unique skill id
+	 */
+	void Initialize(LWOOBJID originator, bool calculation = false);
+
+	/**
+	 * Next free context in the BehaviorContextPool, only set while this context is not in use
+	 */
+	BehaviorContext* nextFree = nullptr;
+
 	explicit BehaviorContext(LWOOBJID originator, bool calculation = false);
 
 	~BehaviorContext();
@@ -0,0 +1,59 @@
+#include "BehaviorContextPool.h"
+
+#include "BehaviorContext.h"
+#include "Metrics.hpp"
+
+BehaviorContextPool* BehaviorContextPool::m_Address = nullptr;
+
+BehaviorContext* BehaviorContextPool::Acquire(const LWOOBJID originator, const bool calculation) {
+	BehaviorContext* context;
+
+	if (m_FreeList != nullptr) {
+		context = m_FreeList;
+		m_FreeList = context->nextFree;
+
+		context->Initialize(originator, calculation);
+
+		m_Reuses++;
+	} else {
+		context = new BehaviorContext(originator, calculation);
+
+		m_Contexts.push_back(context);
+	}
+
+	m_InUse++;
+	if (m_InUse > m_PeakInUse) m_PeakInUse = m_InUse;
+
+	UpdateMetrics();
+
+	return context;
+}
+
+void BehaviorContextPool::Release(BehaviorContext* context) {
+	if (context == nullptr) return;
+
+	context->Reset();
+
+	context->nextFree = m_FreeList;
+	m_FreeList = context;
+
+	m_InUse--;
+
+	UpdateMetrics();
+}
+
+void BehaviorContextPool::UpdateMetrics() const {
+	Metrics::SetCounter(MetricCounter::BehaviorContextsAllocated, m_Contexts.size());
+	Metrics::SetCounter(MetricCounter::BehaviorContextsInUse, m_InUse);
+	Metrics::SetCounter(MetricCounter::BehaviorContextsPeak, m_PeakInUse);
+	Metrics::SetCounter(MetricCounter::BehaviorContextsReused, m_Reuses);
+}
+
+BehaviorContextPool::~BehaviorContextPool() {
+	for (auto* context : m_Contexts) {
+		delete context;
+	}
+
+	m_Contexts.clear();
+	m_FreeList = nullptr;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "dCommonVars.h"
+
+struct BehaviorContext;
+
+/**
+ * Recycles the behavior contexts of the zone, so casting a skill does not allocate a context and its
+ * entry lists every time.  Free contexts are linked through BehaviorContext::nextFree and keep the
+ * storage of their entry lists, and are only freed when the pool is destroyed.
+ */
+class BehaviorContextPool {
+public:
+	static BehaviorContextPool* Instance() {
+		if (!m_Address) {
+			m_Address = new BehaviorContextPool();
+		}
+
+		return m_Address;
+	}
+
+	~BehaviorContextPool();
+
+	/**
+	 * Gets a context ready for a new skill, reusing a free one if there is any
+	 *
+	 * @param originator The object that started the skill
+	 * @param calculation Whether the server calculates the skill
+	 * @return The context, to be given back with Release
+	 */
+	BehaviorContext* Acquire(LWOOBJID originator, bool calculation = false);
+
+	/**
+	 * Resets a context, which ends its pending timers and end behaviors, and returns it to the pool
+	 *
+	 * @param context The context to release, may be nullptr
+	 */
+	void Release(BehaviorContext* context);
+
+	size_t GetAllocatedCount() const { return m_Contexts.size(); }
+	size_t GetInUseCount() const { return m_InUse; }
+	size_t GetPeakInUseCount() const { return m_PeakInUse; }
+	uint64_t GetReuseCount() const { return m_Reuses; }
+
+private:
+	BehaviorContextPool() = default;
+
+	void UpdateMetrics() const;
+
+	static BehaviorContextPool* m_Address;
+
+	// Every context the pool has created, in use or not
+	std::vector<BehaviorContext*> m_Contexts;
+
+	BehaviorContext* m_FreeList = nullptr;
+
+	size_t m_InUse = 0;
+	size_t m_PeakInUse = 0;
+	uint64_t m_Reuses = 0;
+};
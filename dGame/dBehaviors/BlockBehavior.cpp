@@ -68,5 +68,5 @@ void BlockBehavior::End(BehaviorContext* context, BehaviorBranchContext branch,
 }
 
 void BlockBehavior::Load() {
-	this->m_numAttacksCanBlock = GetInt("num_attacks_can_block");
+	this->m_numAttacksCanBlock = GetInt(eBehaviorParameter::NUM_ATTACKS_CAN_BLOCK);
 }
@@ -76,9 +76,9 @@ void BuffBehavior::End(BehaviorContext* context, const BehaviorBranchContext bra
 }
 
 void BuffBehavior::Load() {
-	this->m_health = GetInt("life");
+	this->m_health = GetInt(eBehaviorParameter::LIFE);
 
-	this->m_armor = GetInt("armor");
+	this->m_armor = GetInt(eBehaviorParameter::ARMOR);
 
-	this->m_imagination = GetInt("imag");
+	this->m_imagination = GetInt(eBehaviorParameter::IMAG);
 }
@@ -42,7 +42,7 @@ void CarBoostBehavior::Handle(BehaviorContext* context, RakNet::BitStream* bitSt
 }
 
 void CarBoostBehavior::Load() {
-	m_Action = GetAction("action");
+	m_Action = GetAction(eBehaviorParameter::ACTION);
 
-	m_Time = GetFloat("time");
+	m_Time = GetFloat(eBehaviorParameter::TIME);
 }
@@ -39,6 +39,6 @@ void ChangeOrientationBehavior::Calculate(BehaviorContext* context, RakNet::BitS
 }
 
 void ChangeOrientationBehavior::Load() {
-	m_OrientCaster = GetBoolean("orient_caster");
-	m_ToTarget = GetBoolean("to_target");
+	m_OrientCaster = GetBoolean(eBehaviorParameter::ORIENT_CASTER);
+	m_ToTarget = GetBoolean(eBehaviorParameter::TO_TARGET);
 }
@@ -23,5 +23,5 @@ void ChargeUpBehavior::Sync(BehaviorContext* context, RakNet::BitStream* bitStre
 }
 
 void ChargeUpBehavior::Load() {
-	this->m_action = GetAction("action");
+	this->m_action = GetAction(eBehaviorParameter::ACTION);
 }
@@ -16,7 +16,7 @@ void ClearTargetBehavior::Calculate(BehaviorContext* context, RakNet::BitStream*
 }
 
 void ClearTargetBehavior::Load() {
-	this->m_action = GetAction("action");
+	this->m_action = GetAction(eBehaviorParameter::ACTION);
 
-	this->m_clearIfCaster = GetBoolean("clear_if_caster");
+	this->m_clearIfCaster = GetBoolean(eBehaviorParameter::CLEAR_IF_CASTER);
 }
@@ -56,5 +56,5 @@ void DamageAbsorptionBehavior::Timer(BehaviorContext* context, BehaviorBranchCon
 }
 
 void DamageAbsorptionBehavior::Load() {
-	this->m_absorbAmount = GetInt("absorb_amount");
+	this->m_absorbAmount = GetInt(eBehaviorParameter::ABSORB_AMOUNT);
 }
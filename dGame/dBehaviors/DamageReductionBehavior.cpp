@@ -50,5 +50,5 @@ void DamageReductionBehavior::Timer(BehaviorContext* context, BehaviorBranchCont
 }
 
 void DamageReductionBehavior::Load() {
-	this->m_ReductionAmount = GetInt("reduction_amount");
+	this->m_ReductionAmount = GetInt(eBehaviorParameter::REDUCTION_AMOUNT);
 }
@@ -46,7 +46,7 @@ void DarkInspirationBehavior::Calculate(BehaviorContext* context, RakNet::BitStr
 }
 
 void DarkInspirationBehavior::Load() {
-	this->m_ActionIfFactionMatches = GetAction("action");
+	this->m_ActionIfFactionMatches = GetAction(eBehaviorParameter::ACTION);
 
-	this->m_FactionList = GetInt("faction_list");
+	this->m_FactionList = GetInt(eBehaviorParameter::FACTION_LIST);
 }
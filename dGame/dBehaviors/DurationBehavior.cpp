@@ -15,7 +15,7 @@ void DurationBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bi
 }
 
 void DurationBehavior::Load() {
-	this->m_duration = GetFloat("duration");
+	this->m_duration = GetFloat(eBehaviorParameter::DURATION);
 
-	this->m_action = GetAction("action");
+	this->m_action = GetAction(eBehaviorParameter::ACTION);
 }
@@ -12,5 +12,5 @@ void EndBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bitStre
 }
 
 void EndBehavior::Load() {
-	this->m_startBehavior = GetInt("start_action");
+	this->m_startBehavior = GetInt(eBehaviorParameter::START_ACTION);
 }
@@ -62,13 +62,13 @@ void ForceMovementBehavior::Calculate(BehaviorContext* context, RakNet::BitStrea
 }
 
 void ForceMovementBehavior::Load() {
-	this->m_hitAction = GetAction("hit_action");
-	this->m_hitEnemyAction = GetAction("hit_action_enemy");
-	this->m_hitFactionAction = GetAction("hit_action_faction");
-	this->m_Duration = GetFloat("duration");
-	this->m_Forward = GetFloat("forward");
-	this->m_Left = GetFloat("left");
-	this->m_Yaw = GetFloat("yaw");
+	this->m_hitAction = GetAction(eBehaviorParameter::HIT_ACTION);
+	this->m_hitEnemyAction = GetAction(eBehaviorParameter::HIT_ACTION_ENEMY);
+	this->m_hitFactionAction = GetAction(eBehaviorParameter::HIT_ACTION_FACTION);
+	this->m_Duration = GetFloat(eBehaviorParameter::DURATION);
+	this->m_Forward = GetFloat(eBehaviorParameter::FORWARD);
+	this->m_Left = GetFloat(eBehaviorParameter::LEFT);
+	this->m_Yaw = GetFloat(eBehaviorParameter::YAW);
 }
 
 void ForceMovementBehavior::SyncCalculation(BehaviorContext* context, RakNet::BitStream* bitStream, BehaviorBranchContext branch) {
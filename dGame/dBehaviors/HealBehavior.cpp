@@ -34,5 +34,5 @@ void HealBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bit_st
 
 
 void HealBehavior::Load() {
-	this->m_health = GetInt("health");
+	this->m_health = GetInt(eBehaviorParameter::HEALTH);
 }
@@ -28,5 +28,5 @@ void ImaginationBehavior::Calculate(BehaviorContext* context, RakNet::BitStream*
 }
 
 void ImaginationBehavior::Load() {
-	this->m_imagination = GetInt("imagination");
+	this->m_imagination = GetInt(eBehaviorParameter::IMAGINATION);
 }
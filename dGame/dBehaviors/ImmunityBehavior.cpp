@@ -97,20 +97,20 @@ void ImmunityBehavior::Timer(BehaviorContext* context, BehaviorBranchContext bra
 
 void ImmunityBehavior::Load() {
 	//Stun
-	this->m_ImmuneToStunAttack = GetBoolean("immune_stun_attack", false);
-	this->m_ImmuneToStunEquip = GetBoolean("immune_stun_equip", false);
-	this->m_ImmuneToStunInteract = GetBoolean("immune_stun_interact", false);
-	this->m_ImmuneToStunMove = GetBoolean("immune_stun_move", false);
-	this->m_ImmuneToStunTurn = GetBoolean("immune_stun_rotate", false);
+	this->m_ImmuneToStunAttack = GetBoolean(eBehaviorParameter::IMMUNE_STUN_ATTACK, false);
+	this->m_ImmuneToStunEquip = GetBoolean(eBehaviorParameter::IMMUNE_STUN_EQUIP, false);
+	this->m_ImmuneToStunInteract = GetBoolean(eBehaviorParameter::IMMUNE_STUN_INTERACT, false);
+	this->m_ImmuneToStunMove = GetBoolean(eBehaviorParameter::IMMUNE_STUN_MOVE, false);
+	this->m_ImmuneToStunTurn = GetBoolean(eBehaviorParameter::IMMUNE_STUN_ROTATE, false);
 
 	// Status
-	this->m_ImmuneToBasicAttack = GetBoolean("immune_basic_attack", false);
-	this->m_ImmuneToDamageOverTime = GetBoolean("immune_damage_over_time", false);
-	this->m_ImmuneToKnockback = GetBoolean("immune_knockback", false);
-	this->m_ImmuneToInterrupt = GetBoolean("immune_interrupt", false);
-	this->m_ImmuneToSpeed = GetBoolean("immune_speed", false);
-	this->m_ImmuneToImaginationGain = GetBoolean("immune_imagination_gain", false);
-	this->m_ImmuneToImaginationLoss = GetBoolean("immune_imagination_loss", false);
-	this->m_ImmuneToQuickbuildInterrupt = GetBoolean("immune_quickbuild_interrupts", false);
-	this->m_ImmuneToPullToPoint = GetBoolean("immune_pulltopoint", false);
+	this->m_ImmuneToBasicAttack = GetBoolean(eBehaviorParameter::IMMUNE_BASIC_ATTACK, false);
+	this->m_ImmuneToDamageOverTime = GetBoolean(eBehaviorParameter::IMMUNE_DAMAGE_OVER_TIME, false);
+	this->m_ImmuneToKnockback = GetBoolean(eBehaviorParameter::IMMUNE_KNOCKBACK, false);
+	this->m_ImmuneToInterrupt = GetBoolean(eBehaviorParameter::IMMUNE_INTERRUPT, false);
+	this->m_ImmuneToSpeed = GetBoolean(eBehaviorParameter::IMMUNE_SPEED, false);
+	this->m_ImmuneToImaginationGain = GetBoolean(eBehaviorParameter::IMMUNE_IMAGINATION_GAIN, false);
+	this->m_ImmuneToImaginationLoss = GetBoolean(eBehaviorParameter::IMMUNE_IMAGINATION_LOSS, false);
+	this->m_ImmuneToQuickbuildInterrupt = GetBoolean(eBehaviorParameter::IMMUNE_QUICKBUILD_INTERRUPTS, false);
+	this->m_ImmuneToPullToPoint = GetBoolean(eBehaviorParameter::IMMUNE_PULLTOPOINT, false);
 }
@@ -80,7 +80,7 @@ void InterruptBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* b
 
 
 void InterruptBehavior::Load() {
-	this->m_target = GetBoolean("target");
+	this->m_target = GetBoolean(eBehaviorParameter::TARGET);
 
-	this->m_interruptBlock = GetBoolean("interrupt_block");
+	this->m_interruptBlock = GetBoolean(eBehaviorParameter::INTERRUPT_BLOCK);
 }
@@ -38,10 +38,10 @@ void JetPackBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bit
 }
 
 void JetPackBehavior::Load() {
-	this->m_WarningEffectID = GetInt("warning_effect_id");
-	this->m_Airspeed = GetFloat("airspeed");
-	this->m_MaxAirspeed = GetFloat("max_airspeed");
-	this->m_VerticalVelocity = GetFloat("vertical_velocity");
-	this->m_EnableHover = GetBoolean("enable_hover");
-	this->m_BypassChecks = GetBoolean("bypass_checks", true);
+	this->m_WarningEffectID = GetInt(eBehaviorParameter::WARNING_EFFECT_ID);
+	this->m_Airspeed = GetFloat(eBehaviorParameter::AIRSPEED);
+	this->m_MaxAirspeed = GetFloat(eBehaviorParameter::MAX_AIRSPEED);
+	this->m_VerticalVelocity = GetFloat(eBehaviorParameter::VERTICAL_VELOCITY);
+	this->m_EnableHover = GetBoolean(eBehaviorParameter::ENABLE_HOVER);
+	this->m_BypassChecks = GetBoolean(eBehaviorParameter::BYPASS_CHECKS, true);
 }
@@ -35,8 +35,8 @@ void KnockbackBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* b
 }
 
 void KnockbackBehavior::Load() {
-	this->m_strength = GetInt("strength");
-	this->m_angle = GetInt("angle");
-	this->m_relative = GetBoolean("relative");
-	this->m_time = GetInt("time_ms");
+	this->m_strength = GetInt(eBehaviorParameter::STRENGTH);
+	this->m_angle = GetInt(eBehaviorParameter::ANGLE);
+	this->m_relative = GetBoolean(eBehaviorParameter::RELATIVE);
+	this->m_time = GetInt(eBehaviorParameter::TIME_MS);
 }
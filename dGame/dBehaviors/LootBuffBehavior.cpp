@@ -34,5 +34,5 @@ void LootBuffBehavior::Timer(BehaviorContext* context, BehaviorBranchContext bra
 }
 
 void LootBuffBehavior::Load() {
-	this->m_Scale = GetFloat("scale");
+	this->m_Scale = GetFloat(eBehaviorParameter::SCALE);
 }
@@ -44,7 +44,7 @@ void MovementSwitchBehavior::Handle(BehaviorContext* context, RakNet::BitStream*
 	}
 }
 
-Behavior* MovementSwitchBehavior::LoadMovementType(std::string movementType) {
+Behavior* MovementSwitchBehavior::LoadMovementType(eBehaviorParameter movementType) {
 	float actionValue = GetFloat(movementType, -1.0f);
 	auto loadedBehavior = GetAction(actionValue != -1.0f ? actionValue : 0.0f);
 	if (actionValue == -1.0f && loadedBehavior->m_templateId == BehaviorTemplates::BEHAVIOR_EMPTY) {
@@ -54,13 +54,13 @@ Behavior* MovementSwitchBehavior::LoadMovementType(std::string movementType) {
 }
 
 void MovementSwitchBehavior::Load() {
-	float groundActionValue = GetFloat("ground_action", -1.0f);
+	float groundActionValue = GetFloat(eBehaviorParameter::GROUND_ACTION, -1.0f);
 	this->m_groundAction = GetAction(groundActionValue != -1.0f ? groundActionValue : 0.0f);
 
-	this->m_airAction = LoadMovementType("air_action");
-	this->m_doubleJumpAction = LoadMovementType("double_jump_action");
-	this->m_fallingAction = LoadMovementType("falling_action");
-	this->m_jetpackAction = LoadMovementType("jetpack_action");
-	this->m_jumpAction = LoadMovementType("jump_action");
-	this->m_movingAction = LoadMovementType("moving_action");
+	this->m_airAction = LoadMovementType(eBehaviorParameter::AIR_ACTION);
+	this->m_doubleJumpAction = LoadMovementType(eBehaviorParameter::DOUBLE_JUMP_ACTION);
+	this->m_fallingAction = LoadMovementType(eBehaviorParameter::FALLING_ACTION);
+	this->m_jetpackAction = LoadMovementType(eBehaviorParameter::JETPACK_ACTION);
+	this->m_jumpAction = LoadMovementType(eBehaviorParameter::JUMP_ACTION);
+	this->m_movingAction = LoadMovementType(eBehaviorParameter::MOVING_ACTION);
 }
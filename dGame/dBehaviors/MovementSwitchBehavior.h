@@ -27,7 +27,7 @@ private:
 	 * @param movementType The movement type to lookup in the database
 	 * @param behaviorToLoad The Behavior where the result will be stored
 	 */
-	Behavior* LoadMovementType(std::string movementType);
+	Behavior* LoadMovementType(eBehaviorParameter movementType);
 
 public:
 	/*
@@ -12,7 +12,7 @@ void NpcCombatSkillBehavior::Calculate(BehaviorContext* context, RakNet::BitStre
 }
 
 void NpcCombatSkillBehavior::Load() {
-	this->m_npcSkillTime = GetFloat("npc skill time");
+	this->m_npcSkillTime = GetFloat(eBehaviorParameter::NPC_SKILL_TIME);
 
 	const auto parameters = GetParameterNames();
 
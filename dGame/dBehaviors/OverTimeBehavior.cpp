@@ -36,12 +36,12 @@ void OverTimeBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bi
 }
 
 void OverTimeBehavior::Load() {
-	m_Action = GetInt("action");
+	m_Action = GetInt(eBehaviorParameter::ACTION);
 	// Since m_Action is a skillID and not a behavior, get is correlated behaviorID.
 
 	CDSkillBehaviorTable* skillTable = CDClientManager::Instance()->GetTable<CDSkillBehaviorTable>("SkillBehavior");
 	m_ActionBehaviorId = skillTable->GetSkillByID(m_Action).behaviorID;
 
-	m_Delay = GetFloat("delay");
-	m_NumIntervals = GetInt("num_intervals");
+	m_Delay = GetFloat(eBehaviorParameter::DELAY);
+	m_NumIntervals = GetInt(eBehaviorParameter::NUM_INTERVALS);
 }
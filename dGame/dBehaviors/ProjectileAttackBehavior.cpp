@@ -136,27 +136,27 @@ void ProjectileAttackBehavior::Calculate(BehaviorContext* context, RakNet::BitSt
 }
 
 void ProjectileAttackBehavior::Load() {
-	this->m_lot = GetInt("LOT_ID");
+	this->m_lot = GetInt(eBehaviorParameter::LOT_ID);
 
-	this->m_projectileCount = GetInt("spread_count");
+	this->m_projectileCount = GetInt(eBehaviorParameter::SPREAD_COUNT);
 
 	if (this->m_projectileCount == 0) {
 		this->m_projectileCount = 1;
 	}
 
-	this->m_maxDistance = GetFloat("max_distance");
+	this->m_maxDistance = GetFloat(eBehaviorParameter::MAX_DISTANCE);
 
-	this->m_projectileSpeed = GetFloat("projectile_speed");
+	this->m_projectileSpeed = GetFloat(eBehaviorParameter::PROJECTILE_SPEED);
 
-	this->m_spreadAngle = GetFloat("spread_angle");
+	this->m_spreadAngle = GetFloat(eBehaviorParameter::SPREAD_ANGLE);
 
-	this->m_offset = { GetFloat("offset_x"), GetFloat("offset_y"), GetFloat("offset_z") };
+	this->m_offset = { GetFloat(eBehaviorParameter::OFFSET_X), GetFloat(eBehaviorParameter::OFFSET_Y), GetFloat(eBehaviorParameter::OFFSET_Z) };
 
-	this->m_trackTarget = GetBoolean("track_target");
+	this->m_trackTarget = GetBoolean(eBehaviorParameter::TRACK_TARGET);
 
-	this->m_trackRadius = GetFloat("track_radius");
+	this->m_trackRadius = GetFloat(eBehaviorParameter::TRACK_RADIUS);
 
-	this->m_useMouseposit = GetBoolean("use_mouseposit");
+	this->m_useMouseposit = GetBoolean(eBehaviorParameter::USE_MOUSEPOSIT);
 
-	this->m_ProjectileType = GetInt("projectile_type");
+	this->m_ProjectileType = GetInt(eBehaviorParameter::PROJECTILE_TYPE);
 }
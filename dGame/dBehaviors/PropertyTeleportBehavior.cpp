@@ -56,6 +56,6 @@ void PropertyTeleportBehavior::Handle(BehaviorContext* context, RakNet::BitStrea
 }
 
 void PropertyTeleportBehavior::Load() {
-	this->m_CancelIfInteracting = GetBoolean("cancel_if_interacting"); // TODO unused
-	this->m_MapId = LWOMAPID(GetInt("mapID"));
+	this->m_CancelIfInteracting = GetBoolean(eBehaviorParameter::CANCEL_IF_INTERACTING); // TODO unused
+	this->m_MapId = LWOMAPID(GetInt(eBehaviorParameter::MAP_ID));
 }
@@ -16,6 +16,6 @@ void RemoveBuffBehavior::Handle(BehaviorContext* context, RakNet::BitStream* bit
 }
 
 void RemoveBuffBehavior::Load() {
-	this->m_RemoveImmunity = GetBoolean("remove_immunity");
-	this->m_BuffId = GetInt("buff_id");
+	this->m_RemoveImmunity = GetBoolean(eBehaviorParameter::REMOVE_IMMUNITY);
+	this->m_BuffId = GetInt(eBehaviorParameter::BUFF_ID);
 }
@@ -32,5 +32,5 @@ void RepairBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bit_
 }
 
 void RepairBehavior::Load() {
-	this->m_armor = GetInt("armor");
+	this->m_armor = GetInt(eBehaviorParameter::ARMOR);
 }
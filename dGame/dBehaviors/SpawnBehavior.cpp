@@ -104,6 +104,6 @@ void SpawnBehavior::End(BehaviorContext* context, const BehaviorBranchContext br
 
 
 void SpawnBehavior::Load() {
-	this->m_lot = GetInt("LOT_ID");
-	this->m_Distance = GetFloat("distance");
+	this->m_lot = GetInt(eBehaviorParameter::LOT_ID);
+	this->m_Distance = GetFloat(eBehaviorParameter::DISTANCE);
 }
@@ -49,6 +49,6 @@ void SpeedBehavior::End(BehaviorContext* context, BehaviorBranchContext branch,
 }
 
 void SpeedBehavior::Load() {
-	m_RunSpeed = GetFloat("run_speed");
-	m_AffectsCaster = GetBoolean("affects_caster");
+	m_RunSpeed = GetFloat(eBehaviorParameter::RUN_SPEED);
+	m_AffectsCaster = GetBoolean(eBehaviorParameter::AFFECTS_CASTER);
 }
@@ -14,5 +14,5 @@ void StartBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bit_s
 }
 
 void StartBehavior::Load() {
-	this->m_action = GetAction("action");
+	this->m_action = GetAction(eBehaviorParameter::ACTION);
 }
@@ -101,5 +101,5 @@ void StunBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bitStr
 }
 
 void StunBehavior::Load() {
-	this->m_stunCaster = GetBoolean("stun_caster");
+	this->m_stunCaster = GetBoolean(eBehaviorParameter::STUN_CASTER);
 }
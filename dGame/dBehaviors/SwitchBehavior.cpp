@@ -64,13 +64,13 @@ void SwitchBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bitS
 }
 
 void SwitchBehavior::Load() {
-	this->m_actionTrue = GetAction("action_true");
+	this->m_actionTrue = GetAction(eBehaviorParameter::ACTION_TRUE);
 
-	this->m_actionFalse = GetAction("action_false");
+	this->m_actionFalse = GetAction(eBehaviorParameter::ACTION_FALSE);
 
-	this->m_imagination = GetInt("imagination");
+	this->m_imagination = GetInt(eBehaviorParameter::IMAGINATION);
 
-	this->m_isEnemyFaction = GetBoolean("isEnemyFaction");
+	this->m_isEnemyFaction = GetBoolean(eBehaviorParameter::IS_ENEMY_FACTION);
 
-	this->m_targetHasBuff = GetInt("target_has_buff");
+	this->m_targetHasBuff = GetInt(eBehaviorParameter::TARGET_HAS_BUFF);
 }
@@ -8,6 +8,7 @@
 #include "EntityManager.h"
 #include "RebuildComponent.h"
 #include "DestroyableComponent.h"
+#include "SpatialQueryManager.h"
 
 #include <vector>
 
@@ -117,8 +118,11 @@ void TacArcBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bitS
 		}
 	}
 
+	// Only look for targets in the arc in front of the caster, the exact checks are done below
+	const auto query = SpatialQuery::Arc(reference, self->GetRotation().GetForwardVector(), this->m_minDistance, this->m_maxDistance, 2 * this->m_angle);
+
 	// Find all valid targets, based on whether we target enemies or friends
-	for (const auto& contextTarget : context->GetValidTargets()) {
+	for (const auto& contextTarget : context->GetValidTargets(query)) {
 		if (destroyableComponent != nullptr) {
 			const auto* targetEntity = EntityManager::Instance()->GetEntity(contextTarget);
 
@@ -228,43 +232,43 @@ void TacArcBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bitS
 }
 
 void TacArcBehavior::Load() {
-	this->m_usePickedTarget = GetBoolean("use_picked_target");
+	this->m_usePickedTarget = GetBoolean(eBehaviorParameter::USE_PICKED_TARGET);
 
-	this->m_action = GetAction("action");
+	this->m_action = GetAction(eBehaviorParameter::ACTION);
 
-	this->m_missAction = GetAction("miss action");
+	this->m_missAction = GetAction(eBehaviorParameter::MISS_ACTION);
 
-	this->m_checkEnv = GetBoolean("check_env");
+	this->m_checkEnv = GetBoolean(eBehaviorParameter::CHECK_ENV);
 
-	this->m_blockedAction = GetAction("blocked action");
+	this->m_blockedAction = GetAction(eBehaviorParameter::BLOCKED_ACTION);
 
-	this->m_minDistance = GetFloat("min range");
+	this->m_minDistance = GetFloat(eBehaviorParameter::MIN_RANGE);
 
-	this->m_maxDistance = GetFloat("max range");
+	this->m_maxDistance = GetFloat(eBehaviorParameter::MAX_RANGE);
 
-	this->m_maxTargets = GetInt("max targets");
+	this->m_maxTargets = GetInt(eBehaviorParameter::MAX_TARGETS);
 
-	this->m_targetEnemy = GetBoolean("target_enemy");
+	this->m_targetEnemy = GetBoolean(eBehaviorParameter::TARGET_ENEMY);
 
-	this->m_targetFriend = GetBoolean("target_friend");
+	this->m_targetFriend = GetBoolean(eBehaviorParameter::TARGET_FRIEND);
 
-	this->m_targetTeam = GetBoolean("target_team");
+	this->m_targetTeam = GetBoolean(eBehaviorParameter::TARGET_TEAM);
 
-	this->m_angle = GetFloat("angle");
+	this->m_angle = GetFloat(eBehaviorParameter::ANGLE);
 
-	this->m_upperBound = GetFloat("upper_bound");
+	this->m_upperBound = GetFloat(eBehaviorParameter::UPPER_BOUND);
 
-	this->m_lowerBound = GetFloat("lower_bound");
+	this->m_lowerBound = GetFloat(eBehaviorParameter::LOWER_BOUND);
 
-	this->m_farHeight = GetFloat("far_height");
+	this->m_farHeight = GetFloat(eBehaviorParameter::FAR_HEIGHT);
 
-	this->m_farWidth = GetFloat("far_width");
+	this->m_farWidth = GetFloat(eBehaviorParameter::FAR_WIDTH);
 
-	this->m_method = GetInt("method");
+	this->m_method = GetInt(eBehaviorParameter::METHOD);
 
 	this->m_offset = {
-		GetFloat("offset_x"),
-		GetFloat("offset_y"),
-		GetFloat("offset_z")
+		GetFloat(eBehaviorParameter::OFFSET_X),
+		GetFloat(eBehaviorParameter::OFFSET_Y),
+		GetFloat(eBehaviorParameter::OFFSET_Z)
 	};
 }
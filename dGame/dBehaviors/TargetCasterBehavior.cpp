@@ -20,6 +20,6 @@ void TargetCasterBehavior::Calculate(BehaviorContext* context, RakNet::BitStream
 }
 
 void TargetCasterBehavior::Load() {
-	this->m_action = GetAction("action");
+	this->m_action = GetAction(eBehaviorParameter::ACTION);
 }
 
@@ -39,6 +39,6 @@ void TauntBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bitSt
 }
 
 void TauntBehavior::Load() {
-	this->m_threatToAdd = GetFloat("threat to add");
+	this->m_threatToAdd = GetFloat(eBehaviorParameter::THREAT_TO_ADD);
 }
 
@@ -39,9 +39,9 @@ void VentureVisionBehavior::Timer(BehaviorContext* context, BehaviorBranchContex
 }
 
 void VentureVisionBehavior::Load() {
-	this->m_show_pet_digs = GetBoolean("show_pet_digs");
+	this->m_show_pet_digs = GetBoolean(eBehaviorParameter::SHOW_PET_DIGS);
 
-	this->m_show_minibosses = GetBoolean("show_minibosses");
+	this->m_show_minibosses = GetBoolean(eBehaviorParameter::SHOW_MINIBOSSES);
 
-	this->m_show_collectibles = GetBoolean("show_collectibles");
+	this->m_show_collectibles = GetBoolean(eBehaviorParameter::SHOW_COLLECTIBLES);
 }
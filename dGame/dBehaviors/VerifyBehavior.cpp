@@ -50,11 +50,11 @@ void VerifyBehavior::Calculate(BehaviorContext* context, RakNet::BitStream* bitS
 }
 
 void VerifyBehavior::Load() {
-	this->m_rangeCheck = GetBoolean("check_range");
+	this->m_rangeCheck = GetBoolean(eBehaviorParameter::CHECK_RANGE);
 
-	this->m_blockCheck = GetBoolean("check blocking");
+	this->m_blockCheck = GetBoolean(eBehaviorParameter::CHECK_BLOCKING);
 
-	this->m_action = GetAction("action");
+	this->m_action = GetAction(eBehaviorParameter::ACTION);
 
-	this->m_range = GetFloat("range");
+	this->m_range = GetFloat(eBehaviorParameter::RANGE);
 }
@@ -10,6 +10,7 @@
 #include "GameMessages.h"
 #include "dServer.h"
 #include "Game.h"
+#include "dConfig.h"
 
 #include "CDClientDatabase.h"
 #include "CDClientManager.h"
@@ -23,8 +24,10 @@
 #include "RebuildComponent.h"
 #include "DestroyableComponent.h"
 #include "Metrics.hpp"
+#include "Player.h"
+#include "EntityPrefab.h"
 
-BaseCombatAIComponent::BaseCombatAIComponent(Entity* parent, const uint32_t id): Component(parent) {
+BaseCombatAIComponent::BaseCombatAIComponent(Entity* parent, const EntityPrefab& prefab): Component(parent) {
 	m_Target = LWOOBJID_EMPTY;
 	SetAiState(AiState::spawn);
 	m_Timer = 1.0f;
@@ -34,32 +37,17 @@ BaseCombatAIComponent::BaseCombatAIComponent(Entity* parent, const uint32_t id):
 	m_SkillEntries = {};
 	m_MovementAI = nullptr;
 	m_SoftTimer = 5.0f;
+	m_UseLineOfSight = Game::config->GetValue("ai_line_of_sight") != "0";
+	m_UseLod = Game::config->GetValue("ai_lod") != "0";
 
 	//Grab the aggro information from BaseCombatAI:
-	auto componentQuery = CDClientDatabase::CreatePreppedStmt(
-		"SELECT aggroRadius, tetherSpeed, pursuitSpeed, softTetherRadius, hardTetherRadius FROM BaseCombatAIComponent WHERE id = ?;");
-	componentQuery.bind(1, (int)id);
+	const auto& combatAI = prefab.GetCombatAI();
 
-	auto componentResult = componentQuery.execQuery();
-
-	if (!componentResult.eof()) {
-		if (!componentResult.fieldIsNull(0))
-			m_AggroRadius = componentResult.getFloatField(0);
-
-		if (!componentResult.fieldIsNull(1))
-			m_TetherSpeed = componentResult.getFloatField(1);
-
-		if (!componentResult.fieldIsNull(2))
-			m_PursuitSpeed = componentResult.getFloatField(2);
-
-		if (!componentResult.fieldIsNull(3))
-			m_SoftTetherRadius = componentResult.getFloatField(3);
-
-		if (!componentResult.fieldIsNull(4))
-			m_HardTetherRadius = componentResult.getFloatField(4);
-	}
-
-	componentResult.finalize();
+	m_AggroRadius = combatAI.aggroRadius.value_or(m_AggroRadius);
+	m_TetherSpeed = combatAI.tetherSpeed.value_or(m_TetherSpeed);
+	m_PursuitSpeed = combatAI.pursuitSpeed.value_or(m_PursuitSpeed);
+	m_SoftTetherRadius = combatAI.softTetherRadius.value_or(m_SoftTetherRadius);
+	m_HardTetherRadius = combatAI.hardTetherRadius.value_or(m_HardTetherRadius);
 
 	// Get aggro and tether radius from settings and use this if it is present.  Only overwrite the
 	// radii if it is greater than the one in the database.
@@ -73,28 +61,12 @@ BaseCombatAIComponent::BaseCombatAIComponent(Entity* parent, const uint32_t id):
 	/*
 	 * Find skills
 	 */
-	auto skillQuery = CDClientDatabase::CreatePreppedStmt(
-		"SELECT skillID, cooldown, behaviorID FROM SkillBehavior WHERE skillID IN (SELECT skillID FROM ObjectSkills WHERE objectTemplate = ?);");
-	skillQuery.bind(1, (int)parent->GetLOT());
-
-	auto result = skillQuery.execQuery();
-
-	while (!result.eof()) {
-		const auto skillId = static_cast<uint32_t>(result.getIntField(0));
-
-		const auto abilityCooldown = static_cast<float>(result.getFloatField(1));
-
-		const auto behaviorId = static_cast<uint32_t>(result.getIntField(2));
+	for (const auto& skill : prefab.GetSkills()) {
+		auto* behavior = Behavior::CreateBehavior(skill.behaviorId);
 
-		auto* behavior = Behavior::CreateBehavior(behaviorId);
-
-		std::stringstream behaviorQuery;
-
-		AiSkillEntry entry = { skillId, 0, abilityCooldown, behavior };
+		AiSkillEntry entry = { skill.skillId, 0, skill.cooldown, behavior };
 
 		m_SkillEntries.push_back(entry);
-
-		result.nextRow();
 	}
 
 	Stun(1.0f);
@@ -105,8 +77,7 @@ BaseCombatAIComponent::BaseCombatAIComponent(Entity* parent, const uint32_t id):
 
 	int32_t collisionGroup = (COLLISION_GROUP_DYNAMIC | COLLISION_GROUP_ENEMY);
 
-	CDComponentsRegistryTable* componentRegistryTable = CDClientManager::Instance()->GetTable<CDComponentsRegistryTable>("ComponentsRegistry");
-	auto componentID = componentRegistryTable->GetByIDAndType(parent->GetLOT(), eReplicaComponentType::CONTROLLABLE_PHYSICS);
+	auto componentID = prefab.GetComponentId(eReplicaComponentType::CONTROLLABLE_PHYSICS);
 
 	CDPhysicsComponentTable* physicsComponentTable = CDClientManager::Instance()->GetTable<CDPhysicsComponentTable>("PhysicsComponent");
 
@@ -140,7 +111,7 @@ BaseCombatAIComponent::~BaseCombatAIComponent() {
 		dpWorld::Instance().RemoveEntity(m_dpEntityEnemy);
 }
 
-void BaseCombatAIComponent::Update(const float deltaTime) {
+void BaseCombatAIComponent::Update(float deltaTime) {
 	//First, we need to process physics:
 	if (!m_dpEntity) return;
 
@@ -148,13 +119,29 @@ void BaseCombatAIComponent::Update(const float deltaTime) {
 	m_dpEntityEnemy->SetPosition(m_Parent->GetPosition());
 
 	//Process enter events
-	for (auto en : m_dpEntity->GetNewObjects()) {
-		m_Parent->OnCollisionPhantom(en->GetObjectID());
+	for (const auto id : m_dpEntity->GetNewObjects()) {
+		m_Parent->OnCollisionPhantom(id);
 	}
 
 	//Process exit events
-	for (auto en : m_dpEntity->GetRemovedObjects()) {
-		m_Parent->OnCollisionLeavePhantom(en->GetObjectID());
+	for (const auto id : m_dpEntity->GetRemovedObjects()) {
+		m_Parent->OnCollisionLeavePhantom(id);
+	}
+
+	// The phantom events above are only reported for one frame, the rest can wait when nobody is around to notice.
+	// An enemy entering the aggro phantom makes the AI engaged right away.
+	if (m_UseLod) {
+		m_Lod = CalculateLod();
+
+		m_LodTime += deltaTime;
+
+		const auto interval = m_Lod == AiLod::dormant ? DORMANT_TICK_INTERVAL : m_Lod == AiLod::distant ? DISTANT_TICK_INTERVAL : 0.0f;
+
+		if (m_LodTime < interval) return;
+
+		// Timers and cooldowns catch up on the time skipped
+		deltaTime = m_LodTime;
+		m_LodTime = 0.0f;
 	}
 
 	// Check if we should stop the tether effect
@@ -228,6 +215,37 @@ void BaseCombatAIComponent::Update(const float deltaTime) {
 }
 
 
+AiLod BaseCombatAIComponent::CalculateLod() {
+	if (!IsObserved()) {
+		return AiLod::dormant;
+	}
+
+	if (m_State != AiState::idle || m_Target != LWOOBJID_EMPTY || !m_ThreatEntries.empty() || m_Stunned
+		|| m_SkillTime > 0.0f || m_OutOfCombat || m_TetherEffectActive || !m_Parent->GetTargetsInPhantom().empty()) {
+		return AiLod::engaged;
+	}
+
+	return AiLod::distant;
+}
+
+bool BaseCombatAIComponent::IsObserved() const {
+	if (m_Parent->GetIsGhostingCandidate()) {
+		return m_Parent->GetObservers() > 0;
+	}
+
+	// Anything that is never ghosted is constructed for every player, count it as seen where it would have been
+	const auto ghostDistance = EntityManager::Instance()->GetGhostDistanceMax();
+	const auto& position = m_Parent->GetPosition();
+
+	for (auto* player : Player::GetAllPlayers()) {
+		if (NiPoint3::DistanceSquared(player->GetPosition(), position) <= ghostDistance * ghostDistance) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void BaseCombatAIComponent::CalculateCombat(const float deltaTime) {
 	bool hasSkillToCast = false;
 	for (auto& entry : m_SkillEntries) {
@@ -493,17 +511,36 @@ LWOOBJID BaseCombatAIComponent::FindTarget() {
 
 std::vector<LWOOBJID> BaseCombatAIComponent::GetTargetWithinAggroRange() const {
 	std::vector<LWOOBJID> targets;
+	std::vector<LineOfSightQuery> queries;
 
 	for (auto id : m_Parent->GetTargetsInPhantom()) {
 		auto* other = EntityManager::Instance()->GetEntity(id);
 
+		if (other == nullptr) continue;
+
 		const auto distance = Vector3::DistanceSquared(m_Parent->GetPosition(), other->GetPosition());
 
 		if (distance > m_AggroRadius * m_AggroRadius) continue;
 
 		targets.push_back(id);
+		queries.push_back({ m_Parent->GetPosition(), other->GetPosition() });
 	}
 
+	auto* navMesh = dpWorld::Instance().GetNavMesh();
+
+	if (targets.empty() || !m_UseLineOfSight || navMesh == nullptr) return targets;
+
+	// Targets behind walls can not be seen, checked all at once so the navmesh can share work between them
+	navMesh->CheckLineOfSight(queries);
+
+	size_t visibleCount = 0;
+
+	for (size_t i = 0; i < targets.size(); ++i) {
+		if (queries[i].visible) targets[visibleCount++] = targets[i];
+	}
+
+	targets.resize(visibleCount);
+
 	return targets;
 }
 
@@ -15,6 +15,7 @@
 
 class MovementAIComponent;
 class Entity;
+class EntityPrefab;
 
 /**
  * The current state of the AI
@@ -27,6 +28,15 @@ enum class AiState : int {
 	dead        // Killed
 };
 
+/**
+ * How closely the AI is watched, less watched AI thinks less often
+ */
+enum class AiLod : uint8_t {
+	dormant = 0, // No player can see the entity
+	distant,     // Seen by a player, but without enemies in its aggro radius
+	engaged      // Fighting, or has enemies in its aggro radius
+};
+
 /**
  * Represents a skill that can be cast by this enemy, including its cooldowns, which determines how often the skill
  * may be cast.
@@ -49,7 +59,7 @@ class BaseCombatAIComponent : public Component {
 public:
 	static const eReplicaComponentType ComponentType = eReplicaComponentType::BASE_COMBAT_AI;
 
-	BaseCombatAIComponent(Entity* parentEntity, uint32_t id);
+	BaseCombatAIComponent(Entity* parentEntity, const EntityPrefab& prefab);
 	~BaseCombatAIComponent() override;
 
 	void Update(float deltaTime) override;
@@ -61,6 +71,12 @@ public:
 	 */
 	AiState GetState() const { return m_State; }
 
+	/**
+	 * Returns how often the AI currently thinks
+	 * @return the level of detail of the AI
+	 */
+	AiLod GetLod() const { return m_Lod; }
+
 	/**
 	 * Set the current behavioral state of the enemy
 	 * @param state the state to change to
@@ -250,6 +266,27 @@ private:
 	 */
 	void SetAiState(AiState newState);
 
+	/**
+	 * Works out how closely the AI is watched, from the players observing the entity and the enemies in its aggro phantom
+	 * @return the level of detail the AI should think at
+	 */
+	AiLod CalculateLod();
+
+	/**
+	 * @return whether any player can see the entity, going by who ghosting constructed it for
+	 */
+	bool IsObserved() const;
+
+	/**
+	 * Seconds between the thoughts of AI not seen by any player
+	 */
+	static constexpr float DORMANT_TICK_INTERVAL = 2.0f;
+
+	/**
+	 * Seconds between the thoughts of AI seen by a player, but without enemies nearby
+	 */
+	static constexpr float DISTANT_TICK_INTERVAL = 0.25f;
+
 	/**
 	 * The current state of the AI
 	 */
@@ -382,6 +419,26 @@ private:
 	 */
 	bool m_DirtyStateOrTarget = false;
 
+	/**
+	 * Whether the AI only aggroes on enemies it can see on the navmesh, read from ai_line_of_sight
+	 */
+	bool m_UseLineOfSight = true;
+
+	/**
+	 * Whether the AI thinks less often when it is not watched closely, read from ai_lod
+	 */
+	bool m_UseLod = true;
+
+	/**
+	 * How closely the AI is currently watched
+	 */
+	AiLod m_Lod = AiLod::engaged;
+
+	/**
+	 * The time passed since the AI last thought, when it does not think every frame
+	 */
+	float m_LodTime = 0.0f;
+
 	/**
 	 * Whether the current entity is a mech enemy, needed as mechs tether radius works differently
 	 * @return whether this entity is a mech
@@ -13,6 +13,7 @@
 #include "Character.h"
 #include "dZoneManager.h"
 #include "LevelProgressionComponent.h"
+#include "SpatialQueryManager.h"
 
 ControllablePhysicsComponent::ControllablePhysicsComponent(Entity* entity) : Component(entity) {
 	m_Position = {};
@@ -50,6 +51,8 @@ ControllablePhysicsComponent::ControllablePhysicsComponent(Entity* entity) : Com
 	m_ImmuneToStunTurnCount = 0;
 	m_ImmuneToStunUseItemCount = 0;
 
+	SpatialQueryManager::Instance()->Add(m_Parent, m_Position);
+
 	if (entity->GetLOT() != 1) // Other physics entities we care about will be added by BaseCombatAI
 		return;
 
@@ -64,6 +67,8 @@ ControllablePhysicsComponent::ControllablePhysicsComponent(Entity* entity) : Com
 }
 
 ControllablePhysicsComponent::~ControllablePhysicsComponent() {
+	SpatialQueryManager::Instance()->Remove(m_Parent->GetObjectID());
+
 	if (m_dpEntity) {
 		dpWorld::Instance().RemoveEntity(m_dpEntity);
 	}
@@ -178,6 +183,9 @@ void ControllablePhysicsComponent::LoadFromXml(tinyxml2::XMLDocument* doc) {
 	character->QueryAttribute("lzrw", &m_Rotation.w);
 
 	m_DirtyPosition = true;
+
+	// The entity was indexed where it was created, before its position was known
+	SpatialQueryManager::Instance()->Move(m_Parent->GetObjectID(), m_Position);
 }
 
 void ControllablePhysicsComponent::ResetFlags() {
@@ -217,6 +225,8 @@ void ControllablePhysicsComponent::SetPosition(const NiPoint3& pos) {
 	m_DirtyPosition = true;
 
 	if (m_dpEntity) m_dpEntity->SetPosition(pos);
+
+	SpatialQueryManager::Instance()->Move(m_Parent->GetObjectID(), m_Position);
 }
 
 void ControllablePhysicsComponent::SetRotation(const NiQuaternion& rot) {
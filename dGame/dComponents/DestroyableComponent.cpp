@@ -33,6 +33,8 @@
 #include "dZoneManager.h"
 #include "WorldConfig.h"
 #include "eMissionTaskType.h"
+#include "SpatialQueryManager.h"
+#include "EntityPrefab.h"
 
 DestroyableComponent::DestroyableComponent(Entity* parent) : Component(parent) {
 	m_iArmor = 0;
@@ -74,33 +76,30 @@ DestroyableComponent::~DestroyableComponent() {
 }
 
 void DestroyableComponent::Reinitialize(LOT templateID) {
-	CDComponentsRegistryTable* compRegistryTable = CDClientManager::Instance()->GetTable<CDComponentsRegistryTable>("ComponentsRegistry");
+	const auto& prefab = EntityPrefab::GetPrefab(templateID);
 
-	int32_t buffComponentID = compRegistryTable->GetByIDAndType(templateID, eReplicaComponentType::BUFF);
-	int32_t collectibleComponentID = compRegistryTable->GetByIDAndType(templateID, eReplicaComponentType::COLLECTIBLE);
-	int32_t rebuildComponentID = compRegistryTable->GetByIDAndType(templateID, eReplicaComponentType::QUICK_BUILD);
+	int32_t buffComponentID = prefab.GetComponentId(eReplicaComponentType::BUFF);
+	int32_t collectibleComponentID = prefab.GetComponentId(eReplicaComponentType::COLLECTIBLE);
+	int32_t rebuildComponentID = prefab.GetComponentId(eReplicaComponentType::QUICK_BUILD);
 
 	int32_t componentID = 0;
 	if (collectibleComponentID > 0) componentID = collectibleComponentID;
 	if (rebuildComponentID > 0) componentID = rebuildComponentID;
 	if (buffComponentID > 0) componentID = buffComponentID;
 
-	CDDestructibleComponentTable* destCompTable = CDClientManager::Instance()->GetTable<CDDestructibleComponentTable>("DestructibleComponent");
-	std::vector<CDDestructibleComponent> destCompData = destCompTable->Query([=](CDDestructibleComponent entry) { return (entry.id == componentID); });
-
 	if (componentID > 0) {
-		std::vector<CDDestructibleComponent> destCompData = destCompTable->Query([=](CDDestructibleComponent entry) { return (entry.id == componentID); });
+		const auto* destCompData = prefab.GetDestructible();
 
-		if (destCompData.size() > 0) {
-			SetHealth(destCompData[0].life);
-			SetImagination(destCompData[0].imagination);
-			SetArmor(destCompData[0].armor);
+		if (destCompData != nullptr) {
+			SetHealth(destCompData->life);
+			SetImagination(destCompData->imagination);
+			SetArmor(destCompData->armor);
 
-			SetMaxHealth(destCompData[0].life);
-			SetMaxImagination(destCompData[0].imagination);
-			SetMaxArmor(destCompData[0].armor);
+			SetMaxHealth(destCompData->life);
+			SetMaxImagination(destCompData->imagination);
+			SetMaxArmor(destCompData->armor);
 
-			SetIsSmashable(destCompData[0].isSmashable);
+			SetIsSmashable(destCompData->isSmashable);
 		}
 	} else {
 		SetHealth(1);
@@ -378,6 +377,8 @@ void DestroyableComponent::AddFaction(const int32_t factionID, const bool ignore
 	m_FactionIDs.push_back(factionID);
 	m_DirtyHealth = true;
 
+	SpatialQueryManager::Instance()->SetFactionMask(m_Parent->GetObjectID(), SpatialQueryManager::GetFactionMask(m_FactionIDs));
+
 	auto query = CDClientDatabase::CreatePreppedStmt(
 		"SELECT enemyList FROM Factions WHERE faction = ?;");
 	query.bind(1, (int)factionID);
@@ -827,6 +828,8 @@ void DestroyableComponent::SetFaction(int32_t factionID, bool ignoreChecks) {
 	m_FactionIDs.clear();
 	m_EnemyFactionIDs.clear();
 
+	SpatialQueryManager::Instance()->SetFactionMask(m_Parent->GetObjectID(), 0);
+
 	AddFaction(factionID, ignoreChecks);
 }
 
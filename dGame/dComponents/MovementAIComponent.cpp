@@ -10,9 +10,41 @@
 #include "EntityManager.h"
 #include "SimplePhysicsComponent.h"
 #include "CDClientManager.h"
+#include "PathfindingService.h"
+#include "CrowdManager.h"
 
 std::map<LOT, float> MovementAIComponent::m_PhysicsSpeedCache = {};
 
+namespace {
+	PathfindingService* GetPathfinder() {
+		auto* navMesh = dpWorld::Instance().GetNavMesh();
+
+		return navMesh != nullptr ? navMesh->GetPathfinder() : nullptr;
+	}
+
+	CrowdManager* GetCrowd() {
+		auto* navMesh = dpWorld::Instance().GetNavMesh();
+
+		return navMesh != nullptr ? navMesh->GetCrowd() : nullptr;
+	}
+
+	/**
+	 * Crowd agents this close to their destination, ignoring height, have arrived
+	 */
+	constexpr float CROWD_ARRIVAL_DISTANCE = 1.0f;
+
+	/**
+	 * Destinations moving less than this keep the path the agent has, so chasing a target does not
+	 * search a new path every frame
+	 */
+	constexpr float CROWD_RETARGET_DISTANCE = 1.0f;
+
+	/**
+	 * Entities moved further than this away from their agent were moved by something else, like a script
+	 */
+	constexpr float CROWD_RESYNC_DISTANCE = 4.0f;
+}
+
 MovementAIComponent::MovementAIComponent(Entity* parent, MovementAIInfo info) : Component(parent) {
 	m_Info = std::move(info);
 	m_Done = true;
@@ -40,7 +72,10 @@ MovementAIComponent::MovementAIComponent(Entity* parent, MovementAIInfo info) :
 	m_LockRotation = false;
 }
 
-MovementAIComponent::~MovementAIComponent() = default;
+MovementAIComponent::~MovementAIComponent() {
+	CancelPathRequest();
+	RemoveCrowdAgent();
+}
 
 void MovementAIComponent::Update(const float deltaTime) {
 	if (m_Interrupted) {
@@ -63,12 +98,17 @@ void MovementAIComponent::Update(const float deltaTime) {
 		return;
 	}
 
+	if (m_PathRequest != 0) {
+		CollectPath();
+	}
+
 	if (AtFinalWaypoint()) // Are we done?
 	{
 		return;
 	}
 
-	if (m_HaltDistance > 0) {
+	// The destination of the current path is stale while waiting for a new one
+	if (m_HaltDistance > 0 && m_PathRequest == 0) {
 		if (Vector3::DistanceSquared(ApproximateLocation(), GetDestination()) < m_HaltDistance * m_HaltDistance) // Prevent us from hugging the target
 		{
 			Stop();
@@ -77,6 +117,12 @@ void MovementAIComponent::Update(const float deltaTime) {
 		}
 	}
 
+	if (m_CrowdAgent != CrowdManager::INVALID_AGENT) {
+		UpdateCrowdAgent();
+
+		return;
+	}
+
 	if (m_Timer > 0) {
 		m_Timer -= deltaTime;
 
@@ -134,8 +180,8 @@ void MovementAIComponent::Update(const float deltaTime) {
 			SetDestination(m_Queue.top());
 
 			m_Queue.pop();
-		} else {
-			// We have reached our final waypoint
+		} else if (m_PathRequest == 0) {
+			// We have reached our final waypoint, and are not waiting for a new path
 			Stop();
 
 			return;
@@ -206,6 +252,8 @@ NiPoint3 MovementAIComponent::ApproximateLocation() const {
 bool MovementAIComponent::Warp(const NiPoint3& point) {
 	Stop();
 
+	RemoveCrowdAgent();
+
 	NiPoint3 destination = point;
 
 	if (dpWorld::Instance().IsLoaded()) {
@@ -232,6 +280,16 @@ bool MovementAIComponent::AtFinalWaypoint() const {
 }
 
 void MovementAIComponent::Stop() {
+	CancelPathRequest();
+
+	if (m_CrowdAgent != CrowdManager::INVALID_AGENT) {
+		auto* crowd = GetCrowd();
+
+		if (crowd != nullptr) {
+			crowd->ResetTarget(m_CrowdAgent);
+		}
+	}
+
 	if (m_Done) {
 		return;
 	}
@@ -256,6 +314,8 @@ void MovementAIComponent::Stop() {
 void MovementAIComponent::PullToPoint(const NiPoint3& point) {
 	Stop();
 
+	RemoveCrowdAgent();
+
 	m_Interrupted = true;
 	m_PullPoint = point;
 }
@@ -379,20 +439,62 @@ void MovementAIComponent::SetDestination(const NiPoint3& value) {
 		return;
 	}*/
 
-	const auto location = ApproximateLocation();
+	// The crowd finds the path over the next frames and steers around other enemies on the way
+	const auto hadCrowdAgent = m_CrowdAgent != CrowdManager::INVALID_AGENT;
 
-	if (!AtFinalWaypoint()) {
-		SetPosition(location);
+	if (UseCrowdAgent()) {
+		if (hadCrowdAgent && !m_Done && Vector3::DistanceSquared(value, m_CrowdTarget) < CROWD_RETARGET_DISTANCE * CROWD_RETARGET_DISTANCE) {
+			return;
+		}
+
+		if (!GetCrowd()->SetTarget(m_CrowdAgent, value)) {
+			return;
+		}
+
+		m_CrowdTarget = value;
+
+		m_CurrentPath = { GetCurrentPosition(), value };
+
+		m_PathIndex = 0;
+
+		m_TotalTime = m_Timer = 0;
+
+		m_Done = false;
+
+		return;
+	}
+
+	auto* pathfinder = GetPathfinder();
+
+	if (pathfinder != nullptr) {
+		// Keep following the current path until the new one arrives.  Only one path is requested at a time,
+		// so an entity chasing a moving target still gets paths, the latest destination is asked for next.
+		if (m_PathRequest != 0) {
+			m_QueuedDestination = value;
+			m_HasQueuedDestination = true;
+
+			return;
+		}
+
+		m_PathRequest = pathfinder->RequestPath(ApproximateLocation(), value);
+
+		CollectPath();
+
+		return;
 	}
 
 	std::vector<NiPoint3> computedPath;
 
 	if (dpWorld::Instance().IsLoaded()) {
-		computedPath = dpWorld::Instance().GetNavMesh()->GetPath(GetCurrentPosition(), value, m_Info.wanderSpeed);
+		computedPath = dpWorld::Instance().GetNavMesh()->GetPath(ApproximateLocation(), value, m_Info.wanderSpeed);
+
+		for (auto& point : computedPath) {
+			point.y = dpWorld::Instance().GetNavMesh()->GetHeightAtPoint(point);
+		}
 	} else {
 		// Than take 10 points between the current position and the destination and make that the path
 
-		auto point = location;
+		auto point = ApproximateLocation();
 
 		auto delta = value - point;
 
@@ -405,6 +507,16 @@ void MovementAIComponent::SetDestination(const NiPoint3& value) {
 		}
 	}
 
+	FollowPath(computedPath);
+}
+
+void MovementAIComponent::FollowPath(const std::vector<NiPoint3>& computedPath) {
+	const auto location = ApproximateLocation();
+
+	if (!AtFinalWaypoint()) {
+		SetPosition(location);
+	}
+
 	if (computedPath.empty()) // Somehow failed
 	{
 		return;
@@ -414,14 +526,7 @@ void MovementAIComponent::SetDestination(const NiPoint3& value) {
 
 	m_CurrentPath.push_back(location);
 
-	// Simply path
-	for (auto point : computedPath) {
-		if (dpWorld::Instance().IsLoaded()) {
-			point.y = dpWorld::Instance().GetNavMesh()->GetHeightAtPoint(point);
-		}
-
-		m_CurrentPath.push_back(point);
-	}
+	m_CurrentPath.insert(m_CurrentPath.end(), computedPath.begin(), computedPath.end());
 
 	m_CurrentPath.push_back(computedPath[computedPath.size() - 1]);
 
@@ -432,6 +537,149 @@ void MovementAIComponent::SetDestination(const NiPoint3& value) {
 	m_Done = false;
 }
 
+void MovementAIComponent::CollectPath() {
+	auto* pathfinder = GetPathfinder();
+
+	if (pathfinder == nullptr) {
+		m_PathRequest = 0;
+
+		return;
+	}
+
+	std::vector<NiPoint3> path;
+
+	const auto status = pathfinder->TakePath(m_PathRequest, path);
+
+	if (status == PathfindingService::PathStatus::Pending) {
+		return;
+	}
+
+	m_PathRequest = 0;
+
+	if (status == PathfindingService::PathStatus::Ready) {
+		FollowPath(path);
+	}
+
+	if (m_HasQueuedDestination) {
+		m_HasQueuedDestination = false;
+
+		m_PathRequest = pathfinder->RequestPath(ApproximateLocation(), m_QueuedDestination);
+
+		CollectPath();
+	}
+}
+
+void MovementAIComponent::CancelPathRequest() {
+	m_HasQueuedDestination = false;
+
+	if (m_PathRequest == 0) {
+		return;
+	}
+
+	auto* pathfinder = GetPathfinder();
+
+	if (pathfinder != nullptr) {
+		pathfinder->Cancel(m_PathRequest);
+	}
+
+	m_PathRequest = 0;
+}
+
+bool MovementAIComponent::UseCrowdAgent() {
+	if (m_CrowdAgent != CrowdManager::INVALID_AGENT) {
+		return true;
+	}
+
+	auto* crowd = GetCrowd();
+
+	if (crowd == nullptr) {
+		return false;
+	}
+
+	m_CrowdPosition = GetCurrentPosition();
+
+	m_CrowdAgent = crowd->AddAgent(m_CrowdPosition, m_Speed * m_BaseSpeed);
+
+	if (m_CrowdAgent == CrowdManager::INVALID_AGENT) {
+		return false;
+	}
+
+	// Switching from following its own path
+	CancelPathRequest();
+
+	return true;
+}
+
+void MovementAIComponent::UpdateCrowdAgent() {
+	auto* crowd = GetCrowd();
+
+	NiPoint3 position;
+	NiPoint3 velocity;
+
+	if (crowd == nullptr || !crowd->GetState(m_CrowdAgent, position, velocity)) {
+		m_CrowdAgent = CrowdManager::INVALID_AGENT;
+
+		Stop();
+
+		return;
+	}
+
+	if (Vector3::DistanceSquared(GetCurrentPosition(), m_CrowdPosition) > CROWD_RESYNC_DISTANCE * CROWD_RESYNC_DISTANCE) {
+		// Something else moved the entity, start over from where it is now
+		RemoveCrowdAgent();
+
+		SetDestination(m_CrowdTarget);
+
+		return;
+	}
+
+	crowd->SetMaxSpeed(m_CrowdAgent, m_Speed * m_BaseSpeed);
+
+	m_CrowdPosition = position;
+
+	m_NextWaypoint = m_CrowdTarget;
+
+	SetPosition(position);
+
+	SetVelocity(velocity);
+
+	if (velocity.SquaredLength() > 0.01f) {
+		SetRotation(NiQuaternion::LookAt(position, position + velocity));
+	}
+
+	const auto deltaX = m_CrowdTarget.x - position.x;
+	const auto deltaZ = m_CrowdTarget.z - position.z;
+
+	if (deltaX * deltaX + deltaZ * deltaZ < CROWD_ARRIVAL_DISTANCE * CROWD_ARRIVAL_DISTANCE || crowd->HasStopped(m_CrowdAgent)) {
+		// Check if there are more waypoints in the queue, if so set our next destination to the next waypoint
+		if (m_Queue.empty()) {
+			Stop();
+
+			return;
+		}
+
+		SetDestination(m_Queue.top());
+
+		m_Queue.pop();
+	}
+
+	EntityManager::Instance()->SerializeEntity(m_Parent);
+}
+
+void MovementAIComponent::RemoveCrowdAgent() {
+	if (m_CrowdAgent == CrowdManager::INVALID_AGENT) {
+		return;
+	}
+
+	auto* crowd = GetCrowd();
+
+	if (crowd != nullptr) {
+		crowd->RemoveAgent(m_CrowdAgent);
+	}
+
+	m_CrowdAgent = CrowdManager::INVALID_AGENT;
+}
+
 NiPoint3 MovementAIComponent::GetDestination() const {
 	if (m_CurrentPath.empty()) {
 		return GetCurrentPosition();
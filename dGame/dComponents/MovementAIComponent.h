@@ -14,6 +14,7 @@
 #include "dLogger.h"
 #include "Component.h"
 #include "eReplicaComponentType.h"
+#include "CrowdManager.h"
 #include <vector>
 
 class ControllablePhysicsComponent;
@@ -237,6 +238,38 @@ private:
 	 */
 	void SetVelocity(const NiPoint3& value);
 
+	/**
+	 * Replaces the current path with a computed one, starting from where the entity is now
+	 * @param computedPath the points to move along, with their height already on the navmesh
+	 */
+	void FollowPath(const std::vector<NiPoint3>& computedPath);
+
+	/**
+	 * Starts following the requested path if the pathfinding service has found it
+	 */
+	void CollectPath();
+
+	/**
+	 * Forgets the path requested from the pathfinding service and the queued destination, if any
+	 */
+	void CancelPathRequest();
+
+	/**
+	 * Adds the entity to the crowd of the zone if it is not in it yet
+	 * @return true if the entity moves with the crowd, false if it follows its own paths
+	 */
+	bool UseCrowdAgent();
+
+	/**
+	 * Moves the entity to where the crowd moved its agent
+	 */
+	void UpdateCrowdAgent();
+
+	/**
+	 * Takes the entity out of the crowd, it is added again on its next destination
+	 */
+	void RemoveCrowdAgent();
+
 	/**
 	 * Base information regarding the movement information for this entity
 	 */
@@ -322,6 +355,36 @@ private:
 	 */
 	std::stack<NiPoint3> m_Queue;
 
+	/**
+	 * The ticket of the path requested from the pathfinding service, 0 if none is pending
+	 */
+	uint64_t m_PathRequest = 0;
+
+	/**
+	 * The destination to request a path to once the pending one arrives
+	 */
+	NiPoint3 m_QueuedDestination;
+
+	/**
+	 * If a destination was set while a path was pending
+	 */
+	bool m_HasQueuedDestination = false;
+
+	/**
+	 * The agent moving this entity in the crowd of the zone, if it is in the crowd
+	 */
+	int32_t m_CrowdAgent = CrowdManager::INVALID_AGENT;
+
+	/**
+	 * The destination the crowd agent is moving towards
+	 */
+	NiPoint3 m_CrowdTarget;
+
+	/**
+	 * The position last taken from the crowd agent, to notice the entity being moved by something else
+	 */
+	NiPoint3 m_CrowdPosition;
+
 	/**
 	 * Cache of all lots and their respective speeds
 	 */
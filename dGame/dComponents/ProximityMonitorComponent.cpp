@@ -5,8 +5,6 @@
 #include "EntityManager.h"
 #include "SimplePhysicsComponent.h"
 
-const std::map<LWOOBJID, dpEntity*> ProximityMonitorComponent::m_EmptyObjectMap = {};
-
 ProximityMonitorComponent::ProximityMonitorComponent(Entity* parent, int radiusSmall, int radiusLarge) : Component(parent) {
 	if (radiusSmall != -1 && radiusLarge != -1) {
 		SetProximityRadius(radiusSmall, "rocketSmall");
@@ -38,11 +36,11 @@ void ProximityMonitorComponent::SetProximityRadius(dpEntity* entity, const std::
 	m_ProximitiesData.insert(std::make_pair(name, entity));
 }
 
-const std::map<LWOOBJID, dpEntity*>& ProximityMonitorComponent::GetProximityObjects(const std::string& name) {
+dpCollidingObjects ProximityMonitorComponent::GetProximityObjects(const std::string& name) {
 	const auto& iter = m_ProximitiesData.find(name);
 
 	if (iter == m_ProximitiesData.end()) {
-		return m_EmptyObjectMap;
+		return dpCollidingObjects();
 	}
 
 	return iter->second->GetCurrentlyCollidingObjects();
@@ -55,9 +53,7 @@ bool ProximityMonitorComponent::IsInProximity(const std::string& name, LWOOBJID
 		return false;
 	}
 
-	const auto& collitions = iter->second->GetCurrentlyCollidingObjects();
-
-	return collitions.find(objectID) != collitions.end();
+	return iter->second->GetCurrentlyCollidingObjects().Contains(objectID);
 }
 
 void ProximityMonitorComponent::Update(float deltaTime) {
@@ -65,13 +61,13 @@ void ProximityMonitorComponent::Update(float deltaTime) {
 		if (!prox.second) continue;
 
 		//Process enter events
-		for (auto* en : prox.second->GetNewObjects()) {
-			m_Parent->OnCollisionProximity(en->GetObjectID(), prox.first, "ENTER");
+		for (const auto id : prox.second->GetNewObjects()) {
+			m_Parent->OnCollisionProximity(id, prox.first, "ENTER");
 		}
 
 		//Process exit events
-		for (auto* en : prox.second->GetRemovedObjects()) {
-			m_Parent->OnCollisionProximity(en->GetObjectID(), prox.first, "LEAVE");
+		for (const auto id : prox.second->GetRemovedObjects()) {
+			m_Parent->OnCollisionProximity(id, prox.first, "LEAVE");
 		}
 	}
 }
@@ -40,11 +40,11 @@ public:
 	void SetProximityRadius(dpEntity* entity, const std::string& name);
 
 	/**
-	 * Returns the last of entities that are used to check proximity, given a name
+	 * Returns the objects that are currently in proximity, given a name
 	 * @param name the proximity name to retrieve physics objects for
-	 * @return a map of physics entities for this name, indexed by object ID
+	 * @return a view of the object IDs in proximity for this name, valid until the next physics update
 	 */
-	const std::map<LWOOBJID, dpEntity*>& GetProximityObjects(const std::string& name);
+	dpCollidingObjects GetProximityObjects(const std::string& name);
 
 	/**
 	 * Checks if the passed object is in proximity of the named proximity sensor
@@ -66,11 +66,6 @@ private:
 	 * All the proximity sensors for this component, indexed by name
 	 */
 	std::map<std::string, dpEntity*> m_ProximitiesData = {};
-
-	/**
-	 * Default value for the proximity data
-	 */
-	static const std::map<LWOOBJID, dpEntity*> m_EmptyObjectMap;
 };
 
 #endif // PROXIMITYMONITORCOMPONENT_H
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "BehaviorContext.h"
+#include "BehaviorContextPool.h"
 #include "BehaviorBranchContext.h"
 #include "Behavior.h"
 #include "CDClientDatabase.h"
@@ -29,14 +30,16 @@ ProjectileSyncEntry::ProjectileSyncEntry() {
 
 std::unordered_map<uint32_t, uint32_t> SkillComponent::m_skillBehaviorCache = {};
 
+std::unordered_map<LOT, uint32_t> SkillComponent::m_projectileBehaviorCache = {};
+
 bool SkillComponent::CastPlayerSkill(const uint32_t behaviorId, const uint32_t skillUid, RakNet::BitStream* bitStream, const LWOOBJID target, uint32_t skillID) {
-	auto* context = new BehaviorContext(this->m_Parent->GetObjectID());
+	auto* context = BehaviorContextPool::Instance()->Acquire(this->m_Parent->GetObjectID());
 
 	context->caster = m_Parent->GetObjectID();
 
 	context->skillID = skillID;
 
-	this->m_managedBehaviors.insert_or_assign(skillUid, context);
+	ManageBehavior(skillUid, context);
 
 	auto* behavior = Behavior::CreateBehavior(behaviorId);
 
@@ -50,56 +53,39 @@ bool SkillComponent::CastPlayerSkill(const uint32_t behaviorId, const uint32_t s
 }
 
 void SkillComponent::SyncPlayerSkill(const uint32_t skillUid, const uint32_t syncId, RakNet::BitStream* bitStream) {
-	const auto index = this->m_managedBehaviors.find(skillUid);
+	auto* context = FindBehavior(skillUid);
 
-	if (index == this->m_managedBehaviors.end()) {
+	if (context == nullptr) {
 		Game::logger->Log("SkillComponent", "Failed to find skill with uid (%i)!", skillUid, syncId);
 
 		return;
 	}
 
-	auto* context = index->second;
-
 	context->SyncBehavior(syncId, bitStream);
 }
 
 
 void SkillComponent::SyncPlayerProjectile(const LWOOBJID projectileId, RakNet::BitStream* bitStream, const LWOOBJID target) {
-	auto index = -1;
-
-	for (auto i = 0u; i < this->m_managedProjectiles.size(); ++i) {
-		const auto& projectile = this->m_managedProjectiles.at(i);
-
-		if (projectile.id == projectileId) {
-			index = i;
-
-			break;
-		}
-	}
+	const auto index = this->m_projectileIndices.find(projectileId);
 
-	if (index == -1) {
+	if (index == this->m_projectileIndices.end()) {
 		Game::logger->Log("SkillComponent", "Failed to find projectile id (%llu)!", projectileId);
 
 		return;
 	}
 
-	const auto sync_entry = this->m_managedProjectiles.at(index);
-
-	auto query = CDClientDatabase::CreatePreppedStmt(
-		"SELECT behaviorID FROM SkillBehavior WHERE skillID = (SELECT skillID FROM ObjectSkills WHERE objectTemplate = ?);");
-	query.bind(1, (int)sync_entry.lot);
+	const auto sync_entry = this->m_managedProjectiles.at(index->second);
 
-	auto result = query.execQuery();
+	const auto behavior_id = GetProjectileBehavior(sync_entry.lot);
 
-	if (result.eof()) {
+	if (behavior_id == -1) {
 		Game::logger->Log("SkillComponent", "Failed to find skill id for (%i)!", sync_entry.lot);
 
 		return;
 	}
 
-	const auto behavior_id = static_cast<uint32_t>(result.getIntField(0));
-
-	result.finalize();
+	// The context stays alive until the next update, even if this was its last projectile
+	RemoveProjectile(index->second);
 
 	auto* behavior = Behavior::CreateBehavior(behavior_id);
 
@@ -112,8 +98,6 @@ void SkillComponent::SyncPlayerProjectile(const LWOOBJID projectileId, RakNet::B
 	}
 
 	behavior->Handle(sync_entry.context, bitStream, branch);
-
-	this->m_managedProjectiles.erase(this->m_managedProjectiles.begin() + index);
 }
 
 void SkillComponent::RegisterPlayerProjectile(const LWOOBJID projectileId, BehaviorContext* context, const BehaviorBranchContext& branch, const LOT lot) {
@@ -124,18 +108,86 @@ void SkillComponent::RegisterPlayerProjectile(const LWOOBJID projectileId, Behav
 	entry.lot = lot;
 	entry.id = projectileId;
 
+	AddProjectile(entry);
+}
+
+void SkillComponent::AddProjectile(const ProjectileSyncEntry& entry) {
+	const auto existing = this->m_projectileIndices.find(entry.id);
+
+	// A projectile id is only synced once, so a new projectile with the same id replaces the old one
+	if (existing != this->m_projectileIndices.end()) {
+		RemoveProjectile(existing->second);
+	}
+
+	this->m_projectileIndices[entry.id] = this->m_managedProjectiles.size();
+	this->m_projectileCounts[entry.context]++;
+
 	this->m_managedProjectiles.push_back(entry);
 }
 
+void SkillComponent::RemoveProjectile(const size_t index) {
+	const auto& entry = this->m_managedProjectiles[index];
+
+	const auto count = this->m_projectileCounts.find(entry.context);
+
+	if (count != this->m_projectileCounts.end() && --count->second == 0) {
+		this->m_projectileCounts.erase(count);
+	}
+
+	this->m_projectileIndices.erase(entry.id);
+
+	// Move the last projectile into the freed slot
+	if (index != this->m_managedProjectiles.size() - 1) {
+		this->m_managedProjectiles[index] = this->m_managedProjectiles.back();
+		this->m_projectileIndices[this->m_managedProjectiles[index].id] = index;
+	}
+
+	this->m_managedProjectiles.pop_back();
+}
+
+bool SkillComponent::HasProjectiles(BehaviorContext* context) const {
+	return this->m_projectileCounts.find(context) != this->m_projectileCounts.end();
+}
+
+uint32_t SkillComponent::GetProjectileBehavior(const LOT lot) {
+	const auto cached = m_projectileBehaviorCache.find(lot);
+
+	if (cached != m_projectileBehaviorCache.end()) {
+		return cached->second;
+	}
+
+	uint32_t behaviorId = -1;
+
+	auto query = CDClientDatabase::CreatePreppedStmt(
+		"SELECT behaviorID FROM SkillBehavior WHERE skillID = (SELECT skillID FROM ObjectSkills WHERE objectTemplate = ?);");
+	query.bind(1, (int)lot);
+
+	auto result = query.execQuery();
+
+	if (!result.eof()) {
+		behaviorId = static_cast<uint32_t>(result.getIntField(0));
+	}
+
+	result.finalize();
+
+	// Missing behaviors are cached as well, they will not show up until the server restarts
+	m_projectileBehaviorCache.insert_or_assign(lot, behaviorId);
+
+	return behaviorId;
+}
+
 void SkillComponent::Update(const float deltaTime) {
 	if (!m_Parent->HasComponent(eReplicaComponentType::BASE_COMBAT_AI) && m_Parent->GetLOT() != 1) {
 		CalculateUpdate(deltaTime);
 	}
 
-	std::map<uint32_t, BehaviorContext*> keep{};
+	// Updating a skill may cast or reset skills of this entity, new skills are appended and updated as well
+	const auto resets = this->m_resetCount;
+	size_t kept = 0;
 
-	for (const auto& pair : this->m_managedBehaviors) {
-		auto* context = pair.second;
+	for (size_t i = 0; i < this->m_managedBehaviors.size(); ++i) {
+		const auto managed = this->m_managedBehaviors[i];
+		auto* context = managed.second;
 
 		if (context == nullptr) {
 			continue;
@@ -147,42 +199,70 @@ void SkillComponent::Update(const float deltaTime) {
 			context->Update(deltaTime);
 		}
 
+		// Every context was already released by the reset
+		if (this->m_resetCount != resets) return;
+
 		// Cleanup old behaviors
-		if (context->syncEntries.empty() && context->timerEntries.empty()) {
-			auto any = false;
+		if (context->syncEntries.empty() && context->timerEntries.empty() && !HasProjectiles(context)) {
+			BehaviorContextPool::Instance()->Release(context);
 
-			for (const auto& projectile : this->m_managedProjectiles) {
-				if (projectile.context == context) {
-					any = true;
+			if (this->m_resetCount != resets) return;
 
-					break;
-				}
-			}
+			continue;
+		}
 
-			if (!any) {
-				context->Reset();
+		this->m_managedBehaviors[kept++] = managed;
+	}
 
-				delete context;
+	this->m_managedBehaviors.resize(kept);
+}
 
-				context = nullptr;
+void SkillComponent::Reset() {
+	auto behaviors = std::move(this->m_managedBehaviors);
 
-				continue;
-			}
-		}
+	this->m_managedBehaviors.clear();
+	this->m_resetCount++;
 
-		keep.insert_or_assign(pair.first, context);
+	for (const auto& behavior : behaviors) {
+		BehaviorContextPool::Instance()->Release(behavior.second);
 	}
 
-	this->m_managedBehaviors = keep;
+	this->m_managedProjectiles.clear();
+	this->m_projectileIndices.clear();
+	this->m_projectileCounts.clear();
 }
 
-void SkillComponent::Reset() {
+BehaviorContext* SkillComponent::FindBehavior(const uint32_t skillUid) const {
 	for (const auto& behavior : this->m_managedBehaviors) {
-		delete behavior.second;
+		if (behavior.first == skillUid) return behavior.second;
 	}
 
-	this->m_managedProjectiles.clear();
-	this->m_managedBehaviors.clear();
+	return nullptr;
+}
+
+void SkillComponent::ManageBehavior(const uint32_t skillUid, BehaviorContext* context) {
+	for (auto& behavior : this->m_managedBehaviors) {
+		if (behavior.first != skillUid) continue;
+
+		// The client reused a skill uid, the skill it replaces will never be synced again
+		auto* replaced = behavior.second;
+		behavior.second = context;
+
+		if (replaced == context) return;
+
+		if (HasProjectiles(replaced)) {
+			// Its projectiles may still hit, keep it behind the new skill until they are done
+			replaced->syncEntries.clear();
+
+			this->m_managedBehaviors.emplace_back(skillUid, replaced);
+		} else {
+			BehaviorContextPool::Instance()->Release(replaced);
+		}
+
+		return;
+	}
+
+	this->m_managedBehaviors.emplace_back(skillUid, context);
 }
 
 void SkillComponent::Interrupt() {
@@ -210,7 +290,7 @@ void SkillComponent::RegisterCalculatedProjectile(const LWOOBJID projectileId, B
 	entry.trackTarget = trackTarget;
 	entry.trackRadius = trackRadius;
 
-	this->m_managedProjectiles.push_back(entry);
+	AddProjectile(entry);
 }
 
 bool SkillComponent::CastSkill(const uint32_t skillId, LWOOBJID target, const LWOOBJID optionalOriginatorID){
@@ -242,7 +322,7 @@ SkillExecutionResult SkillComponent::CalculateBehavior(const uint32_t skillId, c
 
 	auto* behavior = Behavior::CreateBehavior(behaviorId);
 
-	auto* context = new BehaviorContext(originatorOverride != LWOOBJID_EMPTY ? originatorOverride : this->m_Parent->GetObjectID(), true);
+	auto* context = BehaviorContextPool::Instance()->Acquire(originatorOverride != LWOOBJID_EMPTY ? originatorOverride : this->m_Parent->GetObjectID(), true);
 
 	context->caster = m_Parent->GetObjectID();
 
@@ -258,13 +338,13 @@ SkillExecutionResult SkillComponent::CalculateBehavior(const uint32_t skillId, c
 
 	if (!context->foundTarget) {
 		delete bitStream;
-		delete context;
+		BehaviorContextPool::Instance()->Release(context);
 
 		// Invalid attack
 		return { false, 0 };
 	}
 
-	this->m_managedBehaviors.insert_or_assign(context->skillUId, context);
+	ManageBehavior(context->skillUId, context);
 
 	if (!clientInitalized) {
 		// Echo start skill
@@ -315,8 +395,11 @@ void SkillComponent::CalculateUpdate(const float deltaTime) {
 		managedBehavior.second->CalculateUpdate(deltaTime);
 	}
 
-	for (auto& managedProjectile : this->m_managedProjectiles) {
-		auto entry = managedProjectile;
+	// Hitting a target may register or reset projectiles, so these are accessed by index
+	const auto resets = this->m_resetCount;
+
+	for (size_t i = 0; i < this->m_managedProjectiles.size(); ++i) {
+		auto entry = this->m_managedProjectiles[i];
 
 		if (!entry.calculation) continue;
 
@@ -355,28 +438,33 @@ void SkillComponent::CalculateUpdate(const float deltaTime) {
 			break;
 		}
 
+		if (this->m_resetCount != resets) return;
+
 		entry.lastPosition = position;
 
-		managedProjectile = entry;
+		this->m_managedProjectiles[i] = entry;
 	}
 
-	std::vector<ProjectileSyncEntry> valid;
-
-	for (auto& entry : this->m_managedProjectiles) {
-		if (entry.calculation) {
-			if (entry.time >= entry.maxTime) {
-				entry.branchContext.target = LWOOBJID_EMPTY;
+	// Remove the projectiles that hit something or ran out of time, in place
+	for (size_t i = 0; i < this->m_managedProjectiles.size();) {
+		const auto& entry = this->m_managedProjectiles[i];
 
-				SyncProjectileCalculation(entry);
+		if (!entry.calculation || entry.time < entry.maxTime) {
+			++i;
 
-				continue;
-			}
+			continue;
 		}
 
-		valid.push_back(entry);
-	}
+		auto finished = entry;
 
-	this->m_managedProjectiles = valid;
+		RemoveProjectile(i);
+
+		finished.branchContext.target = LWOOBJID_EMPTY;
+
+		SyncProjectileCalculation(finished);
+
+		if (this->m_resetCount != resets) return;
+	}
 }
 
 
@@ -391,21 +479,14 @@ void SkillComponent::SyncProjectileCalculation(const ProjectileSyncEntry& entry)
 		return;
 	}
 
-	auto query = CDClientDatabase::CreatePreppedStmt(
-		"SELECT behaviorID FROM SkillBehavior WHERE skillID = (SELECT skillID FROM ObjectSkills WHERE objectTemplate = ?);");
-	query.bind(1, (int)entry.lot);
-	auto result = query.execQuery();
+	const auto behaviorId = GetProjectileBehavior(entry.lot);
 
-	if (result.eof()) {
+	if (behaviorId == -1) {
 		Game::logger->Log("SkillComponent", "Failed to find skill id for (%i)!", entry.lot);
 
 		return;
 	}
 
-	const auto behaviorId = static_cast<uint32_t>(result.getIntField(0));
-
-	result.finalize();
-
 	auto* behavior = Behavior::CreateBehavior(behaviorId);
 
 	auto* bitStream = new RakNet::BitStream();
@@ -433,7 +514,7 @@ void SkillComponent::SyncProjectileCalculation(const ProjectileSyncEntry& entry)
 }
 
 void SkillComponent::HandleUnmanaged(const uint32_t behaviorId, const LWOOBJID target, LWOOBJID source) {
-	auto* context = new BehaviorContext(source);
+	auto* context = BehaviorContextPool::Instance()->Acquire(source);
 
 	context->unmanaged = true;
 	context->caster = target;
@@ -446,11 +527,11 @@ void SkillComponent::HandleUnmanaged(const uint32_t behaviorId, const LWOOBJID t
 
 	delete bitStream;
 
-	delete context;
+	BehaviorContextPool::Instance()->Release(context);
 }
 
 void SkillComponent::HandleUnCast(const uint32_t behaviorId, const LWOOBJID target) {
-	auto* context = new BehaviorContext(target);
+	auto* context = BehaviorContextPool::Instance()->Acquire(target);
 
 	context->caster = target;
 
@@ -458,7 +539,7 @@ void SkillComponent::HandleUnCast(const uint32_t behaviorId, const LWOOBJID targ
 
 	behavior->UnCast(context, { target });
 
-	delete context;
+	BehaviorContextPool::Instance()->Release(context);
 }
 
 SkillComponent::SkillComponent(Entity* parent) : Component(parent) {
@@ -186,15 +186,30 @@ public:
 
 private:
 	/**
-	 * All of the active skills mapped by their unique ID.
+	 * All of the active skills and their unique ID, in the order they were cast.
 	 */
-	std::map<uint32_t, BehaviorContext*> m_managedBehaviors;
+	std::vector<std::pair<uint32_t, BehaviorContext*>> m_managedBehaviors;
+
+	/**
+	 * The number of times the skills were reset, to notice a reset while updating them.
+	 */
+	uint32_t m_resetCount = 0;
 
 	/**
 	 * All active projectiles.
 	 */
 	std::vector<ProjectileSyncEntry> m_managedProjectiles;
 
+	/**
+	 * Index of each active projectile in m_managedProjectiles by its ID.
+	 */
+	std::unordered_map<LWOOBJID, size_t> m_projectileIndices;
+
+	/**
+	 * The number of active projectiles of each skill, skills are kept alive until their projectiles are done.
+	 */
+	std::unordered_map<BehaviorContext*, uint32_t> m_projectileCounts;
+
 	/**
 	 * Unique ID counter.
 	 */
@@ -205,11 +220,56 @@ private:
 	 */
 	static std::unordered_map<uint32_t, uint32_t> m_skillBehaviorCache;
 
+	/**
+	 * Cache for looking up the behavior id of a projectile via its LOT, -1 if it has none
+	 */
+	static std::unordered_map<LOT, uint32_t> m_projectileBehaviorCache;
+
 	/**
 	 * Sync a server-side projectile calculation.
 	 * @param entry the projectile information
 	 */
 	void SyncProjectileCalculation(const ProjectileSyncEntry& entry) const;
+
+	/**
+	 * Finds an active skill by its unique ID.
+	 * @param skillUid the unique ID of the skill
+	 * @return the context of the skill, or nullptr if it is not active
+	 */
+	BehaviorContext* FindBehavior(uint32_t skillUid) const;
+
+	/**
+	 * Starts managing a skill, replacing any active skill with the same unique ID.  A replaced skill with
+	 * projectiles still in flight is kept until they are done, FindBehavior finds the new skill first.
+	 * @param skillUid the unique ID of the skill
+	 * @param context the context of the skill, owned by this component until it is finished
+	 */
+	void ManageBehavior(uint32_t skillUid, BehaviorContext* context);
+
+	/**
+	 * Starts tracking a projectile, replacing any active projectile with the same ID.
+	 * @param entry the projectile information
+	 */
+	void AddProjectile(const ProjectileSyncEntry& entry);
+
+	/**
+	 * Stops tracking a projectile, moving the last projectile into its place.
+	 * @param index the index of the projectile in m_managedProjectiles
+	 */
+	void RemoveProjectile(size_t index);
+
+	/**
+	 * @param context the context of a skill
+	 * @return whether the skill has any active projectiles
+	 */
+	bool HasProjectiles(BehaviorContext* context) const;
+
+	/**
+	 * Looks up the behavior a projectile runs when it hits, caching the result.
+	 * @param lot the LOT of the projectile
+	 * @return the behavior id, or -1 if the projectile has no behavior
+	 */
+	static uint32_t GetProjectileBehavior(LOT lot);
 };
 
 #endif // SKILLCOMPONENT_H
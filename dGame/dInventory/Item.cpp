@@ -14,6 +14,7 @@
 #include "CharacterComponent.h"
 #include "eItemType.h"
 #include "AssetManager.h"
+#include "BrickCache.h"
 #include "InventoryComponent.h"
 #include "Loot.h"
 #include "eReplicaComponentType.h"
@@ -398,6 +399,9 @@ void Item::DisassembleModel() {
 	std::vector<std::string> renderAssetSplit = GeneralUtils::SplitString(renderAsset, '\\');
 
 	std::string lxfmlPath = "BrickModels/" + GeneralUtils::SplitString(renderAssetSplit.back(), '.').at(0) + ".lxfml";
+
+	result.finalize();
+
 	auto buffer = Game::assetManager->GetFileAsBuffer(lxfmlPath.c_str());
 
 	if (!buffer.m_Success) {
@@ -405,61 +409,17 @@ void Item::DisassembleModel() {
 		return;
 	}
 
-	std::istream file(&buffer);
-
-	result.finalize();
-
-	if (!file.good()) {
-		buffer.close();
-		return;
-	}
-
-	std::stringstream data;
-	data << file.rdbuf();
+	// The brick items are looked up by the design ID of each brick, not of the parts BrickDatabase holds
+	std::vector<uint32_t> parts;
+	const auto parsed = BrickCache::ParseDesignIds(buffer.m_Base, buffer.size(), parts);
 
 	buffer.close();
 
-	if (data.str().empty()) {
-		return;
-	}
-
-	auto* doc = new tinyxml2::XMLDocument();
-
-	if (!doc) {
-		return;
-	}
-
-	if (doc->Parse(data.str().c_str(), data.str().size()) != 0) {
-		return;
-	}
-
-	std::vector<int> parts;
-
-	auto* lxfml = doc->FirstChildElement("LXFML");
-	auto* bricks = lxfml->FirstChildElement("Bricks");
-	std::string searchTerm = "Brick";
-
-	if (!bricks) {
-		searchTerm = "Part";
-		bricks = lxfml->FirstChildElement("Scene")->FirstChildElement("Model")->FirstChildElement("Group");
-
-		if (!bricks) {
-			return;
-		}
-	}
-
-	auto* currentBrick = bricks->FirstChildElement(searchTerm.c_str());
-	while (currentBrick) {
-		if (currentBrick->Attribute("designID") != nullptr) {
-			parts.push_back(std::stoi(currentBrick->Attribute("designID")));
-		}
-
-		currentBrick = currentBrick->NextSiblingElement(searchTerm.c_str());
-	}
+	if (!parsed) return;
 
 	auto* brickIDTable = CDClientManager::Instance()->GetTable<CDBrickIDTableTable>("BrickIDTable");
 
-	for (unsigned int part : parts) {
+	for (const auto part : parts) {
 		const auto brickID = brickIDTable->Query([=](const CDBrickIDTable& entry) {
 			return entry.LEGOBrickID == part;
 			});
@@ -1,15 +1,17 @@
-#include <sstream>
-#include <fstream>
-
 #include "BrickDatabase.h"
 #include "Game.h"
 #include "AssetManager.h"
-#include "tinyxml2.h"
+#include "dLogger.h"
 
 std::vector<Brick> BrickDatabase::emptyCache{};
 BrickDatabase* BrickDatabase::m_Address = nullptr;
 
-BrickDatabase::BrickDatabase() = default;
+BrickDatabase::BrickDatabase() {
+	if (m_PersistentCache.Load(BrickCache::GetDefaultPath())) {
+		Game::logger->Log("BrickDatabase", "Loaded %llu pre-parsed models from the brick cache", static_cast<unsigned long long>(m_PersistentCache.GetEntryCount()));
+	}
+}
+
 BrickDatabase::~BrickDatabase() = default;
 
 std::vector<Brick>& BrickDatabase::GetBricks(const std::string& lxfmlPath) {
@@ -19,84 +21,26 @@ std::vector<Brick>& BrickDatabase::GetBricks(const std::string& lxfmlPath) {
 		return cached->second;
 	}
 
-	AssetMemoryBuffer buffer = Game::assetManager->GetFileAsBuffer((lxfmlPath).c_str());
+	std::vector<Brick> parts;
 
-	if (!buffer.m_Success) {
-		return emptyCache;
+	// The stamp comes from the pack index, so an up to date model is served without inflating it
+	uint32_t stamp = 0;
+	if (Game::assetManager->GetFileStamp(lxfmlPath.c_str(), &stamp) && m_PersistentCache.Find(lxfmlPath, stamp, parts)) {
+		return m_Cache[lxfmlPath] = std::move(parts);
 	}
 
-	std::istream file(&buffer);
-	if (!file.good()) {
+	AssetMemoryBuffer buffer = Game::assetManager->GetFileAsBuffer((lxfmlPath).c_str());
+
+	if (!buffer.m_Success) {
 		return emptyCache;
 	}
 
-	std::stringstream data;
-	data << file.rdbuf();
-	if (data.str().empty()) {
+	if (buffer.size() == 0 || !BrickCache::ParseLxfml(buffer.m_Base, buffer.size(), parts)) {
 		buffer.close();
 		return emptyCache;
 	}
 
 	buffer.close();
 
-	auto* doc = new tinyxml2::XMLDocument();
-	if (doc->Parse(data.str().c_str(), data.str().size()) != 0) {
-		delete doc;
-		return emptyCache;
-	}
-
-	std::vector<Brick> parts;
-
-	auto* lxfml = doc->FirstChildElement("LXFML");
-	auto* bricks = lxfml->FirstChildElement("Bricks");
-	std::string searchTerm = "Brick";
-
-	if (!bricks) {
-		searchTerm = "Part";
-		bricks = lxfml->FirstChildElement("Scene")->FirstChildElement("Model")->FirstChildElement("Group");
-
-		if (!bricks) {
-			return emptyCache;
-		}
-	}
-
-	auto* currentBrick = bricks->FirstChildElement(searchTerm.c_str());
-	while (currentBrick != nullptr) {
-
-		auto* part = currentBrick->FirstChildElement("Part");
-		if (part == nullptr) part = currentBrick;
-
-		if (part->Attribute("designID") != nullptr) {
-			Brick brick{ static_cast<uint32_t>(part->IntAttribute("designID")) };
-
-			// Depends on the file, some don't specify a list but just a single material
-			const auto* materialList = part->Attribute("materials");
-			const auto* materialID = part->Attribute("materialID");
-
-			if (materialList != nullptr) {
-				std::string materialString(materialList);
-				const auto materials = GeneralUtils::SplitString(materialString, ',');
-
-				if (!materials.empty()) {
-					brick.materialID = std::stoi(materials[0]);
-				} else {
-					brick.materialID = 0;
-				}
-			} else if (materialID != nullptr) {
-				brick.materialID = std::stoi(materialID);
-			} else {
-				brick.materialID = 0; // This is bad, makes it so the minigame can't be played
-			}
-
-			parts.push_back(brick);
-		}
-
-		currentBrick = currentBrick->NextSiblingElement(searchTerm.c_str());
-	}
-
-	m_Cache[lxfmlPath] = parts;
-
-	delete doc;
-
-	return m_Cache[lxfmlPath];
+	return m_Cache[lxfmlPath] = std::move(parts);
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "Entity.h"
+#include "BrickCache.h"
 
 class BrickDatabase
 {
@@ -21,6 +22,9 @@ public:
 private:
 	std::unordered_map<std::string, std::vector<Brick>> m_Cache;
 
+	// Bricks of every model parsed ahead of time, see BrickCache
+	BrickCache m_PersistentCache;
+
 	static std::vector<Brick> emptyCache;
 
 	static BrickDatabase* m_Address; //For singleton method
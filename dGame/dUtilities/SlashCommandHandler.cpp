@@ -1774,6 +1774,23 @@ void SlashCommandHandler::HandleChatCommand(const std::u16string& command, Entit
 			u"Process ID: " + GeneralUtils::to_u16string(Metrics::GetProcessID())
 		);
 
+		ChatPackets::SendSystemMessage(
+			sysAddr,
+			u"Asset cache: " + GeneralUtils::to_u16string(Game::assetManager->GetCacheHits()) +
+			u" hits, " + GeneralUtils::to_u16string(Game::assetManager->GetCacheMisses()) +
+			u" misses, " + GeneralUtils::to_u16string((float)((double)Game::assetManager->GetCacheSize() / 1.024e6)) +
+			u"MB"
+		);
+
+		for (const auto counter : Metrics::GetAllCounters()) {
+			ChatPackets::SendSystemMessage(
+				sysAddr,
+				GeneralUtils::ASCIIToUTF16(Metrics::MetricCounterToString(counter)) +
+				u": " +
+				GeneralUtils::to_u16string(Metrics::GetCounter(counter))
+			);
+		}
+
 		return;
 	}
 
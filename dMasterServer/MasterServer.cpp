@@ -3,6 +3,7 @@
 #include <ctime>
 #include <iostream>
 #include <map>
+#include <set>
 #include <string>
 #include <thread>
 #include <fstream>
@@ -41,6 +42,7 @@
 #include "PacketUtils.h"
 #include "dMessageIdentifiers.h"
 #include "FdbToSqlite.h"
+#include "BrickCache.h"
 
 namespace Game {
 	dLogger* logger = nullptr;
@@ -58,6 +60,7 @@ dLogger* SetupLogger();
 void StartAuthServer();
 void StartChatServer();
 void HandlePacket(Packet* packet);
+void BuildBrickCache();
 std::map<uint32_t, std::string> activeSessions;
 SystemAddress authServerMasterPeerSysAddr;
 SystemAddress chatServerMasterPeerSysAddr;
@@ -202,6 +205,15 @@ int main(int argc, char** argv) {
 		return EXIT_FAILURE;
 	}
 
+	// Pre-parse every brick model so world servers never have to parse their LXFML.
+	// Passing -b or --brick-cache rebuilds the cache and exits.  A cache of an older version is rebuilt as well.
+	const bool rebuildBrickCache = argc > 1 && (strcmp(argv[1], "-b") == 0 || strcmp(argv[1], "--brick-cache") == 0);
+	if (rebuildBrickCache || !BrickCache().Load(BrickCache::GetDefaultPath())) {
+		BuildBrickCache();
+
+		if (rebuildBrickCache) return EXIT_SUCCESS;
+	}
+
 	//If the first command line argument is -a or --account then make the user
 	//input a username and password, with the password being hidden.
 	if (argc > 1 &&
@@ -449,6 +461,48 @@ dLogger* SetupLogger() {
 	return new dLogger(logPath, logToConsole, logDebugStatements);
 }
 
+void BuildBrickCache() {
+	Game::logger->Log("MasterServer", "Building brick cache at %s", BrickCache::GetDefaultPath().string().c_str());
+	Game::logger->Flush();
+
+	const auto start = std::chrono::steady_clock::now();
+
+	std::set<std::string> lxfmlPaths;
+
+	// Every model a render component points at
+	auto renderAssets = CDClientDatabase::ExecuteQuery("SELECT DISTINCT render_asset FROM RenderComponent WHERE render_asset IS NOT NULL;");
+	while (!renderAssets.eof()) {
+		const auto renderAssetSplit = GeneralUtils::SplitString(renderAssets.getStringField(0), '\\');
+		const auto modelName = GeneralUtils::SplitString(renderAssetSplit.back(), '.');
+
+		if (!modelName.empty() && !modelName.at(0).empty()) {
+			const auto lxfmlPath = "BrickModels/" + modelName.at(0) + ".lxfml";
+			if (Game::assetManager->HasFile(lxfmlPath.c_str())) lxfmlPaths.insert(lxfmlPath);
+		}
+
+		renderAssets.nextRow();
+	}
+	renderAssets.finalize();
+
+	// Pet taming puzzles
+	auto puzzles = CDClientDatabase::ExecuteQuery("SELECT DISTINCT ValidPiecesLXF FROM TamingBuildPuzzles WHERE ValidPiecesLXF IS NOT NULL;");
+	while (!puzzles.eof()) {
+		lxfmlPaths.insert(puzzles.getStringField(0));
+		puzzles.nextRow();
+	}
+	puzzles.finalize();
+
+	const auto modelCount = BrickCache::Build(std::vector<std::string>(lxfmlPaths.begin(), lxfmlPaths.end()), BrickCache::GetDefaultPath());
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+	if (modelCount < 0) {
+		Game::logger->Log("MasterServer", "Failed to write the brick cache");
+		return;
+	}
+
+	Game::logger->Log("MasterServer", "Cached %i of %llu brick models in %lli ms", modelCount, static_cast<unsigned long long>(lxfmlPaths.size()), static_cast<long long>(elapsed));
+}
+
 void HandlePacket(Packet* packet) {
 	if (packet->data[0] == ID_DISCONNECTION_NOTIFICATION) {
 		Game::logger->Log("MasterServer", "A server has disconnected");
@@ -0,0 +1,199 @@
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//DLU Includes:
+#include "dLogger.h"
+#include "BinaryPathFinder.h"
+#include "GeneralUtils.h"
+
+//Navigation includes:
+#include "HeightGrid.h"
+#include "RawFile.h"
+#include "RawMesh.h"
+#include "TileBuilder.h"
+
+#include "Game.h"
+namespace Game {
+	dLogger* logger = nullptr;
+}
+
+dLogger* SetupLogger();
+bool ReadObj(const std::string& path, RawMesh& mesh);
+bool BuildHeightGrid(const std::string& navMeshPath);
+
+/**
+ * Builds a navmesh for dNavMesh from the terrain of a zone (.raw) and optionally scene geometry
+ * exported as Wavefront .obj files, along with the height grid of the navmesh.  Run it again after
+ * changing an input to only rebuild the tiles the change touched, or pass --full to rebuild every tile.
+ * Pass --heights followed by existing navmeshes to only build their height grids.
+ */
+int main(int argc, char** argv) {
+	Game::logger = SetupLogger();
+	if (!Game::logger) return EXIT_FAILURE;
+
+	std::string outputPath;
+	std::vector<std::string> inputPaths;
+	bool incremental = true;
+	bool heightsOnly = false;
+	uint32_t threadCount = 0;
+	TileBuildSettings settings;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string argument = argv[i];
+
+		if (argument == "--full") {
+			incremental = false;
+		} else if (argument == "--heights") {
+			heightsOnly = true;
+		} else if (argument == "--threads" && i + 1 < argc) {
+			threadCount = std::atoi(argv[++i]);
+		} else if (argument == "--cell-size" && i + 1 < argc) {
+			settings.cellSize = std::atof(argv[++i]);
+		} else if (argument == "--tile-size" && i + 1 < argc) {
+			settings.tileSize = std::atoi(argv[++i]);
+		} else if (outputPath.empty()) {
+			outputPath = argument;
+		} else {
+			inputPaths.push_back(argument);
+		}
+	}
+
+	if (heightsOnly && !outputPath.empty()) {
+		inputPaths.insert(inputPaths.begin(), outputPath);
+
+		auto success = true;
+		for (const auto& navMeshPath : inputPaths) {
+			success &= BuildHeightGrid(navMeshPath);
+		}
+
+		delete Game::logger;
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (outputPath.empty() || inputPaths.empty() || settings.cellSize <= 0 || settings.tileSize <= 0) {
+		Game::logger->Log("NavMeshBuilder", "Usage: NavMeshBuilder <output .bin> <terrain .raw | geometry .obj>... [--full] [--threads <count>] [--cell-size <size>] [--tile-size <cells>]");
+		Game::logger->Log("NavMeshBuilder", "       NavMeshBuilder --heights <navmesh .bin>...");
+		delete Game::logger;
+		return EXIT_FAILURE;
+	}
+
+	TileBuilder builder(settings);
+
+	for (const auto& inputPath : inputPaths) {
+		const auto isObj = inputPath.size() > 4 && GeneralUtils::CaseInsensitiveStringCompare(inputPath.substr(inputPath.size() - 4), ".obj");
+
+		if (isObj) {
+			RawMesh mesh;
+
+			if (!ReadObj(inputPath, mesh)) {
+				Game::logger->Log("NavMeshBuilder", "Failed to read geometry from %s", inputPath.c_str());
+				delete Game::logger;
+				return EXIT_FAILURE;
+			}
+
+			builder.AddMesh(mesh);
+		} else {
+			RawFile terrain(inputPath);
+
+			if (terrain.GetMesh() == nullptr) {
+				Game::logger->Log("NavMeshBuilder", "Failed to read terrain from %s", inputPath.c_str());
+				delete Game::logger;
+				return EXIT_FAILURE;
+			}
+
+			builder.AddMesh(*terrain.GetMesh());
+		}
+
+		Game::logger->Log("NavMeshBuilder", "Loaded %s", inputPath.c_str());
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	TileBuilder::Result result;
+	const auto written = builder.Build(outputPath, incremental, threadCount, result);
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+	Game::logger->Log("NavMeshBuilder", "Built %u tiles, reused %u, %u empty and %u failed in %lli ms", result.built, result.reused, result.empty, result.failed, static_cast<long long>(elapsed));
+
+	if (!written) {
+		Game::logger->Log("NavMeshBuilder", "Failed to write the navmesh to %s", outputPath.c_str());
+		delete Game::logger;
+		return EXIT_FAILURE;
+	}
+
+	Game::logger->Log("NavMeshBuilder", "Wrote the navmesh to %s", outputPath.c_str());
+
+	// World servers fall back to querying the navmesh without a grid, so the navmesh is still usable
+	BuildHeightGrid(outputPath);
+
+	delete Game::logger;
+	return EXIT_SUCCESS;
+}
+
+bool BuildHeightGrid(const std::string& navMeshPath) {
+	const auto start = std::chrono::steady_clock::now();
+
+	if (!HeightGrid::BuildFromFile(navMeshPath)) {
+		Game::logger->Log("NavMeshBuilder", "Failed to build the height grid of %s", navMeshPath.c_str());
+		return false;
+	}
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+	Game::logger->Log("NavMeshBuilder", "Wrote the height grid to %s in %lli ms", HeightGrid::GetPath(navMeshPath).string().c_str(), static_cast<long long>(elapsed));
+
+	return true;
+}
+
+dLogger* SetupLogger() {
+	std::string logPath = (BinaryPathFinder::GetBinaryDir() / ("logs/NavMeshBuilder_" + std::to_string(time(nullptr)) + ".log")).string();
+
+	return new dLogger(logPath, true, false);
+}
+
+bool ReadObj(const std::string& path, RawMesh& mesh) {
+	std::ifstream file(path);
+	if (!file.is_open()) return false;
+
+	std::string line;
+
+	while (std::getline(file, line)) {
+		std::istringstream stream(line);
+		std::string type;
+		stream >> type;
+
+		if (type == "v") {
+			NiPoint3 vertex;
+			stream >> vertex.x >> vertex.y >> vertex.z;
+
+			mesh.m_Vertices.push_back(vertex);
+		} else if (type == "f") {
+			// Faces are fans of vertex indices, which count from 1 or back from the end when negative
+			std::vector<uint32_t> face;
+			std::string corner;
+
+			while (stream >> corner) {
+				const auto index = std::atoi(corner.c_str());
+				const auto resolved = index < 0 ? static_cast<int64_t>(mesh.m_Vertices.size()) + index : static_cast<int64_t>(index) - 1;
+
+				if (resolved < 0 || resolved >= static_cast<int64_t>(mesh.m_Vertices.size())) return false;
+
+				face.push_back(static_cast<uint32_t>(resolved));
+			}
+
+			for (size_t i = 2; i < face.size(); ++i) {
+				mesh.m_Triangles.push_back(face[0]);
+				mesh.m_Triangles.push_back(face[i - 1]);
+				mesh.m_Triangles.push_back(face[i]);
+			}
+		}
+	}
+
+	return !mesh.m_Triangles.empty();
+}
@@ -0,0 +1,147 @@
+#include "CrowdManager.h"
+
+#include <cstring>
+
+#include "DetourCrowd.h"
+#include "DetourNavMeshQuery.h"
+#include "Metrics.hpp"
+
+CrowdManager::CrowdManager(dtNavMesh* navMesh, const int32_t maxAgents) {
+	m_MaxAgents = maxAgents;
+
+	m_Crowd = dtAllocCrowd();
+
+	if (!m_Crowd->init(maxAgents, AGENT_RADIUS, navMesh)) {
+		dtFreeCrowd(m_Crowd);
+		m_Crowd = nullptr;
+
+		return;
+	}
+
+	// Agents only use the first avoidance setting, which samples velocities adaptively around the desired one
+	dtObstacleAvoidanceParams avoidance;
+	std::memcpy(&avoidance, m_Crowd->getObstacleAvoidanceParams(0), sizeof(avoidance));
+
+	avoidance.velBias = 0.5f;
+	avoidance.adaptiveDivs = 5;
+	avoidance.adaptiveRings = 2;
+	avoidance.adaptiveDepth = 1;
+
+	m_Crowd->setObstacleAvoidanceParams(0, &avoidance);
+}
+
+CrowdManager::~CrowdManager() {
+	if (m_Crowd) dtFreeCrowd(m_Crowd);
+}
+
+int32_t CrowdManager::AddAgent(const NiPoint3& position, const float maxSpeed) {
+	if (m_Crowd == nullptr) return INVALID_AGENT;
+
+	dtCrowdAgentParams params{};
+	params.radius = AGENT_RADIUS;
+	params.height = AGENT_HEIGHT;
+	params.maxSpeed = maxSpeed;
+	params.maxAcceleration = maxSpeed * 8.0f;
+	params.collisionQueryRange = AGENT_RADIUS * 12.0f;
+	params.pathOptimizationRange = AGENT_RADIUS * 30.0f;
+	params.separationWeight = 2.0f;
+	params.updateFlags = DT_CROWD_ANTICIPATE_TURNS | DT_CROWD_OPTIMIZE_VIS | DT_CROWD_OPTIMIZE_TOPO | DT_CROWD_OBSTACLE_AVOIDANCE | DT_CROWD_SEPARATION;
+	params.obstacleAvoidanceType = 0;
+	params.queryFilterType = 0;
+
+	const float pos[3] = { position.x, position.y, position.z };
+
+	const auto agent = m_Crowd->addAgent(pos, &params);
+
+	if (agent < 0) return INVALID_AGENT;
+
+	// The crowd adds agents off the navmesh too, they just never move
+	if (m_Crowd->getAgent(agent)->state == DT_CROWDAGENT_STATE_INVALID) {
+		m_Crowd->removeAgent(agent);
+
+		return INVALID_AGENT;
+	}
+
+	++m_AgentCount;
+
+	return agent;
+}
+
+void CrowdManager::RemoveAgent(const int32_t agent) {
+	if (!IsValid(agent)) return;
+
+	m_Crowd->removeAgent(agent);
+
+	--m_AgentCount;
+}
+
+void CrowdManager::SetMaxSpeed(const int32_t agent, const float maxSpeed) {
+	if (!IsValid(agent)) return;
+
+	auto params = m_Crowd->getAgent(agent)->params;
+
+	if (params.maxSpeed == maxSpeed) return;
+
+	params.maxSpeed = maxSpeed;
+	params.maxAcceleration = maxSpeed * 8.0f;
+
+	m_Crowd->updateAgentParameters(agent, &params);
+}
+
+bool CrowdManager::SetTarget(const int32_t agent, const NiPoint3& target) {
+	if (!IsValid(agent)) return false;
+
+	const float pos[3] = { target.x, target.y, target.z };
+	float nearest[3];
+	dtPolyRef targetRef = 0;
+
+	m_Crowd->getNavMeshQuery()->findNearestPoly(pos, m_Crowd->getQueryHalfExtents(), m_Crowd->getFilter(0), &targetRef, nearest);
+
+	if (!targetRef) return false;
+
+	return m_Crowd->requestMoveTarget(agent, targetRef, nearest);
+}
+
+void CrowdManager::ResetTarget(const int32_t agent) {
+	if (!IsValid(agent)) return;
+
+	m_Crowd->resetMoveTarget(agent);
+}
+
+bool CrowdManager::GetState(const int32_t agent, NiPoint3& position, NiPoint3& velocity) const {
+	if (!IsValid(agent)) return false;
+
+	const auto* crowdAgent = m_Crowd->getAgent(agent);
+
+	position = NiPoint3(crowdAgent->npos[0], crowdAgent->npos[1], crowdAgent->npos[2]);
+	velocity = NiPoint3(crowdAgent->vel[0], crowdAgent->vel[1], crowdAgent->vel[2]);
+
+	return true;
+}
+
+bool CrowdManager::HasStopped(const int32_t agent) const {
+	if (!IsValid(agent)) return false;
+
+	const auto* crowdAgent = m_Crowd->getAgent(agent);
+
+	if (crowdAgent->targetState == DT_CROWDAGENT_TARGET_FAILED) return true;
+
+	// Agents accelerate from the first update with a path, so standing still means there is nowhere left to go
+	if (crowdAgent->targetState != DT_CROWDAGENT_TARGET_VALID) return false;
+
+	const auto* velocity = crowdAgent->vel;
+
+	return velocity[0] * velocity[0] + velocity[1] * velocity[1] + velocity[2] * velocity[2] < STOPPED_SPEED * STOPPED_SPEED;
+}
+
+void CrowdManager::Update(const float deltaTime) {
+	if (m_Crowd == nullptr) return;
+
+	m_Crowd->update(deltaTime, nullptr);
+
+	Metrics::SetCounter(MetricCounter::CrowdAgents, m_AgentCount);
+}
+
+bool CrowdManager::IsValid(const int32_t agent) const {
+	return m_Crowd != nullptr && agent >= 0 && agent < m_MaxAgents && m_Crowd->getAgent(agent)->active;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+
+#include "NiPoint3.h"
+
+class dtCrowd;
+class dtNavMesh;
+
+/**
+ * Moves the enemies of a zone across the navmesh together, built on Detour's crowd.  Every agent is
+ * stepped once per frame in a single batch: the crowd spreads path searches for new targets over a few
+ * frames, keeps each agent's path corridor up to date as it moves instead of searching again and steers
+ * agents around each other using a shared proximity grid.
+ *
+ * Agents are handles into the crowd, which has room for a fixed number of them.  Only call from the main thread.
+ */
+class CrowdManager {
+public:
+	static constexpr int32_t INVALID_AGENT = -1;
+
+	/**
+	 * Radius every agent is given, the crowd needs to know the largest one up front
+	 */
+	static constexpr float AGENT_RADIUS = 1.0f;
+
+	static constexpr float AGENT_HEIGHT = 2.0f;
+
+	/**
+	 * @param navMesh The navmesh to move on, must outlive the manager
+	 * @param maxAgents How many agents the crowd has room for
+	 */
+	CrowdManager(dtNavMesh* navMesh, int32_t maxAgents);
+	~CrowdManager();
+
+	CrowdManager(const CrowdManager&) = delete;
+	CrowdManager& operator=(const CrowdManager&) = delete;
+
+	/**
+	 * Adds an agent standing still at a position
+	 *
+	 * @param maxSpeed The speed the agent may move at, in units per second
+	 * @return The agent, or INVALID_AGENT if the crowd is full or the position is not on the navmesh
+	 */
+	int32_t AddAgent(const NiPoint3& position, float maxSpeed);
+
+	void RemoveAgent(int32_t agent);
+
+	void SetMaxSpeed(int32_t agent, float maxSpeed);
+
+	/**
+	 * Makes an agent move to a target, the path to it is found over the next frames
+	 *
+	 * @return Whether or not the target is on the navmesh
+	 */
+	bool SetTarget(int32_t agent, const NiPoint3& target);
+
+	/**
+	 * Makes an agent stop where it is
+	 */
+	void ResetTarget(int32_t agent);
+
+	/**
+	 * @param position Set to where the agent is on the navmesh
+	 * @param velocity Set to the velocity the agent moved at in the last update
+	 * @return Whether or not the agent exists
+	 */
+	bool GetState(int32_t agent, NiPoint3& position, NiPoint3& velocity) const;
+
+	/**
+	 * @return Whether or not the agent gave up on its target, because no path was found or because it came
+	 * to a halt at the end of a path falling short of the target
+	 */
+	bool HasStopped(int32_t agent) const;
+
+	/**
+	 * Moves every agent, call once per frame
+	 */
+	void Update(float deltaTime);
+
+	int32_t GetAgentCount() const { return m_AgentCount; }
+
+private:
+	/**
+	 * Agents moving slower than this are considered to stand still
+	 */
+	static constexpr float STOPPED_SPEED = 0.01f;
+
+	bool IsValid(int32_t agent) const;
+
+	dtCrowd* m_Crowd = nullptr;
+
+	int32_t m_MaxAgents;
+
+	int32_t m_AgentCount = 0;
+};
@@ -0,0 +1,259 @@
+#include "HeightGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "Crc32.h"
+#include "DetourExtensions.h"
+#include "Metrics.hpp"
+#include "WorkerPool.h"
+
+bool HeightGrid::Load(const std::filesystem::path& path, const uint32_t navMeshCrc) {
+	m_Header = nullptr;
+	m_Samples = nullptr;
+
+	if (!m_File.Open(path)) return false;
+
+	const auto* header = reinterpret_cast<const Header*>(m_File.GetData());
+
+	if (m_File.GetSize() < sizeof(Header)
+		|| std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+		|| header->version != VERSION
+		|| header->navMeshCrc != navMeshCrc
+		|| m_File.GetSize() != sizeof(Header) + static_cast<uint64_t>(header->width) * header->depth * sizeof(uint16_t)
+		|| header->width < 2 || header->depth < 2) {
+		m_File.Close();
+
+		return false;
+	}
+
+	m_Header = header;
+	m_Samples = reinterpret_cast<const uint16_t*>(m_File.GetData() + sizeof(Header));
+
+	return true;
+}
+
+bool HeightGrid::Build(const dtNavMesh* navMesh, const uint32_t navMeshCrc, const std::filesystem::path& path, float cellSize) {
+	float min[3] = { INFINITY, INFINITY, INFINITY };
+	float max[3] = { -INFINITY, -INFINITY, -INFINITY };
+
+	for (int i = 0; i < navMesh->getMaxTiles(); ++i) {
+		const auto* tile = navMesh->getTile(i);
+		if (tile == nullptr || tile->header == nullptr) continue;
+
+		for (int axis = 0; axis < 3; ++axis) {
+			min[axis] = std::min(min[axis], tile->header->bmin[axis]);
+			max[axis] = std::max(max[axis], tile->header->bmax[axis]);
+		}
+	}
+
+	if (!(min[0] <= max[0] && min[2] <= max[2])) return false;
+
+	uint32_t width;
+	uint32_t depth;
+
+	while (true) {
+		width = static_cast<uint32_t>(std::ceil((max[0] - min[0]) / cellSize)) + 2;
+		depth = static_cast<uint32_t>(std::ceil((max[2] - min[2]) / cellSize)) + 2;
+
+		if (static_cast<uint64_t>(width) * depth <= MAX_SAMPLES) break;
+
+		cellSize *= 2.0f;
+	}
+
+	Header header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.navMeshCrc = navMeshCrc;
+	header.width = width;
+	header.depth = depth;
+	header.minX = min[0];
+	header.minZ = min[2];
+	header.cellSize = cellSize;
+	header.minY = min[1];
+	header.heightStep = max[1] > min[1] ? (max[1] - min[1]) / (NO_SAMPLE - 1) : 1.0f;
+
+	std::vector<uint16_t> samples(static_cast<size_t>(width) * depth, NO_SAMPLE);
+
+	// Searching down from above the navmesh finds the top most surface at every sample
+	const float searchExtents[3] = { cellSize * 0.5f, max[1] - min[1] + 2.0f, cellSize * 0.5f };
+	const auto searchHeight = max[1] + 1.0f;
+
+	constexpr uint32_t ROWS_PER_TASK = 32;
+
+	WorkerPool workers;
+
+	workers.Run((depth + ROWS_PER_TASK - 1) / ROWS_PER_TASK, [&](size_t task) {
+		auto* query = dtAllocNavMeshQuery();
+		query->init(navMesh, 512);
+
+		dtQueryFilter filter{};
+
+		const auto firstRow = static_cast<uint32_t>(task) * ROWS_PER_TASK;
+		const auto lastRow = std::min(firstRow + ROWS_PER_TASK, depth);
+
+		for (auto z = firstRow; z < lastRow; ++z) {
+			for (uint32_t x = 0; x < width; ++x) {
+				float position[3] = { header.minX + x * cellSize, searchHeight, header.minZ + z * cellSize };
+
+				dtPolyRef polyRef = 0;
+				query->findNearestPoly(position, searchExtents, &filter, &polyRef, nullptr);
+				if (!polyRef) continue;
+
+				float height = 0.0f;
+				if (dtStatusFailed(query->getPolyHeight(polyRef, position, &height))) continue;
+
+				const auto step = std::round((height - header.minY) / header.heightStep);
+
+				samples[static_cast<size_t>(z) * width + x] = static_cast<uint16_t>(std::clamp(step, 0.0f, static_cast<float>(NO_SAMPLE - 1)));
+			}
+		}
+
+		dtFreeNavMeshQuery(query);
+	});
+
+	std::error_code error;
+	std::filesystem::create_directories(path.parent_path(), error);
+
+	// Write to a temporary file first so world servers never map a half written grid
+	auto tempPath = path;
+	tempPath += "." + std::to_string(Metrics::GetProcessID()) + ".tmp";
+
+	{
+		std::ofstream file(tempPath, std::ios::binary);
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(uint16_t));
+		file.close();
+
+		if (file.fail()) {
+			std::filesystem::remove(tempPath, error);
+
+			return false;
+		}
+	}
+
+	std::filesystem::rename(tempPath, path, error);
+
+	if (error) {
+		std::filesystem::remove(tempPath, error);
+
+		return false;
+	}
+
+	return true;
+}
+
+bool HeightGrid::BuildFromFile(const std::filesystem::path& navMeshPath, const float cellSize) {
+	MappedFile file(navMeshPath);
+	if (!file.IsOpen()) return false;
+
+	const auto* data = file.GetData();
+	const auto size = file.GetSize();
+
+	NavMeshSetHeader header;
+	if (size < sizeof(header)) return false;
+
+	std::memcpy(&header, data, sizeof(header));
+	if (header.magic != NAVMESHSET_MAGIC || header.version != NAVMESHSET_VERSION) return false;
+
+	auto* navMesh = dtAllocNavMesh();
+	if (!navMesh) return false;
+
+	if (dtStatusFailed(navMesh->init(&header.params))) {
+		dtFreeNavMesh(navMesh);
+
+		return false;
+	}
+
+	size_t offset = sizeof(header);
+
+	for (int i = 0; i < header.numTiles; ++i) {
+		NavMeshTileHeader tileHeader;
+		if (offset + sizeof(tileHeader) > size) break;
+
+		std::memcpy(&tileHeader, data + offset, sizeof(tileHeader));
+		offset += sizeof(tileHeader);
+
+		if (!tileHeader.tileRef || tileHeader.dataSize <= 0 || offset + tileHeader.dataSize > size) break;
+
+		auto* tileData = static_cast<unsigned char*>(dtAlloc(tileHeader.dataSize, DT_ALLOC_PERM));
+		if (!tileData) break;
+
+		std::memcpy(tileData, data + offset, tileHeader.dataSize);
+		offset += tileHeader.dataSize;
+
+		if (dtStatusFailed(navMesh->addTile(tileData, tileHeader.dataSize, DT_TILE_FREE_DATA, tileHeader.tileRef, nullptr))) dtFree(tileData);
+	}
+
+	const auto built = Build(navMesh, CalculateNavMeshCrc(data, size), GetPath(navMeshPath), cellSize);
+
+	dtFreeNavMesh(navMesh);
+
+	return built;
+}
+
+std::filesystem::path HeightGrid::GetPath(const std::filesystem::path& navMeshPath) {
+	auto path = navMeshPath;
+
+	return path.replace_extension(".heights");
+}
+
+uint32_t HeightGrid::CalculateNavMeshCrc(const char* data, const size_t size) {
+	return Crc32::Calculate(0xFFFFFFFF, reinterpret_cast<const uint8_t*>(data), size);
+}
+
+bool HeightGrid::GetHeight(const NiPoint3& location, float& height) const {
+	if (m_Header == nullptr) return false;
+
+	const auto& header = *m_Header;
+
+	const auto gridX = (location.x - header.minX) / header.cellSize;
+	const auto gridZ = (location.z - header.minZ) / header.cellSize;
+
+	// Also rejects NaN, the last row and column have no neighbours to interpolate with
+	if (!(gridX >= 0.0f && gridX < header.width - 1 && gridZ >= 0.0f && gridZ < header.depth - 1)) return false;
+
+	const auto x = static_cast<uint32_t>(gridX);
+	const auto z = static_cast<uint32_t>(gridZ);
+
+	const auto* samples = m_Samples + static_cast<size_t>(z) * header.width + x;
+
+	const uint16_t corners[4] = { samples[0], samples[1], samples[header.width], samples[header.width + 1] };
+
+	float heights[4];
+
+	for (int i = 0; i < 4; ++i) {
+		// Off the edge of the navmesh
+		if (corners[i] == NO_SAMPLE) return false;
+
+		heights[i] = header.minY + corners[i] * header.heightStep;
+	}
+
+	const auto [lowest, highest] = std::minmax({ heights[0], heights[1], heights[2], heights[3] });
+
+	if (highest - lowest > header.cellSize * MAX_CELL_STEP_FACTOR) return false;
+
+	const auto factorX = gridX - x;
+	const auto factorZ = gridZ - z;
+
+	const auto nearHeight = heights[0] + (heights[1] - heights[0]) * factorX;
+	const auto farHeight = heights[2] + (heights[3] - heights[2]) * factorX;
+
+	const auto result = nearHeight + (farHeight - nearHeight) * factorZ;
+
+	if (std::abs(result - location.y) > MAX_HEIGHT_DIFFERENCE) return false;
+
+	height = result;
+
+	return true;
+}
+
+uint64_t HeightGrid::GetSampleCount() const {
+	if (m_Header == nullptr) return 0;
+
+	return static_cast<uint64_t>(m_Header->width) * m_Header->depth;
+}
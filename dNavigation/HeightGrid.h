@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+#include "MappedFile.h"
+#include "NiPoint3.h"
+
+class dtNavMesh;
+
+/**
+ * The height of the navmesh sampled on a regular grid over the x/z plane, so the height below a point
+ * is a bilinear lookup instead of a navmesh query.  The grid is built offline by the NavMeshBuilder next
+ * to the navmesh it samples, and mapped from disk by every world server running the zone.
+ *
+ * Only the top most surface is sampled, so lookups refuse to answer near the edges of the navmesh,
+ * across steps too steep to walk and for points far from the sampled surface (under a bridge, in a cave).
+ * Callers fall back to the navmesh query when they do.
+ *
+ * File layout (little endian): Header, followed by width * depth uint16 samples, row by row along z.
+ */
+class HeightGrid {
+public:
+	static constexpr char MAGIC[4] = { 'H', 'G', 'R', 'D' };
+
+	/**
+	 * Bump this whenever the layout or the way samples are taken changes
+	 */
+	static constexpr uint32_t VERSION = 1;
+
+	/**
+	 * Distance between samples when building a grid
+	 */
+	static constexpr float DEFAULT_CELL_SIZE = 1.0f;
+
+	/**
+	 * Maps a grid from disk
+	 *
+	 * @param navMeshCrc The crc of the navmesh file, a grid built from any other navmesh is rejected
+	 * @return Whether or not the grid was loaded
+	 */
+	bool Load(const std::filesystem::path& path, uint32_t navMeshCrc);
+
+	/**
+	 * Samples a navmesh and writes the grid to disk, spreading the sampling over every core
+	 *
+	 * @return Whether or not the grid was written
+	 */
+	static bool Build(const dtNavMesh* navMesh, uint32_t navMeshCrc, const std::filesystem::path& path, float cellSize = DEFAULT_CELL_SIZE);
+
+	/**
+	 * Reads a navmesh file and builds its grid, see GetPath for where it is written
+	 *
+	 * @return Whether or not the grid was written
+	 */
+	static bool BuildFromFile(const std::filesystem::path& navMeshPath, float cellSize = DEFAULT_CELL_SIZE);
+
+	/**
+	 * @return Where the grid of a navmesh file is stored, next to it with the extension .heights
+	 */
+	static std::filesystem::path GetPath(const std::filesystem::path& navMeshPath);
+
+	/**
+	 * @return The crc a grid stores of the navmesh file it was built from
+	 */
+	static uint32_t CalculateNavMeshCrc(const char* data, size_t size);
+
+	/**
+	 * Finds the height of the navmesh below a point
+	 *
+	 * @param height Set to the height if one was found
+	 * @return Whether or not the grid could answer, false means the navmesh has to be queried instead
+	 */
+	bool GetHeight(const NiPoint3& location, float& height) const;
+
+	bool IsLoaded() const { return m_Header != nullptr; }
+
+	uint64_t GetSampleCount() const;
+
+private:
+	/**
+	 * Samples further apart in height than this within one cell mark a ledge or overlapping floors
+	 */
+	static constexpr float MAX_CELL_STEP_FACTOR = 2.0f;
+
+	/**
+	 * Points further from the sampled surface than this are likely on another floor
+	 */
+	static constexpr float MAX_HEIGHT_DIFFERENCE = 8.0f;
+
+	static constexpr uint16_t NO_SAMPLE = 0xFFFF;
+
+	/**
+	 * Grids covering more samples than this are built with larger cells
+	 */
+	static constexpr uint64_t MAX_SAMPLES = 16 * 1024 * 1024;
+
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t navMeshCrc;
+		uint32_t width;
+		uint32_t depth;
+		float minX;
+		float minZ;
+		float cellSize;
+		float minY;
+		float heightStep; // Samples are stored as steps above minY
+	};
+
+	MappedFile m_File;
+	const Header* m_Header = nullptr;
+	const uint16_t* m_Samples = nullptr;
+};
@@ -0,0 +1,183 @@
+#include "PathfindingService.h"
+
+#include "DetourNavMeshQuery.h"
+#include "dNavMesh.h"
+#include "Metrics.hpp"
+
+PathfindingService::PathfindingService(const dtNavMesh* navMesh, const uint32_t threadCount) {
+	m_NavMesh = navMesh;
+
+	const auto count = threadCount > 0 ? threadCount : 1;
+
+	m_Threads.reserve(count);
+
+	for (uint32_t i = 0; i < count; ++i) {
+		m_Threads.emplace_back(&PathfindingService::WorkerMain, this);
+	}
+}
+
+PathfindingService::~PathfindingService() {
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopping = true;
+	}
+
+	m_Condition.notify_all();
+
+	for (auto& thread : m_Threads) {
+		thread.join();
+	}
+}
+
+PathfindingService::Ticket PathfindingService::RequestPath(const NiPoint3& start, const NiPoint3& end) {
+	Metrics::AddToCounter(MetricCounter::PathRequests, 1);
+
+	const auto key = SegmentKey::Create(start, end, PATH_CACHE_STEP);
+	const auto ticket = ++m_NextTicket;
+
+	const auto cached = m_Cache.find(key);
+
+	if (cached != m_Cache.end()) {
+		m_CacheOrder.splice(m_CacheOrder.begin(), m_CacheOrder, cached->second.lruPosition);
+		m_ReadyTickets[ticket] = FinishedPath{ cached->second.path, m_Frame };
+		Metrics::AddToCounter(MetricCounter::PathCacheHits, 1);
+
+		return ticket;
+	}
+
+	const auto running = m_Jobs.find(key);
+
+	if (running != m_Jobs.end()) {
+		running->second->tickets.push_back(ticket);
+		m_PendingTickets[ticket] = running->second;
+		Metrics::AddToCounter(MetricCounter::PathRequestsMerged, 1);
+
+		return ticket;
+	}
+
+	auto job = std::make_shared<Job>();
+	job->key = key;
+	job->start = start;
+	job->end = end;
+	job->tickets.push_back(ticket);
+
+	m_Jobs[key] = job;
+	m_PendingTickets[ticket] = job;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Queue.push_back(std::move(job));
+	}
+
+	m_Condition.notify_one();
+
+	return ticket;
+}
+
+PathfindingService::PathStatus PathfindingService::TakePath(const Ticket ticket, std::vector<NiPoint3>& path) {
+	const auto ready = m_ReadyTickets.find(ticket);
+
+	if (ready != m_ReadyTickets.end()) {
+		path = *ready->second.path;
+		m_ReadyTickets.erase(ready);
+
+		return PathStatus::Ready;
+	}
+
+	if (m_PendingTickets.find(ticket) != m_PendingTickets.end()) return PathStatus::Pending;
+
+	return PathStatus::Missing;
+}
+
+void PathfindingService::Cancel(const Ticket ticket) {
+	m_PendingTickets.erase(ticket);
+	m_ReadyTickets.erase(ticket);
+}
+
+void PathfindingService::Update() {
+	++m_Frame;
+
+	// Paths are kept for one frame after being handed out, anything older was never collected
+	for (auto it = m_ReadyTickets.begin(); it != m_ReadyTickets.end();) {
+		if (m_Frame - it->second.frame > 1) {
+			it = m_ReadyTickets.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	std::vector<std::shared_ptr<Job>> finished;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		finished.swap(m_Finished);
+	}
+
+	for (const auto& job : finished) {
+		Path path = std::make_shared<const std::vector<NiPoint3>>(std::move(job->path));
+
+		CachePath(job->key, path);
+
+		m_Jobs.erase(job->key);
+
+		for (const auto ticket : job->tickets) {
+			// Cancelled while the job was running
+			if (m_PendingTickets.erase(ticket) == 0) continue;
+
+			m_ReadyTickets[ticket] = FinishedPath{ path, m_Frame };
+		}
+	}
+
+	Metrics::AddToCounter(MetricCounter::PathsComputed, finished.size());
+}
+
+void PathfindingService::CachePath(const SegmentKey& key, const Path& path) {
+	const auto existing = m_Cache.find(key);
+
+	if (existing != m_Cache.end()) {
+		existing->second.path = path;
+		m_CacheOrder.splice(m_CacheOrder.begin(), m_CacheOrder, existing->second.lruPosition);
+
+		return;
+	}
+
+	if (m_Cache.size() >= MAX_CACHED_PATHS && !m_CacheOrder.empty()) {
+		m_Cache.erase(m_CacheOrder.back());
+		m_CacheOrder.pop_back();
+	}
+
+	m_CacheOrder.push_front(key);
+	m_Cache.emplace(key, CachedPath{ path, m_CacheOrder.begin() });
+}
+
+void PathfindingService::WorkerMain() {
+	auto* query = dtAllocNavMeshQuery();
+	query->init(m_NavMesh, 2048);
+
+	while (true) {
+		std::shared_ptr<Job> job;
+
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Condition.wait(lock, [this]() { return m_Stopping || !m_Queue.empty(); });
+
+			if (m_Stopping) break;
+
+			job = std::move(m_Queue.front());
+			m_Queue.pop_front();
+		}
+
+		job->path = dNavMesh::FindPath(query, job->start, job->end);
+
+		for (auto& point : job->path) {
+			point.y = dNavMesh::GetHeightAtPoint(query, point);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Finished.push_back(std::move(job));
+		}
+	}
+
+	dtFreeNavMeshQuery(query);
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "NiPoint3.h"
+#include "SegmentKey.h"
+
+class dtNavMesh;
+
+/**
+ * Finds paths across the navmesh on worker threads, so an entity asking for a path does not stall the frame.
+ * Every worker owns its own dtNavMeshQuery, the navmesh itself is only read.
+ *
+ * Requests are keyed by their endpoints rounded to PATH_CACHE_STEP.  A request matching one that is still
+ * being worked on shares its result, and a request matching a finished one is answered from the cache
+ * right away.  Finished paths are handed out by Update, which the main thread calls once per frame,
+ * and are kept around for one more frame to be collected with TakePath.
+ *
+ * Only the workers may touch the navmesh queries, everything else must be called from the main thread.
+ */
+class PathfindingService {
+public:
+	using Ticket = uint64_t;
+
+	enum class PathStatus : uint8_t {
+		Pending,
+		Ready,
+		Missing // Never requested, cancelled, already taken or not collected in time
+	};
+
+	/**
+	 * @param navMesh The navmesh to search, must outlive the service
+	 * @param threadCount How many workers to start, at least one is always started
+	 */
+	PathfindingService(const dtNavMesh* navMesh, uint32_t threadCount);
+	~PathfindingService();
+
+	PathfindingService(const PathfindingService&) = delete;
+	PathfindingService& operator=(const PathfindingService&) = delete;
+
+	/**
+	 * Asks for a path, the points of which have their height snapped to the navmesh
+	 *
+	 * @return The ticket to collect the path with
+	 */
+	Ticket RequestPath(const NiPoint3& start, const NiPoint3& end);
+
+	/**
+	 * Collects a requested path, it can only be taken once
+	 *
+	 * @param path Set to the found path if it is ready, empty if no path was found
+	 */
+	PathStatus TakePath(Ticket ticket, std::vector<NiPoint3>& path);
+
+	/**
+	 * Forgets a request, its path will still be computed and cached if it was already queued
+	 */
+	void Cancel(Ticket ticket);
+
+	/**
+	 * Hands out the paths the workers finished since the last call, call once per frame
+	 */
+	void Update();
+
+	uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Threads.size()); }
+
+private:
+	/**
+	 * Size of the steps endpoints are rounded to when matching requests
+	 */
+	static constexpr float PATH_CACHE_STEP = 1.0f;
+
+	/**
+	 * Once the cache holds this many paths, the least recently used one is evicted for every new path
+	 */
+	static constexpr size_t MAX_CACHED_PATHS = 4096;
+
+	using Path = std::shared_ptr<const std::vector<NiPoint3>>;
+
+	struct CachedPath {
+		Path path;
+		std::list<SegmentKey>::iterator lruPosition;
+	};
+
+	struct Job {
+		SegmentKey key;
+		NiPoint3 start;
+		NiPoint3 end;
+
+		// Written by the worker, read by the main thread once the job is finished
+		std::vector<NiPoint3> path;
+
+		// Main thread only
+		std::vector<Ticket> tickets;
+	};
+
+	struct FinishedPath {
+		Path path;
+		uint32_t frame;
+	};
+
+	void WorkerMain();
+
+	/**
+	 * Adds a finished path to the cache, evicting the least recently used path if the cache is full
+	 */
+	void CachePath(const SegmentKey& key, const Path& path);
+
+	const dtNavMesh* m_NavMesh;
+
+	std::vector<std::thread> m_Threads;
+
+	// Shared with the workers
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	std::deque<std::shared_ptr<Job>> m_Queue;
+	std::vector<std::shared_ptr<Job>> m_Finished;
+	bool m_Stopping = false;
+
+	// Main thread only
+	Ticket m_NextTicket = 0;
+	uint32_t m_Frame = 0;
+	std::unordered_map<SegmentKey, std::shared_ptr<Job>, SegmentKeyHash> m_Jobs;
+	std::unordered_map<Ticket, std::shared_ptr<Job>> m_PendingTickets;
+	std::unordered_map<Ticket, FinishedPath> m_ReadyTickets;
+	std::unordered_map<SegmentKey, CachedPath, SegmentKeyHash> m_Cache;
+	std::list<SegmentKey> m_CacheOrder; // Most recently used first
+};
@@ -0,0 +1,35 @@
+#include "SegmentKey.h"
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+SegmentKey SegmentKey::Create(const NiPoint3& from, const NiPoint3& to, const float step) {
+	const auto quantize = [step](float value) {
+		// Keeps invalid positions from overflowing the key, they all end up in the same step
+		const auto rounded = std::floor(value / step);
+		if (!(rounded > -1e9f && rounded < 1e9f)) return 0;
+
+		return static_cast<int32_t>(rounded);
+	};
+
+	return SegmentKey{
+		{ quantize(from.x), quantize(from.y), quantize(from.z) },
+		{ quantize(to.x), quantize(to.y), quantize(to.z) }
+	};
+}
+
+bool SegmentKey::operator==(const SegmentKey& other) const {
+	return std::memcmp(this, &other, sizeof(SegmentKey)) == 0;
+}
+
+size_t SegmentKeyHash::operator()(const SegmentKey& key) const {
+	size_t hash = 0;
+
+	for (int i = 0; i < 3; ++i) {
+		hash = hash * 31 + std::hash<int32_t>()(key.from[i]);
+		hash = hash * 31 + std::hash<int32_t>()(key.to[i]);
+	}
+
+	return hash;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "NiPoint3.h"
+
+/**
+ * The endpoints of a segment rounded to steps of a fixed size, for caching results between nearby points
+ */
+struct SegmentKey {
+	int32_t from[3];
+	int32_t to[3];
+
+	/**
+	 * @param step The size of the steps to round the endpoints to
+	 */
+	static SegmentKey Create(const NiPoint3& from, const NiPoint3& to, float step);
+
+	bool operator==(const SegmentKey& other) const;
+};
+
+struct SegmentKeyHash {
+	size_t operator()(const SegmentKey& key) const;
+};
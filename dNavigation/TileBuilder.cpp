@@ -0,0 +1,522 @@
+#include "TileBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "Crc32.h"
+#include "Metrics.hpp"
+#include "RawMesh.h"
+#include "WorkerPool.h"
+
+namespace {
+	/**
+	 * Frees whatever Recast allocated for a tile, however far the tile got
+	 */
+	struct TileScratch {
+		std::vector<uint8_t> triangleAreas;
+		rcHeightfield* solid = nullptr;
+		rcCompactHeightfield* compact = nullptr;
+		rcContourSet* contours = nullptr;
+		rcPolyMesh* polyMesh = nullptr;
+		rcPolyMeshDetail* detailMesh = nullptr;
+
+		~TileScratch() {
+			rcFreeHeightField(solid);
+			rcFreeCompactHeightfield(compact);
+			rcFreeContourSet(contours);
+			rcFreePolyMesh(polyMesh);
+			rcFreePolyMeshDetail(detailMesh);
+		}
+	};
+
+	enum class TileOutcome : uint8_t {
+		Built,
+		Reused,
+		Empty,
+		Failed
+	};
+
+	template<typename T>
+	void Append(std::vector<char>& contents, const T& value) {
+		const auto* bytes = reinterpret_cast<const char*>(&value);
+		contents.insert(contents.end(), bytes, bytes + sizeof(T));
+	}
+
+	template<typename T>
+	bool Read(std::ifstream& file, T& value) {
+		return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+}
+
+TileBuilder::TileBuilder(const TileBuildSettings& settings) {
+	m_Settings = settings;
+
+	std::memset(&m_Params, 0, sizeof(m_Params));
+}
+
+void TileBuilder::AddMesh(const RawMesh& mesh) {
+	const auto firstVertex = static_cast<int32_t>(m_Vertices.size() / 3);
+
+	for (const auto& vertex : mesh.m_Vertices) {
+		m_Vertices.push_back(vertex.x);
+		m_Vertices.push_back(vertex.y);
+		m_Vertices.push_back(vertex.z);
+	}
+
+	for (const auto index : mesh.m_Triangles) {
+		m_Triangles.push_back(firstVertex + static_cast<int32_t>(index));
+	}
+}
+
+bool TileBuilder::Build(const std::filesystem::path& path, const bool incremental, const uint32_t threadCount, Result& result) {
+	result = Result();
+
+	if (m_Triangles.empty()) return false;
+
+	GatherTileInputs();
+
+	const auto tileCount = m_TileInputs.size();
+
+	std::vector<std::vector<uint8_t>> tiles(tileCount);
+	std::vector<std::vector<uint8_t>> previousTiles(tileCount);
+	std::vector<uint32_t> previousCrcs(tileCount, 0);
+	std::vector<bool> known(tileCount, false);
+
+	// Without a usable previous build every tile is simply rebuilt
+	if (incremental) ReadPreviousBuild(path, previousTiles, previousCrcs, known);
+
+	std::vector<TileOutcome> outcomes(tileCount, TileOutcome::Empty);
+
+	WorkerPool workers(threadCount);
+
+	workers.Run(tileCount, [&](size_t index) {
+		const auto& input = m_TileInputs[index];
+
+		if (known[index] && previousCrcs[index] == input.crc) {
+			tiles[index] = std::move(previousTiles[index]);
+			outcomes[index] = TileOutcome::Reused;
+
+			return;
+		}
+
+		if (input.triangles.empty()) return;
+
+		const auto x = static_cast<int32_t>(index % m_TilesX);
+		const auto y = static_cast<int32_t>(index / m_TilesX);
+
+		if (!BuildTile(x, y, input, tiles[index])) {
+			outcomes[index] = TileOutcome::Failed;
+		} else if (!tiles[index].empty()) {
+			outcomes[index] = TileOutcome::Built;
+		}
+	});
+
+	std::vector<uint32_t> crcs(tileCount);
+
+	for (size_t i = 0; i < tileCount; ++i) {
+		crcs[i] = m_TileInputs[i].crc;
+
+		switch (outcomes[i]) {
+		case TileOutcome::Built:
+			result.built++;
+			break;
+		case TileOutcome::Reused:
+			result.reused++;
+			break;
+		case TileOutcome::Empty:
+			result.empty++;
+			break;
+		case TileOutcome::Failed:
+			// Never matches the input, so the next incremental build tries again
+			crcs[i] = ~crcs[i];
+			result.failed++;
+			break;
+		}
+	}
+
+	return WriteNavMesh(path, tiles) && WriteManifest(GetManifestPath(path), crcs);
+}
+
+void TileBuilder::GatherTileInputs() {
+	m_Min[0] = m_Min[1] = m_Min[2] = INFINITY;
+	m_Max[0] = m_Max[1] = m_Max[2] = -INFINITY;
+
+	for (size_t i = 0; i < m_Vertices.size(); i += 3) {
+		for (int axis = 0; axis < 3; ++axis) {
+			m_Min[axis] = std::min(m_Min[axis], m_Vertices[i + axis]);
+			m_Max[axis] = std::max(m_Max[axis], m_Vertices[i + axis]);
+		}
+	}
+
+	const auto cellSize = m_Settings.cellSize;
+	const auto tileWidth = m_Settings.tileSize * cellSize;
+
+	int gridWidth = 0;
+	int gridHeight = 0;
+	rcCalcGridSize(m_Min, m_Max, cellSize, &gridWidth, &gridHeight);
+
+	m_TilesX = (gridWidth + m_Settings.tileSize - 1) / m_Settings.tileSize;
+	m_TilesY = (gridHeight + m_Settings.tileSize - 1) / m_Settings.tileSize;
+
+	const auto walkableRadius = static_cast<int32_t>(std::ceil(m_Settings.agentRadius / cellSize));
+	m_BorderSize = walkableRadius + 3;
+
+	// Polygon references are 32 bits, shared between the tile index and the polygon index
+	const auto tileBits = std::min<uint32_t>(dtIlog2(dtNextPow2(m_TilesX * m_TilesY)), 14);
+	const auto polyBits = 22 - tileBits;
+
+	std::memset(&m_Params, 0, sizeof(m_Params));
+	dtVcopy(m_Params.orig, m_Min);
+	m_Params.tileWidth = tileWidth;
+	m_Params.tileHeight = tileWidth;
+	m_Params.maxTiles = 1 << tileBits;
+	m_Params.maxPolys = 1 << polyBits;
+
+	m_SettingsCrc = Crc32::Calculate(0xFFFFFFFF, reinterpret_cast<const uint8_t*>(&m_Settings), sizeof(m_Settings));
+	m_SettingsCrc = Crc32::Calculate(m_SettingsCrc, reinterpret_cast<const uint8_t*>(&m_Params), sizeof(m_Params));
+
+	m_TileInputs.assign(static_cast<size_t>(m_TilesX) * m_TilesY, TileInput());
+
+	const auto border = m_BorderSize * cellSize;
+
+	const auto toTile = [&](float value, float origin, int32_t count) {
+		const auto tile = std::floor((value - origin) / tileWidth);
+
+		return static_cast<int32_t>(std::clamp(tile, 0.0f, static_cast<float>(count - 1)));
+	};
+
+	for (size_t i = 0; i < m_Triangles.size(); i += 3) {
+		float min[2] = { INFINITY, INFINITY };
+		float max[2] = { -INFINITY, -INFINITY };
+
+		for (int corner = 0; corner < 3; ++corner) {
+			const auto* vertex = &m_Vertices[m_Triangles[i + corner] * 3];
+
+			min[0] = std::min(min[0], vertex[0]);
+			min[1] = std::min(min[1], vertex[2]);
+			max[0] = std::max(max[0], vertex[0]);
+			max[1] = std::max(max[1], vertex[2]);
+		}
+
+		const auto firstX = toTile(min[0] - border, m_Min[0], m_TilesX);
+		const auto lastX = toTile(max[0] + border, m_Min[0], m_TilesX);
+		const auto firstY = toTile(min[1] - border, m_Min[2], m_TilesY);
+		const auto lastY = toTile(max[1] + border, m_Min[2], m_TilesY);
+
+		for (auto y = firstY; y <= lastY; ++y) {
+			for (auto x = firstX; x <= lastX; ++x) {
+				auto& input = m_TileInputs[GetTileIndex(x, y)];
+
+				input.triangles.insert(input.triangles.end(), m_Triangles.begin() + i, m_Triangles.begin() + i + 3);
+			}
+		}
+	}
+
+	for (auto& input : m_TileInputs) {
+		auto crc = m_SettingsCrc;
+
+		for (const auto index : input.triangles) {
+			crc = Crc32::Calculate(crc, reinterpret_cast<const uint8_t*>(&m_Vertices[index * 3]), sizeof(float) * 3);
+		}
+
+		input.crc = crc;
+	}
+}
+
+bool TileBuilder::BuildTile(const int32_t x, const int32_t y, const TileInput& input, std::vector<uint8_t>& data) const {
+	const auto& settings = m_Settings;
+
+	rcConfig config;
+	std::memset(&config, 0, sizeof(config));
+
+	config.cs = settings.cellSize;
+	config.ch = settings.cellHeight;
+	config.walkableSlopeAngle = settings.agentMaxSlope;
+	config.walkableHeight = static_cast<int>(std::ceil(settings.agentHeight / config.ch));
+	config.walkableClimb = static_cast<int>(std::floor(settings.agentMaxClimb / config.ch));
+	config.walkableRadius = static_cast<int>(std::ceil(settings.agentRadius / config.cs));
+	config.maxEdgeLen = static_cast<int>(settings.edgeMaxLength / config.cs);
+	config.maxSimplificationError = settings.edgeMaxError;
+	config.minRegionArea = static_cast<int>(settings.regionMinSize * settings.regionMinSize);
+	config.mergeRegionArea = static_cast<int>(settings.regionMergeSize * settings.regionMergeSize);
+	config.maxVertsPerPoly = DT_VERTS_PER_POLYGON;
+	config.tileSize = settings.tileSize;
+	config.borderSize = m_BorderSize;
+	config.width = config.tileSize + config.borderSize * 2;
+	config.height = config.tileSize + config.borderSize * 2;
+	config.detailSampleDist = settings.detailSampleDistance < 0.9f ? 0 : config.cs * settings.detailSampleDistance;
+	config.detailSampleMaxError = config.ch * settings.detailSampleMaxError;
+
+	// The tile is built with a border of cells around it, so its edges line up with its neighbours
+	config.bmin[0] = m_Params.orig[0] + x * m_Params.tileWidth - config.borderSize * config.cs;
+	config.bmin[1] = m_Min[1];
+	config.bmin[2] = m_Params.orig[2] + y * m_Params.tileHeight - config.borderSize * config.cs;
+	config.bmax[0] = m_Params.orig[0] + (x + 1) * m_Params.tileWidth + config.borderSize * config.cs;
+	config.bmax[1] = m_Max[1];
+	config.bmax[2] = m_Params.orig[2] + (y + 1) * m_Params.tileHeight + config.borderSize * config.cs;
+
+	rcContext context(false);
+	TileScratch scratch;
+
+	const auto vertexCount = static_cast<int>(m_Vertices.size() / 3);
+	const auto triangleCount = static_cast<int>(input.triangles.size() / 3);
+
+	scratch.solid = rcAllocHeightfield();
+	if (!scratch.solid || !rcCreateHeightfield(&context, *scratch.solid, config.width, config.height, config.bmin, config.bmax, config.cs, config.ch)) return false;
+
+	scratch.triangleAreas.assign(triangleCount, RC_NULL_AREA);
+	rcMarkWalkableTriangles(&context, config.walkableSlopeAngle, m_Vertices.data(), vertexCount, input.triangles.data(), triangleCount, scratch.triangleAreas.data());
+
+	if (!rcRasterizeTriangles(&context, m_Vertices.data(), vertexCount, input.triangles.data(), scratch.triangleAreas.data(), triangleCount, *scratch.solid, config.walkableClimb)) return false;
+
+	rcFilterLowHangingWalkableObstacles(&context, config.walkableClimb, *scratch.solid);
+	rcFilterLedgeSpans(&context, config.walkableHeight, config.walkableClimb, *scratch.solid);
+	rcFilterWalkableLowHeightSpans(&context, config.walkableHeight, *scratch.solid);
+
+	scratch.compact = rcAllocCompactHeightfield();
+	if (!scratch.compact || !rcBuildCompactHeightfield(&context, config.walkableHeight, config.walkableClimb, *scratch.solid, *scratch.compact)) return false;
+
+	rcFreeHeightField(scratch.solid);
+	scratch.solid = nullptr;
+
+	if (!rcErodeWalkableArea(&context, config.walkableRadius, *scratch.compact)) return false;
+	if (!rcBuildDistanceField(&context, *scratch.compact)) return false;
+	if (!rcBuildRegions(&context, *scratch.compact, config.borderSize, config.minRegionArea, config.mergeRegionArea)) return false;
+
+	scratch.contours = rcAllocContourSet();
+	if (!scratch.contours || !rcBuildContours(&context, *scratch.compact, config.maxSimplificationError, config.maxEdgeLen, *scratch.contours)) return false;
+
+	// Nothing to walk on in this tile
+	if (scratch.contours->nconts == 0) return true;
+
+	scratch.polyMesh = rcAllocPolyMesh();
+	if (!scratch.polyMesh || !rcBuildPolyMesh(&context, *scratch.contours, config.maxVertsPerPoly, *scratch.polyMesh)) return false;
+
+	scratch.detailMesh = rcAllocPolyMeshDetail();
+	if (!scratch.detailMesh || !rcBuildPolyMeshDetail(&context, *scratch.polyMesh, *scratch.compact, config.detailSampleDist, config.detailSampleMaxError, *scratch.detailMesh)) return false;
+
+	auto& polyMesh = *scratch.polyMesh;
+
+	if (polyMesh.npolys == 0) return true;
+
+	// Detour stores vertex indices as 16 bits
+	if (polyMesh.nverts >= 0xffff) return false;
+
+	for (int i = 0; i < polyMesh.npolys; ++i) {
+		polyMesh.flags[i] = polyMesh.areas[i] == RC_WALKABLE_AREA ? WALKABLE_POLY_FLAG : 0;
+	}
+
+	dtNavMeshCreateParams params;
+	std::memset(&params, 0, sizeof(params));
+
+	params.verts = polyMesh.verts;
+	params.vertCount = polyMesh.nverts;
+	params.polys = polyMesh.polys;
+	params.polyAreas = polyMesh.areas;
+	params.polyFlags = polyMesh.flags;
+	params.polyCount = polyMesh.npolys;
+	params.nvp = polyMesh.nvp;
+	params.detailMeshes = scratch.detailMesh->meshes;
+	params.detailVerts = scratch.detailMesh->verts;
+	params.detailVertsCount = scratch.detailMesh->nverts;
+	params.detailTris = scratch.detailMesh->tris;
+	params.detailTriCount = scratch.detailMesh->ntris;
+	params.walkableHeight = settings.agentHeight;
+	params.walkableRadius = settings.agentRadius;
+	params.walkableClimb = settings.agentMaxClimb;
+	params.tileX = x;
+	params.tileY = y;
+	params.tileLayer = 0;
+	dtVcopy(params.bmin, polyMesh.bmin);
+	dtVcopy(params.bmax, polyMesh.bmax);
+	params.cs = config.cs;
+	params.ch = config.ch;
+	params.buildBvTree = true;
+
+	unsigned char* navData = nullptr;
+	int navDataSize = 0;
+
+	if (!dtCreateNavMeshData(&params, &navData, &navDataSize)) return false;
+
+	data.assign(navData, navData + navDataSize);
+	dtFree(navData);
+
+	return true;
+}
+
+bool TileBuilder::ReadPreviousBuild(const std::filesystem::path& path, std::vector<std::vector<uint8_t>>& tiles, std::vector<uint32_t>& crcs, std::vector<bool>& known) const {
+	std::ifstream manifest(GetManifestPath(path), std::ios::binary);
+	if (!manifest.is_open()) return false;
+
+	char magic[4];
+	uint32_t version = 0;
+	uint32_t settingsCrc = 0;
+	uint32_t entryCount = 0;
+
+	if (!Read(manifest, magic) || std::memcmp(magic, MANIFEST_MAGIC, sizeof(magic)) != 0) return false;
+	if (!Read(manifest, version) || version != MANIFEST_VERSION) return false;
+
+	// Different settings or bounds change every tile
+	if (!Read(manifest, settingsCrc) || settingsCrc != m_SettingsCrc) return false;
+	if (!Read(manifest, entryCount)) return false;
+
+	std::vector<uint32_t> manifestCrcs(crcs.size(), 0);
+	std::vector<bool> inManifest(crcs.size(), false);
+
+	for (uint32_t i = 0; i < entryCount; ++i) {
+		int32_t x;
+		int32_t y;
+		uint32_t crc;
+
+		if (!Read(manifest, x) || !Read(manifest, y) || !Read(manifest, crc)) return false;
+		if (x < 0 || x >= m_TilesX || y < 0 || y >= m_TilesY) continue;
+
+		manifestCrcs[GetTileIndex(x, y)] = crc;
+		inManifest[GetTileIndex(x, y)] = true;
+	}
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) return false;
+
+	NavMeshSetHeader header;
+	if (!Read(file, header) || header.magic != NAVMESHSET_MAGIC || header.version != NAVMESHSET_VERSION) return false;
+	if (std::memcmp(&header.params, &m_Params, sizeof(m_Params)) != 0) return false;
+
+	for (int i = 0; i < header.numTiles; ++i) {
+		NavMeshTileHeader tileHeader;
+		if (!Read(file, tileHeader) || !tileHeader.tileRef || tileHeader.dataSize < static_cast<int>(sizeof(dtMeshHeader))) return false;
+
+		std::vector<uint8_t> data(tileHeader.dataSize);
+		if (!file.read(reinterpret_cast<char*>(data.data()), data.size())) return false;
+
+		dtMeshHeader meshHeader;
+		std::memcpy(&meshHeader, data.data(), sizeof(meshHeader));
+
+		if (meshHeader.x < 0 || meshHeader.x >= m_TilesX || meshHeader.y < 0 || meshHeader.y >= m_TilesY) continue;
+
+		tiles[GetTileIndex(meshHeader.x, meshHeader.y)] = std::move(data);
+	}
+
+	// Only trusted once both files were read completely
+	crcs = std::move(manifestCrcs);
+	known = std::move(inManifest);
+
+	return true;
+}
+
+bool TileBuilder::WriteNavMesh(const std::filesystem::path& path, std::vector<std::vector<uint8_t>>& tiles) const {
+	auto* navMesh = dtAllocNavMesh();
+	if (!navMesh) return false;
+
+	if (dtStatusFailed(navMesh->init(&m_Params))) {
+		dtFreeNavMesh(navMesh);
+
+		return false;
+	}
+
+	for (auto& tile : tiles) {
+		if (tile.empty()) continue;
+
+		auto* data = static_cast<unsigned char*>(dtAlloc(tile.size(), DT_ALLOC_PERM));
+		if (!data) continue;
+
+		std::memcpy(data, tile.data(), tile.size());
+
+		if (dtStatusFailed(navMesh->addTile(data, static_cast<int>(tile.size()), DT_TILE_FREE_DATA, 0, nullptr))) dtFree(data);
+
+		tile.clear();
+		tile.shrink_to_fit();
+	}
+
+	NavMeshSetHeader header;
+	header.magic = NAVMESHSET_MAGIC;
+	header.version = NAVMESHSET_VERSION;
+	header.numTiles = 0;
+	header.params = *navMesh->getParams();
+
+	const dtNavMesh* constNavMesh = navMesh;
+
+	for (int i = 0; i < constNavMesh->getMaxTiles(); ++i) {
+		const auto* tile = constNavMesh->getTile(i);
+		if (tile && tile->header && tile->dataSize) header.numTiles++;
+	}
+
+	std::vector<char> contents;
+	Append(contents, header);
+
+	for (int i = 0; i < constNavMesh->getMaxTiles(); ++i) {
+		const auto* tile = constNavMesh->getTile(i);
+		if (!tile || !tile->header || !tile->dataSize) continue;
+
+		NavMeshTileHeader tileHeader;
+		tileHeader.tileRef = navMesh->getTileRef(tile);
+		tileHeader.dataSize = tile->dataSize;
+
+		Append(contents, tileHeader);
+		contents.insert(contents.end(), tile->data, tile->data + tile->dataSize);
+	}
+
+	dtFreeNavMesh(navMesh);
+
+	return WriteFile(path, contents);
+}
+
+bool TileBuilder::WriteManifest(const std::filesystem::path& path, const std::vector<uint32_t>& crcs) const {
+	std::vector<char> contents(std::begin(MANIFEST_MAGIC), std::end(MANIFEST_MAGIC));
+
+	Append(contents, MANIFEST_VERSION);
+	Append(contents, m_SettingsCrc);
+	Append(contents, static_cast<uint32_t>(crcs.size()));
+
+	for (int32_t y = 0; y < m_TilesY; ++y) {
+		for (int32_t x = 0; x < m_TilesX; ++x) {
+			Append(contents, x);
+			Append(contents, y);
+			Append(contents, crcs[GetTileIndex(x, y)]);
+		}
+	}
+
+	return WriteFile(path, contents);
+}
+
+std::filesystem::path TileBuilder::GetManifestPath(const std::filesystem::path& path) {
+	auto manifestPath = path;
+	manifestPath += ".tiles";
+
+	return manifestPath;
+}
+
+bool TileBuilder::WriteFile(const std::filesystem::path& path, const std::vector<char>& contents) {
+	std::error_code error;
+
+	if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), error);
+
+	auto tempPath = path;
+	tempPath += "." + std::to_string(Metrics::GetProcessID()) + ".tmp";
+
+	{
+		std::ofstream file(tempPath, std::ios::binary);
+
+		file.write(contents.data(), contents.size());
+		file.close();
+
+		if (file.fail()) {
+			std::filesystem::remove(tempPath, error);
+
+			return false;
+		}
+	}
+
+	std::filesystem::rename(tempPath, path, error);
+
+	if (error) {
+		std::filesystem::remove(tempPath, error);
+
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "DetourExtensions.h"
+
+struct RawMesh;
+
+/**
+ * Settings of a navmesh build, distances are in world units
+ */
+struct TileBuildSettings {
+	float cellSize = 0.5f;
+	float cellHeight = 0.25f;
+	float agentHeight = 2.0f;
+	float agentRadius = 0.6f;
+	float agentMaxClimb = 0.9f;
+	float agentMaxSlope = 45.0f; // In degrees
+	int32_t tileSize = 128; // In cells
+	float regionMinSize = 8.0f; // In cells
+	float regionMergeSize = 20.0f; // In cells
+	float edgeMaxLength = 12.0f;
+	float edgeMaxError = 1.3f;
+	float detailSampleDistance = 6.0f; // In cells
+	float detailSampleMaxError = 1.0f; // In cell heights
+};
+
+/**
+ * Builds a tiled navmesh from triangle meshes, such as the terrain of a zone, and writes it in the format
+ * dNavMesh::LoadNavmesh reads.  Tiles are built in parallel, each by its own Recast context.
+ *
+ * Next to the navmesh a manifest (<navmesh>.tiles) records a crc of the triangles that went into each tile.
+ * An incremental build copies every tile whose triangles did not change from the previous navmesh, so
+ * editing part of a zone only rebuilds the tiles around the edit.
+ *
+ * Manifest layout (little endian):
+ *   char[4] magic "NMTM", uint32 version, uint32 settings crc, uint32 tile count,
+ *   then for each tile: int32 x, int32 y, uint32 input crc
+ */
+class TileBuilder {
+public:
+	static constexpr char MANIFEST_MAGIC[4] = { 'N', 'M', 'T', 'M' };
+	static constexpr uint32_t MANIFEST_VERSION = 1;
+
+	struct Result {
+		uint32_t built = 0;
+		uint32_t reused = 0;
+		uint32_t empty = 0; // Tiles without anything to walk on
+		uint32_t failed = 0;
+	};
+
+	explicit TileBuilder(const TileBuildSettings& settings = TileBuildSettings());
+
+	/**
+	 * Adds the triangles of a mesh to the build
+	 */
+	void AddMesh(const RawMesh& mesh);
+
+	/**
+	 * Builds the navmesh and writes it and its manifest to disk
+	 *
+	 * @param path Where to write the navmesh
+	 * @param incremental Reuse the unchanged tiles of the navmesh already at path
+	 * @param threadCount How many threads to build tiles on, 0 uses every core
+	 * @param result Set to what happened to the tiles
+	 * @return Whether or not the navmesh was written
+	 */
+	bool Build(const std::filesystem::path& path, bool incremental, uint32_t threadCount, Result& result);
+
+private:
+	/**
+	 * Flag set on every walkable polygon, the default query filter accepts any non zero flag
+	 */
+	static constexpr uint16_t WALKABLE_POLY_FLAG = 0x01;
+
+	struct TileInput {
+		std::vector<int32_t> triangles;
+		uint32_t crc = 0;
+	};
+
+	/**
+	 * Runs the Recast pipeline for a single tile
+	 *
+	 * @param data Set to the Detour tile data, left empty when there is nothing to walk on
+	 * @return Whether or not the tile was built
+	 */
+	bool BuildTile(int32_t x, int32_t y, const TileInput& input, std::vector<uint8_t>& data) const;
+
+	/**
+	 * Assigns every triangle to the tiles its bounds overlap, including the border Recast needs around a tile
+	 */
+	void GatherTileInputs();
+
+	/**
+	 * Reads the tiles of a navmesh built with the same settings, keyed by GetTileKey
+	 */
+	bool ReadPreviousBuild(const std::filesystem::path& path, std::vector<std::vector<uint8_t>>& tiles, std::vector<uint32_t>& crcs, std::vector<bool>& known) const;
+
+	/**
+	 * Adds the tiles to a Detour navmesh so they get their final references, then writes it out
+	 */
+	bool WriteNavMesh(const std::filesystem::path& path, std::vector<std::vector<uint8_t>>& tiles) const;
+
+	bool WriteManifest(const std::filesystem::path& path, const std::vector<uint32_t>& crcs) const;
+
+	size_t GetTileIndex(int32_t x, int32_t y) const { return static_cast<size_t>(y) * m_TilesX + x; }
+
+	static std::filesystem::path GetManifestPath(const std::filesystem::path& path);
+
+	/**
+	 * Writes to a temporary file first, so a failed write leaves the previous file intact
+	 */
+	static bool WriteFile(const std::filesystem::path& path, const std::vector<char>& contents);
+
+	TileBuildSettings m_Settings;
+
+	std::vector<float> m_Vertices;
+	std::vector<int32_t> m_Triangles;
+
+	float m_Min[3];
+	float m_Max[3];
+	int32_t m_TilesX = 0;
+	int32_t m_TilesY = 0;
+	int32_t m_BorderSize = 0;
+	dtNavMeshParams m_Params;
+	uint32_t m_SettingsCrc = 0;
+
+	std::vector<TileInput> m_TileInputs;
+};
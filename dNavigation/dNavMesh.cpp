@@ -8,6 +8,13 @@
 #include "NiPoint3.h"
 #include "BinaryIO.h"
 #include "BinaryPathFinder.h"
+#include "Metrics.hpp"
+#include "dConfig.h"
+#include "PathfindingService.h"
+#include "CrowdManager.h"
+#include "MappedFile.h"
+
+#include <algorithm>
 
 #include "dZoneManager.h"
 
@@ -20,6 +27,21 @@ dNavMesh::dNavMesh(uint32_t zoneId) {
 		m_NavQuery = dtAllocNavMeshQuery();
 		m_NavQuery->init(m_NavMesh, 2048);
 
+		const auto pathfindingThreads = std::atoi(Game::config->GetValue("pathfinding_threads").c_str());
+
+		if (pathfindingThreads > 0) {
+			m_Pathfinder = new PathfindingService(m_NavMesh, pathfindingThreads);
+		}
+
+		if (Game::config->GetValue("navmesh_crowd") == "1") {
+			auto maxAgents = std::atoi(Game::config->GetValue("navmesh_crowd_max_agents").c_str());
+			if (maxAgents <= 0) maxAgents = 512;
+
+			m_Crowd = new CrowdManager(m_NavMesh, maxAgents);
+		}
+
+		if (Game::config->GetValue("navmesh_height_grid") == "1") LoadHeightGrid();
+
 		Game::logger->Log("dNavMesh", "Navmesh loaded successfully!");
 	} else {
 		Game::logger->Log("dNavMesh", "Navmesh loading failed (This may be intended).");
@@ -27,6 +49,10 @@ dNavMesh::dNavMesh(uint32_t zoneId) {
 }
 
 dNavMesh::~dNavMesh() {
+	// The workers query the navmesh until they are stopped
+	if (m_Pathfinder) delete m_Pathfinder;
+	if (m_Crowd) delete m_Crowd;
+
 	// Clean up Recast information
 
 	if(m_Solid) rcFreeHeightField(m_Solid);
@@ -42,14 +68,22 @@ dNavMesh::~dNavMesh() {
 }
 
 
+std::filesystem::path dNavMesh::GetNavmeshPath(const std::string& extension) const {
+	return BinaryPathFinder::GetBinaryDir() / "navmeshes" / (std::to_string(m_ZoneId) + extension);
+}
+
 void dNavMesh::LoadNavmesh() {
 
-	std::string path = (BinaryPathFinder::GetBinaryDir() / "navmeshes/" / (std::to_string(m_ZoneId) + ".bin")).string();
+	std::string path = GetNavmeshPath(".bin").string();
 
 	if (!BinaryIO::DoesFileExist(path)) {
 		return;
 	}
 
+	if (Game::config->GetValue("navmesh_mmap") == "1" && LoadMappedNavmesh(path)) {
+		return;
+	}
+
 	FILE* fp;
 
 #ifdef _WIN32
@@ -118,11 +152,117 @@ void dNavMesh::LoadNavmesh() {
 	m_NavMesh = mesh;
 }
 
+void dNavMesh::LoadHeightGrid() {
+	const auto navMeshPath = GetNavmeshPath(".bin");
+
+	MappedFile navMeshFile(navMeshPath);
+	if (!navMeshFile.IsOpen()) return;
+
+	const auto navMeshCrc = HeightGrid::CalculateNavMeshCrc(navMeshFile.GetData(), navMeshFile.GetSize());
+
+	// The grid is built by the NavMeshBuilder, building it here would hold up the start of the zone
+	if (!m_HeightGrid.Load(HeightGrid::GetPath(navMeshPath), navMeshCrc)) {
+		Game::logger->Log("dNavMesh", "No up to date height grid for zone %i, heights will be queried from the navmesh. Run NavMeshBuilder --heights %s to build it", m_ZoneId, navMeshPath.string().c_str());
+		return;
+	}
+
+	Game::logger->Log("dNavMesh", "Loaded a height grid of %llu samples", static_cast<unsigned long long>(m_HeightGrid.GetSampleCount()));
+}
+
+bool dNavMesh::LoadMappedNavmesh(const std::filesystem::path& path) {
+	// Detour links the tiles together by writing into their data, so the mapping is copy on write
+	// and only the pages it writes to stop being shared with other instances of the zone
+	if (!m_NavMeshFile.Open(path, true)) return false;
+
+	auto* data = m_NavMeshFile.GetWritableData();
+	const auto size = m_NavMeshFile.GetSize();
+
+	NavMeshSetHeader header;
+	if (size < sizeof(header)) {
+		m_NavMeshFile.Close();
+		return false;
+	}
+
+	std::memcpy(&header, data, sizeof(header));
+
+	if (header.magic != NAVMESHSET_MAGIC || header.version != NAVMESHSET_VERSION) {
+		m_NavMeshFile.Close();
+		return false;
+	}
+
+	dtNavMesh* mesh = dtAllocNavMesh();
+	if (!mesh || dtStatusFailed(mesh->init(&header.params))) {
+		if (mesh) dtFreeNavMesh(mesh);
+		m_NavMeshFile.Close();
+		return false;
+	}
+
+	size_t offset = sizeof(header);
+	size_t tileBytes = 0;
+
+	for (int i = 0; i < header.numTiles; ++i) {
+		NavMeshTileHeader tileHeader;
+		if (offset + sizeof(tileHeader) > size) {
+			dtFreeNavMesh(mesh);
+			m_NavMeshFile.Close();
+			return false;
+		}
+
+		std::memcpy(&tileHeader, data + offset, sizeof(tileHeader));
+		offset += sizeof(tileHeader);
+
+		if (!tileHeader.tileRef || !tileHeader.dataSize) break;
+
+		// Detour reads the tile data in place, so it has to be whole and aligned
+		if (tileHeader.dataSize < 0 || offset + tileHeader.dataSize > size || offset % 4 != 0) {
+			dtFreeNavMesh(mesh);
+			m_NavMeshFile.Close();
+			return false;
+		}
+
+		// Without DT_TILE_FREE_DATA the tile keeps pointing into the mapping
+		if (dtStatusFailed(mesh->addTile(reinterpret_cast<unsigned char*>(data + offset), tileHeader.dataSize, 0, tileHeader.tileRef, 0))) {
+			dtFreeNavMesh(mesh);
+			m_NavMeshFile.Close();
+			return false;
+		}
+
+		offset += tileHeader.dataSize;
+		tileBytes += tileHeader.dataSize;
+	}
+
+	m_NavMesh = mesh;
+
+	size_t privateBytes = 0;
+
+	if (m_NavMeshFile.GetPrivateBytes(privateBytes)) {
+		privateBytes = std::min(privateBytes, tileBytes);
+
+		Game::logger->Log("dNavMesh", "Mapped %zu KB of navmesh tiles, %zu KB are shared with other instances of the zone instead of copied (%zu KB private)", tileBytes / 1024, (tileBytes - privateBytes) / 1024, privateBytes / 1024);
+	} else {
+		Game::logger->Log("dNavMesh", "Mapped %zu KB of navmesh tiles", tileBytes / 1024);
+	}
+
+	return true;
+}
+
 float dNavMesh::GetHeightAtPoint(const NiPoint3& location) {
 	if (m_NavMesh == nullptr) {
 		return location.y;
 	}
 
+	float height;
+
+	if (m_HeightGrid.GetHeight(location, height)) {
+		Metrics::AddToCounter(MetricCounter::HeightGridHits, 1);
+
+		return height;
+	}
+
+	return GetHeightAtPoint(m_NavQuery, location);
+}
+
+float dNavMesh::GetHeightAtPoint(dtNavMeshQuery* query, const NiPoint3& location) {
 	float toReturn = 0.0f;
 	float pos[3];
 	pos[0] = location.x;
@@ -133,8 +273,8 @@ float dNavMesh::GetHeightAtPoint(const NiPoint3& location) {
 	float polyPickExt[3] = { 32.0f, 32.0f, 32.0f };
 	dtQueryFilter filter{};
 
-	m_NavQuery->findNearestPoly(pos, polyPickExt, &filter, &nearestRef, 0);
-	m_NavQuery->getPolyHeight(nearestRef, pos, &toReturn);
+	query->findNearestPoly(pos, polyPickExt, &filter, &nearestRef, 0);
+	query->getPolyHeight(nearestRef, pos, &toReturn);
 
 	if (toReturn == 0.0f) {
 		toReturn = location.y;
@@ -170,6 +310,12 @@ std::vector<NiPoint3> dNavMesh::GetPath(const NiPoint3& startPos, const NiPoint3
 		return path;
 	}
 
+	return FindPath(m_NavQuery, startPos, endPos);
+}
+
+std::vector<NiPoint3> dNavMesh::FindPath(dtNavMeshQuery* query, const NiPoint3& startPos, const NiPoint3& endPos) {
+	std::vector<NiPoint3> path;
+
 	float sPos[3];
 	float ePos[3];
 	sPos[0] = startPos.x;
@@ -187,10 +333,10 @@ std::vector<NiPoint3> dNavMesh::GetPath(const NiPoint3& startPos, const NiPoint3
 	dtQueryFilter filter{};
 
 	//Find our start poly
-	m_NavQuery->findNearestPoly(sPos, polyPickExt, &filter, &startRef, 0);
+	query->findNearestPoly(sPos, polyPickExt, &filter, &startRef, 0);
 
 	//Find our end poly
-	m_NavQuery->findNearestPoly(ePos, polyPickExt, &filter, &endRef, 0);
+	query->findNearestPoly(ePos, polyPickExt, &filter, &endRef, 0);
 
 	pathFindStatus = DT_FAILURE;
 	int m_nstraightPath = 0;
@@ -202,7 +348,7 @@ std::vector<NiPoint3> dNavMesh::GetPath(const NiPoint3& startPos, const NiPoint3
 	int m_straightPathOptions = 0;
 
 	if (startRef && endRef) {
-		m_NavQuery->findPath(startRef, endRef, sPos, ePos, &filter, m_polys, &m_npolys, MAX_POLYS);
+		query->findPath(startRef, endRef, sPos, ePos, &filter, m_polys, &m_npolys, MAX_POLYS);
 
 		if (m_npolys) {
 			// In case of partial path, make sure the end point is clamped to the last polygon.
@@ -210,10 +356,10 @@ std::vector<NiPoint3> dNavMesh::GetPath(const NiPoint3& startPos, const NiPoint3
 			dtVcopy(epos, ePos);
 
 			if (m_polys[m_npolys - 1] != endRef) {
-				m_NavQuery->closestPointOnPoly(m_polys[m_npolys - 1], ePos, epos, 0);
+				query->closestPointOnPoly(m_polys[m_npolys - 1], ePos, epos, 0);
 			}
 
-			m_NavQuery->findStraightPath(sPos, epos, m_polys, m_npolys,
+			query->findStraightPath(sPos, epos, m_polys, m_npolys,
 				m_straightPath, m_straightPathFlags,
 				m_straightPathPolys, &m_nstraightPath, MAX_POLYS, m_straightPathOptions);
 
@@ -231,3 +377,103 @@ std::vector<NiPoint3> dNavMesh::GetPath(const NiPoint3& startPos, const NiPoint3
 
 	return path;
 }
+
+void dNavMesh::Update(const float deltaTime) {
+	ClearLineOfSightCache();
+
+	if (m_Pathfinder) m_Pathfinder->Update();
+
+	if (m_Crowd) m_Crowd->Update(deltaTime);
+}
+
+dtPolyRef dNavMesh::GetNearestPoly(const NiPoint3& point) {
+	float pos[3] = { point.x, point.y, point.z };
+	float polyPickExt[3] = { 32.0f, 32.0f, 32.0f };
+	dtQueryFilter filter{};
+
+	dtPolyRef nearestRef = 0;
+	m_NavQuery->findNearestPoly(pos, polyPickExt, &filter, &nearestRef, 0);
+
+	return nearestRef;
+}
+
+float dNavMesh::RayCast(dtPolyRef startRef, const NiPoint3& from, const NiPoint3& to) {
+	float start[3] = { from.x, from.y, from.z };
+	float end[3] = { to.x, to.y, to.z };
+	dtQueryFilter filter{};
+
+	float t = 0.0f;
+	float hitNormal[3];
+	dtPolyRef polys[MAX_POLYS];
+	int polyCount = 0;
+
+	const auto status = m_NavQuery->raycast(startRef, start, end, &filter, &t, hitNormal, polys, &polyCount, MAX_POLYS);
+
+	// A failed cast is not proof of a wall, rather let it through than hide a target
+	if (dtStatusFailed(status)) return 1.0f;
+
+	return t;
+}
+
+bool dNavMesh::RayCast(const NiPoint3& from, const NiPoint3& to, NiPoint3& hit) {
+	hit = to;
+
+	if (m_NavMesh == nullptr) return false;
+
+	const auto startRef = GetNearestPoly(from);
+	if (!startRef) return false;
+
+	const auto t = RayCast(startRef, from, to);
+	if (t >= 1.0f) return false;
+
+	hit = from + (to - from) * t;
+
+	return true;
+}
+
+bool dNavMesh::IsInLineOfSight(const NiPoint3& from, const NiPoint3& to) {
+	std::vector<LineOfSightQuery> queries = { { from, to } };
+
+	CheckLineOfSight(queries);
+
+	return queries[0].visible;
+}
+
+void dNavMesh::CheckLineOfSight(std::vector<LineOfSightQuery>& queries) {
+	if (m_NavMesh == nullptr) {
+		for (auto& query : queries) query.visible = true;
+
+		return;
+	}
+
+	Metrics::AddToCounter(MetricCounter::LineOfSightChecks, queries.size());
+
+	bool hasLastStart = false;
+	NiPoint3 lastStart;
+	dtPolyRef lastStartRef = 0;
+
+	for (auto& query : queries) {
+		const auto key = SegmentKey::Create(query.from, query.to, LINE_OF_SIGHT_CACHE_STEP);
+		const auto cached = m_LineOfSightCache.find(key);
+
+		if (cached != m_LineOfSightCache.end()) {
+			query.visible = cached->second;
+			Metrics::AddToCounter(MetricCounter::LineOfSightCacheHits, 1);
+
+			continue;
+		}
+
+		// Batches usually check one entity against many, so only look for its polygon once
+		if (!hasLastStart || lastStart != query.from) {
+			lastStart = query.from;
+			lastStartRef = GetNearestPoly(query.from);
+			hasLastStart = true;
+		}
+
+		query.visible = !lastStartRef || RayCast(lastStartRef, query.from, query.to) >= 1.0f;
+
+		if (!query.visible) Metrics::AddToCounter(MetricCounter::LineOfSightBlocked, 1);
+
+		m_LineOfSightCache.emplace(key, query.visible);
+	}
+}
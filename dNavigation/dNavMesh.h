@@ -5,24 +5,126 @@
 #include <map>
 #include <string>
 #include <cstring>
+#include <filesystem>
+#include <unordered_map>
 
 #include "DetourExtensions.h"
+#include "HeightGrid.h"
+#include "MappedFile.h"
+#include "NiPoint3.h"
+#include "SegmentKey.h"
 
-class NiPoint3;
+/**
+ * A line of sight check between two points, see dNavMesh::CheckLineOfSight
+ */
+struct LineOfSightQuery {
+	NiPoint3 from;
+	NiPoint3 to;
+	bool visible = true;
+};
 
 class dNavMesh {
 public:
 	dNavMesh(uint32_t zoneId);
 	~dNavMesh();
 
+	/**
+	 * Looks the height up in the height grid when it has one for the point, otherwise queries the navmesh
+	 */
 	float GetHeightAtPoint(const NiPoint3& location);
 	std::vector<NiPoint3> GetPath(const NiPoint3& startPos, const NiPoint3& endPos, float speed = 10.0f);
 
+	/*
+	 * The same searches on a given query, for threads that own their own query
+	 */
+
+	static float GetHeightAtPoint(class dtNavMeshQuery* query, const NiPoint3& location);
+	static std::vector<NiPoint3> FindPath(class dtNavMeshQuery* query, const NiPoint3& startPos, const NiPoint3& endPos);
+
+	/**
+	 * Casts a ray along the surface of the navmesh
+	 *
+	 * @param from Where to start the ray, snapped to the closest polygon
+	 * @param to Where the ray ends
+	 * @param hit Set to where the ray hit the edge of the navmesh, or to to if it did not
+	 * @return Whether or not the ray hit the edge of the navmesh before reaching to
+	 */
+	bool RayCast(const NiPoint3& from, const NiPoint3& to, NiPoint3& hit);
+
+	/**
+	 * @return Whether or not the navmesh is uninterrupted between from and to, always true without a navmesh
+	 */
+	bool IsInLineOfSight(const NiPoint3& from, const NiPoint3& to);
+
+	/**
+	 * Checks many lines of sight at once, setting visible on every query.  Results are cached for
+	 * the rest of the frame by their endpoints rounded to LINE_OF_SIGHT_CACHE_STEP, and queries
+	 * sharing their start with the previous query reuse its start polygon.
+	 * Only call from the main thread.
+	 */
+	void CheckLineOfSight(std::vector<LineOfSightQuery>& queries);
+
+	/**
+	 * Forgets the cached lines of sight, called once per frame since entities move
+	 */
+	void ClearLineOfSightCache() { m_LineOfSightCache.clear(); }
+
+	/**
+	 * Called once per frame, forgets the cached lines of sight, hands out the paths found since the last frame
+	 * and moves the crowd
+	 */
+	void Update(float deltaTime);
+
+	/**
+	 * @return The service finding paths on worker threads, nullptr without a navmesh or when pathfinding_threads is 0
+	 */
+	class PathfindingService* GetPathfinder() { return m_Pathfinder; }
+
+	/**
+	 * @return The crowd moving the enemies of the zone, nullptr without a navmesh or when navmesh_crowd is 0
+	 */
+	class CrowdManager* GetCrowd() { return m_Crowd; }
+
 	class dtNavMesh* GetdtNavMesh() { return m_NavMesh; }
 
 private:
 	void LoadNavmesh();
 
+	/**
+	 * Loads the navmesh with its tiles pointing into a mapping of the file instead of into copies,
+	 * so every world server running the zone shares the physical pages of the tiles
+	 *
+	 * @return Whether or not the navmesh was loaded, false leaves it to LoadNavmesh
+	 */
+	bool LoadMappedNavmesh(const std::filesystem::path& path);
+
+	/**
+	 * Maps the height grid of the zone, building it first if it is missing or out of date
+	 */
+	void LoadHeightGrid();
+
+	/**
+	 * @return The path of a file in the navmesh directory belonging to this zone
+	 */
+	std::filesystem::path GetNavmeshPath(const std::string& extension) const;
+
+	/**
+	 * Size of the steps endpoints are rounded to when caching lines of sight
+	 */
+	static constexpr float LINE_OF_SIGHT_CACHE_STEP = 1.0f;
+
+	/**
+	 * @return The closest polygon to a point, or 0 if there is none nearby
+	 */
+	dtPolyRef GetNearestPoly(const NiPoint3& point);
+
+	/**
+	 * Casts a ray from a known start polygon
+	 *
+	 * @return How far along the ray it hit the edge of the navmesh, 1 or more if it did not
+	 */
+	float RayCast(dtPolyRef startRef, const NiPoint3& from, const NiPoint3& to);
+
 	uint32_t m_ZoneId;
 
 	uint8_t* m_Triareas = nullptr;
@@ -38,4 +140,17 @@ private:
 	class dtNavMeshQuery* m_NavQuery = nullptr;
 	uint8_t m_NavMeshDrawFlags;
 	rcContext* m_Ctx = nullptr;
+
+	class PathfindingService* m_Pathfinder = nullptr;
+
+	class CrowdManager* m_Crowd = nullptr;
+
+	HeightGrid m_HeightGrid;
+
+	/**
+	 * The navmesh file when it was loaded by LoadMappedNavmesh, must outlive m_NavMesh
+	 */
+	MappedFile m_NavMeshFile;
+
+	std::unordered_map<SegmentKey, bool, SegmentKeyHash> m_LineOfSightCache;
 };
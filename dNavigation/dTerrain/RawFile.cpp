@@ -43,16 +43,19 @@ RawFile::~RawFile() {
 }
 
 void RawFile::GenerateFinalMeshFromChunks() {
+	m_FinalMesh = new RawMesh();
+
 	uint32_t lenOfLastChunk = 0; // index of last vert set in the last chunk
 
 	for (const auto& chunk : m_Chunks) {
+		const auto scale = chunk->m_HeightMap->m_ScaleFactor;
+
 		for (const auto& vert : chunk->m_Mesh->m_Vertices) {
 			auto tempVert = vert;
 
-			tempVert.SetX(tempVert.GetX() + (chunk->m_X / 4));
-			tempVert.SetZ(tempVert.GetZ() + (chunk->m_Z / 4));
-
-			tempVert* chunk->m_HeightMap->m_ScaleFactor;
+			// Vertices are laid out one height map sample apart, starting at the position of the chunk
+			tempVert.SetX(tempVert.GetX() * scale + chunk->m_X);
+			tempVert.SetZ(tempVert.GetZ() * scale + chunk->m_Z);
 
 			m_FinalMesh->m_Vertices.push_back(tempVert);
 		}
@@ -11,6 +11,11 @@ public:
 	RawFile(std::string filePath);
 	~RawFile();
 
+	/**
+	 * @return The triangles of every chunk in world space, nullptr if the file could not be read
+	 */
+	const RawMesh* GetMesh() const { return m_FinalMesh; }
+
 private:
 
 	void GenerateFinalMeshFromChunks();
@@ -23,5 +28,5 @@ private:
 	uint32_t m_Height;
 
 	std::vector<RawChunk*> m_Chunks;
-	RawMesh* m_FinalMesh;
+	RawMesh* m_FinalMesh = nullptr;
 };
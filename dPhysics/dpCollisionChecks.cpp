@@ -7,17 +7,42 @@
 #include <iostream>
 #include <algorithm>
 
+//SSE2 is part of every x86-64 CPU, AVX2 is only used after checking the CPU supports it.
+#if defined(__x86_64__) || defined(_M_X64)
+#define DP_SIMD_SSE2
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DP_SIMD_AVX2 __attribute__((target("avx2")))
+#elif defined(__AVX2__)
+#define DP_SIMD_AVX2
+#endif
+#endif
+
 using namespace dpCollisionChecks;
 
 bool dpCollisionChecks::AreColliding(dpEntity* a, dpEntity* b) {
 	auto shapeA = a->GetShape();
 	auto shapeB = b->GetShape();
 
+	if (!shapeA || !shapeB) return false;
+
+	const auto typeA = shapeA->GetShapeType();
+	const auto typeB = shapeB->GetShapeType();
+
 	//Sphere to sphere collision
-	if (shapeA->GetShapeType() == dpShapeType::Sphere && shapeB->GetShapeType() == dpShapeType::Sphere) {
+	if (typeA == dpShapeType::Sphere && typeB == dpShapeType::Sphere) {
 		return CheckSpheres(a, b);
 	}
 
+	if (typeA == dpShapeType::Box && typeB == dpShapeType::Box) {
+		return CheckBoxes(a, b);
+	}
+
+	if ((typeA == dpShapeType::Box && typeB == dpShapeType::Sphere) || (typeA == dpShapeType::Sphere && typeB == dpShapeType::Box)) {
+		return CheckSphereBox(a, b);
+	}
+
 	return false;
 }
 
@@ -43,39 +68,11 @@ bool dpCollisionChecks::CheckBoxes(dpEntity* a, dpEntity* b) {
 	auto boxA = static_cast<dpShapeBox*>(a->GetShape());
 	auto boxB = static_cast<dpShapeBox*>(b->GetShape());
 
-	const auto& posA = a->GetPosition();
-	const auto& posB = b->GetPosition();
-
-	for (const auto& vert : boxA->GetVertices()) {
-		if (boxB->IsVertInBox(vert))
-			return true;
-	}
-
-	/*//Check if we're overlapping on X/Z:
-	if ((boxA->GetMaxWidth() >= boxB->GetMinWidth()) && //If our max width is greater than starting X of b
-		(boxA->GetMinWidth() <= boxB->GetMaxWidth()) && //If our start x is less than b's max width
-		(boxA->GetMaxDepth() >= boxB->GetMinDepth()) &&
-		(boxA->GetMinDepth() <= boxB->GetMaxDepth())) {
-
-		//Check if we're in the right height
-		if (boxA->GetTop() <= boxB->GetTop() && boxA->GetTop() >= boxB->GetBottom() || //If our top Y is within their minY/maxY bounds
-			boxA->GetBottom() <= boxB->GetTop() && boxA->GetBottom() >= boxB->GetBottom()) //Or our bottom Y
-			return true; //We definitely are colliding.
-	}*/
-
-	/*//Check if we're overlapping on X/Z:
-	if ((boxA->GetMaxWidth() >= posB.x) && //If our max width is greater than starting X of b
-		(posA.x <= boxB->GetMaxWidth()) && //If our start x is less than b's max width
-		(boxA->GetMaxDepth() >= posB.z) &&
-		(posA.z <= boxB->GetMaxDepth())) {
-
-		//Check if we're in the right height
-		if (boxA->GetTop() <= boxB->GetTop() && boxA->GetTop() >= posB.y || //If our top Y is within their minY/maxY bounds
-			posA.y <= boxB->GetTop() && posA.y >= posB.y) //Or our bottom Y
-			return true; //We definitely are colliding.
-	}*/
-
-	return false;
+	//The bounds of both boxes have to overlap on every axis, this also catches boxes that
+	//cross each other without either having a corner inside the other:
+	return boxA->m_MinX <= boxB->m_MaxX && boxA->m_MaxX >= boxB->m_MinX
+		&& boxA->m_MinY <= boxB->m_MaxY && boxA->m_MaxY >= boxB->m_MinY
+		&& boxA->m_MinZ <= boxB->m_MaxZ && boxA->m_MaxZ >= boxB->m_MinZ;
 }
 
 bool dpCollisionChecks::CheckSphereBox(dpEntity* a, dpEntity* b) {
@@ -114,3 +111,330 @@ bool dpCollisionChecks::CheckSphereBox(dpEntity* a, dpEntity* b) {
 
 	return distanceSquared < radius* radius;
 }
+
+void SphereBatch::Add(const NiPoint3& center, float sphereRadius) {
+	x.push_back(center.x);
+	y.push_back(center.y);
+	z.push_back(center.z);
+	radius.push_back(sphereRadius);
+}
+
+void SphereBatch::Clear() {
+	x.clear();
+	y.clear();
+	z.clear();
+	radius.clear();
+}
+
+void BoxBatch::Add(const NiPoint3& min, const NiPoint3& max) {
+	minX.push_back(min.x);
+	minY.push_back(min.y);
+	minZ.push_back(min.z);
+	maxX.push_back(max.x);
+	maxY.push_back(max.y);
+	maxZ.push_back(max.z);
+}
+
+void BoxBatch::Clear() {
+	minX.clear();
+	minY.clear();
+	minZ.clear();
+	maxX.clear();
+	maxY.clear();
+	maxZ.clear();
+}
+
+SimdLevel dpCollisionChecks::GetSimdLevel() {
+#if defined(DP_SIMD_AVX2) && (defined(__GNUC__) || defined(__clang__))
+	static const auto level = __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::SSE2;
+	return level;
+#elif defined(DP_SIMD_AVX2)
+	return SimdLevel::AVX2;
+#elif defined(DP_SIMD_SSE2)
+	return SimdLevel::SSE2;
+#else
+	return SimdLevel::Scalar;
+#endif
+}
+
+/*
+ * Scalar checks, used on their own and to finish the elements left over by the vector checks.
+ * They do the same operations in the same order as the pair by pair checks, so both agree exactly.
+ */
+
+static void CheckSpheresScalar(const NiPoint3& center, float radius, const SphereBatch& spheres, uint8_t* results, size_t begin) {
+	for (auto i = begin; i < spheres.Size(); ++i) {
+		const auto dx = spheres.x[i] - center.x;
+		const auto dy = spheres.y[i] - center.y;
+		const auto dz = spheres.z[i] - center.z;
+		const auto sum = spheres.radius[i] + radius;
+
+		results[i] = dx * dx + dy * dy + dz * dz <= sum * sum;
+	}
+}
+
+static void CheckBoxesScalar(const NiPoint3& min, const NiPoint3& max, const BoxBatch& boxes, uint8_t* results, size_t begin) {
+	for (auto i = begin; i < boxes.Size(); ++i) {
+		results[i] = boxes.minX[i] <= max.x && boxes.maxX[i] >= min.x
+			&& boxes.minY[i] <= max.y && boxes.maxY[i] >= min.y
+			&& boxes.minZ[i] <= max.z && boxes.maxZ[i] >= min.z;
+	}
+}
+
+static void CheckSphereBoxesScalar(const NiPoint3& center, float radius, const BoxBatch& boxes, uint8_t* results, size_t begin) {
+	for (auto i = begin; i < boxes.Size(); ++i) {
+		const auto dx = std::max(boxes.minX[i], std::min(center.x, boxes.maxX[i])) - center.x;
+		const auto dy = std::max(boxes.minY[i], std::min(center.y, boxes.maxY[i])) - center.y;
+		const auto dz = std::max(boxes.minZ[i], std::min(center.z, boxes.maxZ[i])) - center.z;
+
+		results[i] = dx * dx + dy * dy + dz * dz < radius * radius;
+	}
+}
+
+static void CheckBoxSpheresScalar(const NiPoint3& min, const NiPoint3& max, const SphereBatch& spheres, uint8_t* results, size_t begin) {
+	for (auto i = begin; i < spheres.Size(); ++i) {
+		const auto dx = std::max(min.x, std::min(spheres.x[i], max.x)) - spheres.x[i];
+		const auto dy = std::max(min.y, std::min(spheres.y[i], max.y)) - spheres.y[i];
+		const auto dz = std::max(min.z, std::min(spheres.z[i], max.z)) - spheres.z[i];
+
+		results[i] = dx * dx + dy * dy + dz * dz < spheres.radius[i] * spheres.radius[i];
+	}
+}
+
+#ifdef DP_SIMD_SSE2
+static inline void StoreMask(int mask, size_t count, uint8_t* results) {
+	for (size_t lane = 0; lane < count; ++lane) {
+		results[lane] = (mask >> lane) & 1;
+	}
+}
+
+static size_t CheckSpheresSSE2(const NiPoint3& center, float radius, const SphereBatch& spheres, uint8_t* results, size_t begin) {
+	const auto cx = _mm_set1_ps(center.x);
+	const auto cy = _mm_set1_ps(center.y);
+	const auto cz = _mm_set1_ps(center.z);
+	const auto r = _mm_set1_ps(radius);
+
+	auto i = begin;
+	for (; i + 4 <= spheres.Size(); i += 4) {
+		const auto dx = _mm_sub_ps(_mm_loadu_ps(&spheres.x[i]), cx);
+		const auto dy = _mm_sub_ps(_mm_loadu_ps(&spheres.y[i]), cy);
+		const auto dz = _mm_sub_ps(_mm_loadu_ps(&spheres.z[i]), cz);
+		const auto sum = _mm_add_ps(_mm_loadu_ps(&spheres.radius[i]), r);
+
+		const auto distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+		StoreMask(_mm_movemask_ps(_mm_cmple_ps(distance, _mm_mul_ps(sum, sum))), 4, results + i);
+	}
+
+	return i;
+}
+
+static size_t CheckBoxesSSE2(const NiPoint3& min, const NiPoint3& max, const BoxBatch& boxes, uint8_t* results, size_t begin) {
+	const auto minX = _mm_set1_ps(min.x);
+	const auto minY = _mm_set1_ps(min.y);
+	const auto minZ = _mm_set1_ps(min.z);
+	const auto maxX = _mm_set1_ps(max.x);
+	const auto maxY = _mm_set1_ps(max.y);
+	const auto maxZ = _mm_set1_ps(max.z);
+
+	auto i = begin;
+	for (; i + 4 <= boxes.Size(); i += 4) {
+		auto overlap = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&boxes.minX[i]), maxX), _mm_cmpge_ps(_mm_loadu_ps(&boxes.maxX[i]), minX));
+		overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&boxes.minY[i]), maxY), _mm_cmpge_ps(_mm_loadu_ps(&boxes.maxY[i]), minY)));
+		overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&boxes.minZ[i]), maxZ), _mm_cmpge_ps(_mm_loadu_ps(&boxes.maxZ[i]), minZ)));
+
+		StoreMask(_mm_movemask_ps(overlap), 4, results + i);
+	}
+
+	return i;
+}
+
+static size_t CheckSphereBoxesSSE2(const NiPoint3& center, float radius, const BoxBatch& boxes, uint8_t* results, size_t begin) {
+	const auto cx = _mm_set1_ps(center.x);
+	const auto cy = _mm_set1_ps(center.y);
+	const auto cz = _mm_set1_ps(center.z);
+	const auto r = _mm_set1_ps(radius * radius);
+
+	auto i = begin;
+	for (; i + 4 <= boxes.Size(); i += 4) {
+		const auto dx = _mm_sub_ps(_mm_max_ps(_mm_loadu_ps(&boxes.minX[i]), _mm_min_ps(cx, _mm_loadu_ps(&boxes.maxX[i]))), cx);
+		const auto dy = _mm_sub_ps(_mm_max_ps(_mm_loadu_ps(&boxes.minY[i]), _mm_min_ps(cy, _mm_loadu_ps(&boxes.maxY[i]))), cy);
+		const auto dz = _mm_sub_ps(_mm_max_ps(_mm_loadu_ps(&boxes.minZ[i]), _mm_min_ps(cz, _mm_loadu_ps(&boxes.maxZ[i]))), cz);
+
+		const auto distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+		StoreMask(_mm_movemask_ps(_mm_cmplt_ps(distance, r)), 4, results + i);
+	}
+
+	return i;
+}
+
+static size_t CheckBoxSpheresSSE2(const NiPoint3& min, const NiPoint3& max, const SphereBatch& spheres, uint8_t* results, size_t begin) {
+	const auto minX = _mm_set1_ps(min.x);
+	const auto minY = _mm_set1_ps(min.y);
+	const auto minZ = _mm_set1_ps(min.z);
+	const auto maxX = _mm_set1_ps(max.x);
+	const auto maxY = _mm_set1_ps(max.y);
+	const auto maxZ = _mm_set1_ps(max.z);
+
+	auto i = begin;
+	for (; i + 4 <= spheres.Size(); i += 4) {
+		const auto x = _mm_loadu_ps(&spheres.x[i]);
+		const auto y = _mm_loadu_ps(&spheres.y[i]);
+		const auto z = _mm_loadu_ps(&spheres.z[i]);
+		const auto r = _mm_loadu_ps(&spheres.radius[i]);
+
+		const auto dx = _mm_sub_ps(_mm_max_ps(minX, _mm_min_ps(x, maxX)), x);
+		const auto dy = _mm_sub_ps(_mm_max_ps(minY, _mm_min_ps(y, maxY)), y);
+		const auto dz = _mm_sub_ps(_mm_max_ps(minZ, _mm_min_ps(z, maxZ)), z);
+
+		const auto distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+		StoreMask(_mm_movemask_ps(_mm_cmplt_ps(distance, _mm_mul_ps(r, r))), 4, results + i);
+	}
+
+	return i;
+}
+#endif
+
+#ifdef DP_SIMD_AVX2
+DP_SIMD_AVX2 static size_t CheckSpheresAVX2(const NiPoint3& center, float radius, const SphereBatch& spheres, uint8_t* results, size_t begin) {
+	const auto cx = _mm256_set1_ps(center.x);
+	const auto cy = _mm256_set1_ps(center.y);
+	const auto cz = _mm256_set1_ps(center.z);
+	const auto r = _mm256_set1_ps(radius);
+
+	auto i = begin;
+	for (; i + 8 <= spheres.Size(); i += 8) {
+		const auto dx = _mm256_sub_ps(_mm256_loadu_ps(&spheres.x[i]), cx);
+		const auto dy = _mm256_sub_ps(_mm256_loadu_ps(&spheres.y[i]), cy);
+		const auto dz = _mm256_sub_ps(_mm256_loadu_ps(&spheres.z[i]), cz);
+		const auto sum = _mm256_add_ps(_mm256_loadu_ps(&spheres.radius[i]), r);
+
+		const auto distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+
+		StoreMask(_mm256_movemask_ps(_mm256_cmp_ps(distance, _mm256_mul_ps(sum, sum), _CMP_LE_OQ)), 8, results + i);
+	}
+
+	return i;
+}
+
+DP_SIMD_AVX2 static size_t CheckBoxesAVX2(const NiPoint3& min, const NiPoint3& max, const BoxBatch& boxes, uint8_t* results, size_t begin) {
+	const auto minX = _mm256_set1_ps(min.x);
+	const auto minY = _mm256_set1_ps(min.y);
+	const auto minZ = _mm256_set1_ps(min.z);
+	const auto maxX = _mm256_set1_ps(max.x);
+	const auto maxY = _mm256_set1_ps(max.y);
+	const auto maxZ = _mm256_set1_ps(max.z);
+
+	auto i = begin;
+	for (; i + 8 <= boxes.Size(); i += 8) {
+		auto overlap = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&boxes.minX[i]), maxX, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&boxes.maxX[i]), minX, _CMP_GE_OQ));
+		overlap = _mm256_and_ps(overlap, _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&boxes.minY[i]), maxY, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&boxes.maxY[i]), minY, _CMP_GE_OQ)));
+		overlap = _mm256_and_ps(overlap, _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&boxes.minZ[i]), maxZ, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&boxes.maxZ[i]), minZ, _CMP_GE_OQ)));
+
+		StoreMask(_mm256_movemask_ps(overlap), 8, results + i);
+	}
+
+	return i;
+}
+
+DP_SIMD_AVX2 static size_t CheckSphereBoxesAVX2(const NiPoint3& center, float radius, const BoxBatch& boxes, uint8_t* results, size_t begin) {
+	const auto cx = _mm256_set1_ps(center.x);
+	const auto cy = _mm256_set1_ps(center.y);
+	const auto cz = _mm256_set1_ps(center.z);
+	const auto r = _mm256_set1_ps(radius * radius);
+
+	auto i = begin;
+	for (; i + 8 <= boxes.Size(); i += 8) {
+		const auto dx = _mm256_sub_ps(_mm256_max_ps(_mm256_loadu_ps(&boxes.minX[i]), _mm256_min_ps(cx, _mm256_loadu_ps(&boxes.maxX[i]))), cx);
+		const auto dy = _mm256_sub_ps(_mm256_max_ps(_mm256_loadu_ps(&boxes.minY[i]), _mm256_min_ps(cy, _mm256_loadu_ps(&boxes.maxY[i]))), cy);
+		const auto dz = _mm256_sub_ps(_mm256_max_ps(_mm256_loadu_ps(&boxes.minZ[i]), _mm256_min_ps(cz, _mm256_loadu_ps(&boxes.maxZ[i]))), cz);
+
+		const auto distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+
+		StoreMask(_mm256_movemask_ps(_mm256_cmp_ps(distance, r, _CMP_LT_OQ)), 8, results + i);
+	}
+
+	return i;
+}
+
+DP_SIMD_AVX2 static size_t CheckBoxSpheresAVX2(const NiPoint3& min, const NiPoint3& max, const SphereBatch& spheres, uint8_t* results, size_t begin) {
+	const auto minX = _mm256_set1_ps(min.x);
+	const auto minY = _mm256_set1_ps(min.y);
+	const auto minZ = _mm256_set1_ps(min.z);
+	const auto maxX = _mm256_set1_ps(max.x);
+	const auto maxY = _mm256_set1_ps(max.y);
+	const auto maxZ = _mm256_set1_ps(max.z);
+
+	auto i = begin;
+	for (; i + 8 <= spheres.Size(); i += 8) {
+		const auto x = _mm256_loadu_ps(&spheres.x[i]);
+		const auto y = _mm256_loadu_ps(&spheres.y[i]);
+		const auto z = _mm256_loadu_ps(&spheres.z[i]);
+		const auto r = _mm256_loadu_ps(&spheres.radius[i]);
+
+		const auto dx = _mm256_sub_ps(_mm256_max_ps(minX, _mm256_min_ps(x, maxX)), x);
+		const auto dy = _mm256_sub_ps(_mm256_max_ps(minY, _mm256_min_ps(y, maxY)), y);
+		const auto dz = _mm256_sub_ps(_mm256_max_ps(minZ, _mm256_min_ps(z, maxZ)), z);
+
+		const auto distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+
+		StoreMask(_mm256_movemask_ps(_mm256_cmp_ps(distance, _mm256_mul_ps(r, r), _CMP_LT_OQ)), 8, results + i);
+	}
+
+	return i;
+}
+#endif
+
+void dpCollisionChecks::CheckSpheres(const NiPoint3& center, float radius, const SphereBatch& spheres, uint8_t* results, SimdLevel level) {
+	size_t done = 0;
+
+#ifdef DP_SIMD_AVX2
+	if (level == SimdLevel::AVX2) done = CheckSpheresAVX2(center, radius, spheres, results, done);
+#endif
+#ifdef DP_SIMD_SSE2
+	if (level != SimdLevel::Scalar) done = CheckSpheresSSE2(center, radius, spheres, results, done);
+#endif
+
+	CheckSpheresScalar(center, radius, spheres, results, done);
+}
+
+void dpCollisionChecks::CheckBoxes(const NiPoint3& min, const NiPoint3& max, const BoxBatch& boxes, uint8_t* results, SimdLevel level) {
+	size_t done = 0;
+
+#ifdef DP_SIMD_AVX2
+	if (level == SimdLevel::AVX2) done = CheckBoxesAVX2(min, max, boxes, results, done);
+#endif
+#ifdef DP_SIMD_SSE2
+	if (level != SimdLevel::Scalar) done = CheckBoxesSSE2(min, max, boxes, results, done);
+#endif
+
+	CheckBoxesScalar(min, max, boxes, results, done);
+}
+
+void dpCollisionChecks::CheckSphereBoxes(const NiPoint3& center, float radius, const BoxBatch& boxes, uint8_t* results, SimdLevel level) {
+	size_t done = 0;
+
+#ifdef DP_SIMD_AVX2
+	if (level == SimdLevel::AVX2) done = CheckSphereBoxesAVX2(center, radius, boxes, results, done);
+#endif
+#ifdef DP_SIMD_SSE2
+	if (level != SimdLevel::Scalar) done = CheckSphereBoxesSSE2(center, radius, boxes, results, done);
+#endif
+
+	CheckSphereBoxesScalar(center, radius, boxes, results, done);
+}
+
+void dpCollisionChecks::CheckBoxSpheres(const NiPoint3& min, const NiPoint3& max, const SphereBatch& spheres, uint8_t* results, SimdLevel level) {
+	size_t done = 0;
+
+#ifdef DP_SIMD_AVX2
+	if (level == SimdLevel::AVX2) done = CheckBoxSpheresAVX2(min, max, spheres, results, done);
+#endif
+#ifdef DP_SIMD_SSE2
+	if (level != SimdLevel::Scalar) done = CheckBoxSpheresSSE2(min, max, spheres, results, done);
+#endif
+
+	CheckBoxSpheresScalar(min, max, spheres, results, done);
+}
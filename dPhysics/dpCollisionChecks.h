@@ -1,4 +1,10 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "NiPoint3.h"
+
 class dpEntity;
 
 namespace dpCollisionChecks {
@@ -9,4 +15,61 @@ namespace dpCollisionChecks {
 	bool CheckBoxes(dpEntity* a, dpEntity* b);
 
 	bool CheckSphereBox(dpEntity* a, dpEntity* b);
+
+	/**
+	 * The instruction sets the batched checks can use, a batch is always finished with scalar code
+	 */
+	enum class SimdLevel : uint8_t {
+		Scalar,
+		SSE2,
+		AVX2
+	};
+
+	/**
+	 * @return The best instruction set supported by this CPU
+	 */
+	SimdLevel GetSimdLevel();
+
+	/**
+	 * Spheres stored as a structure of arrays, so a batch of them can be loaded straight into vector registers
+	 */
+	struct SphereBatch {
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> z;
+		std::vector<float> radius;
+
+		void Add(const NiPoint3& center, float sphereRadius);
+		void Clear();
+		size_t Size() const { return x.size(); }
+	};
+
+	/**
+	 * Axis aligned boxes stored as a structure of arrays
+	 */
+	struct BoxBatch {
+		std::vector<float> minX;
+		std::vector<float> minY;
+		std::vector<float> minZ;
+		std::vector<float> maxX;
+		std::vector<float> maxY;
+		std::vector<float> maxZ;
+
+		void Add(const NiPoint3& min, const NiPoint3& max);
+		void Clear();
+		size_t Size() const { return minX.size(); }
+	};
+
+	/*
+	 * Batched checks of one shape against every shape of a batch.  Each writes 1 to results[i] if the shape
+	 * collides with shape i of the batch and 0 otherwise, giving the same answers as the pair by pair checks.
+	 */
+
+	void CheckSpheres(const NiPoint3& center, float radius, const SphereBatch& spheres, uint8_t* results, SimdLevel level = GetSimdLevel());
+
+	void CheckBoxes(const NiPoint3& min, const NiPoint3& max, const BoxBatch& boxes, uint8_t* results, SimdLevel level = GetSimdLevel());
+
+	void CheckSphereBoxes(const NiPoint3& center, float radius, const BoxBatch& boxes, uint8_t* results, SimdLevel level = GetSimdLevel());
+
+	void CheckBoxSpheres(const NiPoint3& min, const NiPoint3& max, const SphereBatch& spheres, uint8_t* results, SimdLevel level = GetSimdLevel());
 };
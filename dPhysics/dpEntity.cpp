@@ -3,6 +3,7 @@
 #include "dpShapeBox.h"
 #include "dpGrid.h"
 
+#include <algorithm>
 #include <iostream>
 
 dpEntity::dpEntity(const LWOOBJID& objectID, dpShapeType shapeType, bool isStatic) {
@@ -70,29 +71,59 @@ void dpEntity::Update(float deltaTime) {
 }
 
 void dpEntity::CheckCollision(dpEntity* other) {
-	if (!m_CollisionShape) return;
+	if (!CanCollideWith(other)) return;
+
+	if (m_CollisionShape->IsColliding(other->GetShape())) AddCollision(other);
+}
+
+void dpEntity::AddCollision(const dpEntity* other) {
+	const auto id = other->GetObjectID();
+
+	auto it = std::lower_bound(m_CurrentlyCollidingObjects.begin(), m_CurrentlyCollidingObjects.end(), id, [](const dpCollidingObject& object, LWOOBJID value) {
+		return object.id < value;
+	});
 
-	if ((m_CollisionGroup & other->m_CollisionGroup) & (~COLLISION_GROUP_DYNAMIC)) {
+	if (it != m_CurrentlyCollidingObjects.end() && it->id == id) {
+		it->generation = m_Generation;
 		return;
 	}
 
-	bool wasFound = (m_CurrentlyCollidingObjects.find(other->GetObjectID()) != m_CurrentlyCollidingObjects.end());
-
-	bool isColliding = m_CollisionShape->IsColliding(other->GetShape());
+	m_CurrentlyCollidingObjects.insert(it, { id, m_Generation });
+	m_NewObjects.push_back(id);
+}
 
-	if (isColliding && !wasFound) {
-		m_CurrentlyCollidingObjects.emplace(other->GetObjectID(), other);
-		m_NewObjects.push_back(other);
+void dpEntity::PostUpdate() {
+	//Everything that was not found colliding during this update has left:
+	auto* kept = m_CurrentlyCollidingObjects.begin();
 
-		//if (m_CollisionShape->GetShapeType() == dpShapeType::Sphere && other->GetShape()->GetShapeType() == dpShapeType::Sphere)
-			//std::cout << "started sphere col at: " << other->GetPosition().x << ", " << other->GetPosition().y << ", " << other->GetPosition().z << std::endl;
-	} else if (!isColliding && wasFound) {
-		m_CurrentlyCollidingObjects.erase(other->GetObjectID());
-		m_RemovedObjects.push_back(other);
+	for (auto& object : m_CurrentlyCollidingObjects) {
+		if (object.generation != m_Generation) {
+			m_RemovedObjects.push_back(object.id);
+			continue;
+		}
 
-		//if (m_CollisionShape->GetShapeType() == dpShapeType::Sphere && other->GetShape()->GetShapeType() == dpShapeType::Sphere)
-		//	std::cout << "stopped sphere col at: " << other->GetPosition().x << ", " << other->GetPosition().y << ", " << other->GetPosition().z << std::endl;
+		*kept++ = object;
 	}
+
+	m_CurrentlyCollidingObjects.erase(kept, m_CurrentlyCollidingObjects.end());
+}
+
+bool dpEntity::CanCollideWith(const dpEntity* other) const {
+	if (!m_CollisionShape) return false;
+
+	return ((m_CollisionGroup & other->m_CollisionGroup) & (~COLLISION_GROUP_DYNAMIC)) == 0;
+}
+
+bool dpEntity::IsCollidingWith(const dpEntity* other) const {
+	return GetCurrentlyCollidingObjects().Contains(other->GetObjectID());
+}
+
+bool dpCollidingObjects::Contains(LWOOBJID id) const {
+	auto it = std::lower_bound(m_Begin, m_End, id, [](const dpCollidingObject& object, LWOOBJID value) {
+		return object.id < value;
+	});
+
+	return it != m_End && it->id == id;
 }
 
 void dpEntity::SetPosition(const NiPoint3& newPos) {
@@ -2,14 +2,44 @@
 #include "NiPoint3.h"
 #include "NiQuaternion.h"
 #include <vector>
-#include <map>
 
 #include "dCommonVars.h"
+#include "SmallVector.h"
 #include "dpCommon.h"
 #include "dpShapeBase.h"
 #include "dpCollisionGroups.h"
 #include "dpGrid.h"
 
+/**
+ * An object colliding with an entity, stamped with the last update that found it colliding
+ */
+struct dpCollidingObject {
+	LWOOBJID id;
+	uint32_t generation;
+};
+
+/**
+ * A read only view of the objects colliding with an entity, sorted by object id.
+ * Only valid until the next physics update or until the entity is deleted.
+ */
+class dpCollidingObjects {
+public:
+	dpCollidingObjects() = default;
+	dpCollidingObjects(const dpCollidingObject* begin, const dpCollidingObject* end) : m_Begin(begin), m_End(end) {}
+
+	const dpCollidingObject* begin() const { return m_Begin; }
+	const dpCollidingObject* end() const { return m_End; }
+
+	size_t size() const { return m_End - m_Begin; }
+	bool empty() const { return m_Begin == m_End; }
+
+	bool Contains(LWOOBJID id) const;
+
+private:
+	const dpCollidingObject* m_Begin = nullptr;
+	const dpCollidingObject* m_End = nullptr;
+};
+
 class dpEntity {
 	friend class dpGrid; //using friend here for now so grid can access everything
 
@@ -25,6 +55,22 @@ public:
 
 	void CheckCollision(dpEntity* other);
 
+	/**
+	 * Marks other as colliding with this entity for the current update, adding it to the new objects
+	 * if it was not colliding before.  Objects that are not marked again before PostUpdate leave.
+	 */
+	void AddCollision(const dpEntity* other);
+
+	/**
+	 * @return Whether or not this entity has a shape and shares no collision group with other that keeps them from colliding
+	 */
+	bool CanCollideWith(const dpEntity* other) const;
+
+	/**
+	 * @return Whether or not other was colliding with this entity as of the last check
+	 */
+	bool IsCollidingWith(const dpEntity* other) const;
+
 	const NiPoint3& GetPosition() const { return m_Position; }
 	const NiQuaternion& GetRotation() const { return m_Rotation; }
 	const float GetScale() const { return m_Scale; }
@@ -49,11 +95,28 @@ public:
 	bool GetSleeping() const { return m_Sleeping; }
 	void SetSleeping(bool value) { m_Sleeping = value; }
 
-	const std::vector<dpEntity*>& GetNewObjects() const { return m_NewObjects; }
-	const std::vector<dpEntity*>& GetRemovedObjects() const { return m_RemovedObjects; }
-	const std::map<LWOOBJID, dpEntity*>& GetCurrentlyCollidingObjects() const { return m_CurrentlyCollidingObjects; }
+	/**
+	 * @return The objects that started colliding with this entity during the last update
+	 */
+	const std::vector<LWOOBJID>& GetNewObjects() const { return m_NewObjects; }
+
+	/**
+	 * @return The objects that stopped colliding with this entity during the last update, sorted by object id
+	 */
+	const std::vector<LWOOBJID>& GetRemovedObjects() const { return m_RemovedObjects; }
 
-	void PreUpdate() { m_NewObjects.clear();  m_RemovedObjects.clear(); }
+	dpCollidingObjects GetCurrentlyCollidingObjects() const { return dpCollidingObjects(m_CurrentlyCollidingObjects.begin(), m_CurrentlyCollidingObjects.end()); }
+
+	/**
+	 * Starts an update of the colliding objects, call before checking any collisions
+	 */
+	void PreUpdate() { m_NewObjects.clear();  m_RemovedObjects.clear(); m_Generation++; }
+
+	/**
+	 * Finishes an update of the colliding objects, every object that was not marked as colliding
+	 * since PreUpdate is moved to the removed objects.
+	 */
+	void PostUpdate();
 
 	const LWOOBJID& GetObjectID() const { return m_ObjectID; }
 
@@ -80,7 +143,15 @@ private:
 
 	bool m_IsGargantuan = false;
 
-	std::vector<dpEntity*> m_NewObjects;
-	std::vector<dpEntity*> m_RemovedObjects;
-	std::map<LWOOBJID, dpEntity*> m_CurrentlyCollidingObjects;
+	//Where the grid keeps this entity, so it can be removed without searching for it
+	int m_CellIndex = -1;
+	uint32_t m_CellSlot = 0;
+	int m_GargantuanSlot = -1;
+
+	std::vector<LWOOBJID> m_NewObjects;
+	std::vector<LWOOBJID> m_RemovedObjects;
+
+	// Sorted by object id, most entities only ever collide with a few objects at once
+	SmallVector<dpCollidingObject, 4> m_CurrentlyCollidingObjects;
+	uint32_t m_Generation = 0;
 };
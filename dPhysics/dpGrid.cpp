@@ -1,165 +1,335 @@
 #include "dpGrid.h"
 #include "dpEntity.h"
+#include "dpShapeBox.h"
+#include "dpShapeSphere.h"
+#include "WorkerPool.h"
 
+#include <algorithm>
 #include <cmath>
 
-dpGrid::dpGrid(int numCells, int cellSize) {
+dpGrid::dpGrid(int numCells, int cellSize, uint32_t threadCount) {
 	NUM_CELLS = numCells;
 	CELL_SIZE = cellSize;
 	m_DeleteGrid = true;
 
-	//dumb method but i can't be bothered
+	m_Cells.resize(NUM_CELLS * NUM_CELLS);
+	m_CellShapes.resize(NUM_CELLS * NUM_CELLS);
+	m_OccupiedSlots.resize(NUM_CELLS * NUM_CELLS, -1);
+	m_Stripes.resize(1);
 
-	//fill x
-	for (int i = 0; i < NUM_CELLS; i++) {
-		m_Cells.push_back(std::vector<std::forward_list<dpEntity*>>());
-	}
+	if (threadCount != 1) {
+		m_Workers = std::make_unique<WorkerPool>(threadCount);
 
-	//fill z
-	for (int i = 0; i < NUM_CELLS; i++) {
-		for (int i = 0; i < NUM_CELLS; i++) {
-			m_Cells[i].push_back(std::forward_list<dpEntity*>());
-		}
+		if (m_Workers->GetThreadCount() == 1) m_Workers.reset();
 	}
 }
 
 dpGrid::~dpGrid() {
-	if (!this->m_DeleteGrid) return;
-	for (auto& x : m_Cells) { //x
-		for (auto& y : x) { //y
-			for (auto en : y) {
-				if (!en) continue;
+	for (auto& cell : m_Cells) {
+		for (auto en : cell) {
+			if (!en) continue;
+
+			if (this->m_DeleteGrid) {
 				delete en;
-				en = nullptr;
+				continue;
 			}
+
+			//The entities outlive the grid, so they may be added to a new one
+			en->m_CellIndex = -1;
+			en->m_GargantuanSlot = -1;
 		}
 	}
 }
 
-void dpGrid::Add(dpEntity* entity) {
-	//Determine which grid cell it's in.
-	int cellX = (int)std::round(entity->m_Position.x) / dpGrid::CELL_SIZE + NUM_CELLS / 2;
-	int cellZ = (int)std::round(entity->m_Position.z) / dpGrid::CELL_SIZE + NUM_CELLS / 2;
+std::vector<dpEntity*> dpGrid::GetEntities() const {
+	std::vector<dpEntity*> entities;
+
+	for (const auto cell : m_OccupiedCells) {
+		entities.insert(entities.end(), m_Cells[cell].begin(), m_Cells[cell].end());
+	}
+
+	return entities;
+}
+
+int dpGrid::GetCellIndex(float x, float z) const {
+	int cellX = (int)std::round(x) / CELL_SIZE + NUM_CELLS / 2;
+	int cellZ = (int)std::round(z) / CELL_SIZE + NUM_CELLS / 2;
 
 	if (cellX < 0) cellX = 0;
 	if (cellZ < 0) cellZ = 0;
-	if (cellX > NUM_CELLS) cellX = NUM_CELLS;
-	if (cellZ > NUM_CELLS) cellZ = NUM_CELLS;
+	if (cellX >= NUM_CELLS) cellX = NUM_CELLS - 1;
+	if (cellZ >= NUM_CELLS) cellZ = NUM_CELLS - 1;
 
-	//Add to cell:
-	m_Cells[cellX][cellZ].push_front(entity);
+	return cellX * NUM_CELLS + cellZ;
+}
 
-	//To verify that the object isn't gargantuan:
-	if (entity->GetScale() >= CELL_SIZE * 2 || entity->GetIsGargantuan())
-		m_GargantuanObjects.insert(std::make_pair(entity->m_ObjectID, entity));
+void dpGrid::AddToCell(dpEntity* entity, int cell) {
+	auto& entities = m_Cells[cell];
+
+	if (entities.empty()) {
+		m_OccupiedSlots[cell] = m_OccupiedCells.size();
+		m_OccupiedCells.push_back(cell);
+	}
+
+	entity->m_CellIndex = cell;
+	entity->m_CellSlot = entities.size();
+	entities.push_back(entity);
+
+	m_EntityCount++;
 }
 
-void dpGrid::Move(dpEntity* entity, float x, float z) {
-	int oldCellX = (int)std::round(entity->m_Position.x) / dpGrid::CELL_SIZE + NUM_CELLS / 2;
-	int oldCellZ = (int)std::round(entity->m_Position.z) / dpGrid::CELL_SIZE + NUM_CELLS / 2;
+void dpGrid::RemoveFromCell(dpEntity* entity) {
+	const auto cell = entity->m_CellIndex;
+	if (cell < 0) return;
 
-	int cellX = (int)std::round(x) / dpGrid::CELL_SIZE + NUM_CELLS / 2;
-	int cellZ = (int)std::round(z) / dpGrid::CELL_SIZE + NUM_CELLS / 2;
+	auto& entities = m_Cells[cell];
 
-	if (cellX < 0) cellX = 0;
-	if (cellZ < 0) cellZ = 0;
-	if (cellX > NUM_CELLS) cellX = NUM_CELLS;
-	if (cellZ > NUM_CELLS) cellZ = NUM_CELLS;
+	//Swap the last entity of the cell into our slot:
+	auto* last = entities.back();
+	entities[entity->m_CellSlot] = last;
+	last->m_CellSlot = entity->m_CellSlot;
+	entities.pop_back();
 
-	if (oldCellX < 0) oldCellX = 0;
-	if (oldCellZ < 0) oldCellZ = 0;
-	if (oldCellX > NUM_CELLS) oldCellX = NUM_CELLS;
-	if (oldCellZ > NUM_CELLS) oldCellZ = NUM_CELLS;
+	entity->m_CellIndex = -1;
+	m_EntityCount--;
 
-	if (oldCellX == cellX && oldCellZ == cellZ) return;
+	if (!entities.empty()) return;
 
-	//Remove from perv cell:
-	m_Cells[oldCellX][oldCellZ].remove(entity);
+	//The cell is empty now, so swap the last occupied cell into its slot:
+	const auto slot = m_OccupiedSlots[cell];
+	const auto lastCell = m_OccupiedCells.back();
+	m_OccupiedCells[slot] = lastCell;
+	m_OccupiedSlots[lastCell] = slot;
+	m_OccupiedCells.pop_back();
+	m_OccupiedSlots[cell] = -1;
+
+	m_CellShapes[cell].Clear();
+}
+
+void dpGrid::Add(dpEntity* entity) {
+	//Determine which grid cell it's in.
+	AddToCell(entity, GetCellIndex(entity->m_Position.x, entity->m_Position.z));
+
+	//To verify that the object isn't gargantuan:
+	if ((entity->GetScale() >= CELL_SIZE * 2 || entity->GetIsGargantuan()) && entity->m_GargantuanSlot < 0) {
+		entity->m_GargantuanSlot = m_GargantuanObjects.size();
+		m_GargantuanObjects.push_back(entity);
+	}
+}
+
+void dpGrid::Move(dpEntity* entity, float x, float z) {
+	const auto cell = GetCellIndex(x, z);
+
+	if (cell == entity->m_CellIndex) return;
+
+	//Remove from prev cell:
+	RemoveFromCell(entity);
 
 	//Add to the new cell
-	m_Cells[cellX][cellZ].push_front(entity);
+	AddToCell(entity, cell);
 }
 
 void dpGrid::Delete(dpEntity* entity) {
 	if (!entity) return;
-	int oldCellX = (int)std::round(entity->m_Position.x) / dpGrid::CELL_SIZE + NUM_CELLS / 2;
-	int oldCellZ = (int)std::round(entity->m_Position.z) / dpGrid::CELL_SIZE + NUM_CELLS / 2;
 
-	if (oldCellX < 0) oldCellX = 0;
-	if (oldCellZ < 0) oldCellZ = 0;
-	if (oldCellX > NUM_CELLS) oldCellX = NUM_CELLS;
-	if (oldCellZ > NUM_CELLS) oldCellZ = NUM_CELLS;
+	RemoveFromCell(entity);
 
-	m_Cells[oldCellX][oldCellZ].remove(entity);
+	if (entity->m_GargantuanSlot >= 0) {
+		auto* last = m_GargantuanObjects.back();
+		m_GargantuanObjects[entity->m_GargantuanSlot] = last;
+		last->m_GargantuanSlot = entity->m_GargantuanSlot;
+		m_GargantuanObjects.pop_back();
+	}
+
+	delete entity;
+}
 
-	if (m_GargantuanObjects.find(entity->m_ObjectID) != m_GargantuanObjects.end())
-		m_GargantuanObjects.erase(entity->m_ObjectID);
+void dpGrid::CellShapes::Add(dpEntity* entity) {
+	auto* shape = entity->GetShape();
+	if (!shape) return;
+
+	if (shape->GetShapeType() == dpShapeType::Sphere) {
+		spheres.Add(entity->GetPosition(), static_cast<dpShapeSphere*>(shape)->GetRadius());
+		sphereEntities.push_back(entity);
+	} else if (shape->GetShapeType() == dpShapeType::Box) {
+		auto* box = static_cast<dpShapeBox*>(shape);
+		boxes.Add(NiPoint3(box->m_MinX, box->m_MinY, box->m_MinZ), NiPoint3(box->m_MaxX, box->m_MaxY, box->m_MaxZ));
+		boxEntities.push_back(entity);
+	}
+}
 
-	if (entity) delete entity;
-	entity = nullptr;
+void dpGrid::CellShapes::Clear() {
+	spheres.Clear();
+	boxes.Clear();
+	sphereEntities.clear();
+	boxEntities.clear();
 }
 
 void dpGrid::Update(float deltaTime) {
-	//Pre-update:
-	for (auto& x : m_Cells) { //x
-		for (auto& y : x) { //y
-			for (auto en : y) {
-				if (!en) continue;
-				en->PreUpdate();
-			}
-		}
+	//Only static entities are checked against others, so those are the only shapes that need batching:
+	m_GargantuanShapes.Clear();
+	for (auto en : m_GargantuanObjects) {
+		if (en->GetIsStatic()) m_GargantuanShapes.Add(en);
+	}
+
+	if (m_Workers && m_EntityCount >= MIN_PARALLEL_ENTITIES && m_OccupiedCells.size() > 1) {
+		UpdateParallel(deltaTime);
+		return;
+	}
+
+	//Pre-update, empty cells are never visited:
+	for (const auto cell : m_OccupiedCells) {
+		PrepareCell(cell);
 	}
 
 	//Actual collision detection update:
-	for (int x = 0; x < NUM_CELLS; x++) {
-		for (int y = 0; y < NUM_CELLS; y++) {
-			HandleCell(x, y, deltaTime);
+	for (const auto cell : m_OccupiedCells) {
+		HandleCell(cell, deltaTime, m_Stripes[0], true);
+	}
+
+	PostUpdate();
+}
+
+void dpGrid::PostUpdate() {
+	//Whatever was not found colliding during this update has left:
+	for (const auto cell : m_OccupiedCells) {
+		for (auto en : m_Cells[cell]) {
+			if (en->GetIsStatic()) en->PostUpdate();
 		}
 	}
 }
 
-void dpGrid::HandleEntity(dpEntity* entity, dpEntity* other) {
-	if (!entity || !other) return;
+void dpGrid::UpdateParallel(float deltaTime) {
+	const auto stripeCount = std::min<size_t>(m_Workers->GetThreadCount() * STRIPES_PER_THREAD, m_OccupiedCells.size());
+	const auto cellsPerStripe = (m_OccupiedCells.size() + stripeCount - 1) / stripeCount;
+
+	if (m_Stripes.size() < stripeCount) m_Stripes.resize(stripeCount);
+
+	const auto getRange = [this, cellsPerStripe](size_t stripe) {
+		const auto begin = std::min(stripe * cellsPerStripe, m_OccupiedCells.size());
+		return std::make_pair(begin, std::min(begin + cellsPerStripe, m_OccupiedCells.size()));
+	};
+
+	//Cells read the shapes of their neighbours, so every cell has to be prepared before any is handled:
+	m_Workers->Run(stripeCount, [this, &getRange](size_t stripe) {
+		const auto range = getRange(stripe);
+
+		for (auto i = range.first; i < range.second; ++i) {
+			PrepareCell(m_OccupiedCells[i]);
+		}
+	});
+
+	m_Workers->Run(stripeCount, [this, deltaTime, &getRange](size_t stripe) {
+		const auto range = getRange(stripe);
 
-	if (other->GetIsStatic())
-		other->CheckCollision(entity); //swap "other" and "entity" if you want dyn objs to handle collisions.
+		m_Stripes[stripe].changes.clear();
+
+		for (auto i = range.first; i < range.second; ++i) {
+			HandleCell(m_OccupiedCells[i], deltaTime, m_Stripes[stripe], false);
+		}
+	});
+
+	//Add in the order a single threaded update would have found them in:
+	for (size_t stripe = 0; stripe < stripeCount; ++stripe) {
+		for (const auto& change : m_Stripes[stripe].changes) {
+			change.entity->AddCollision(change.other);
+		}
+	}
+
+	PostUpdate();
 }
 
-void dpGrid::HandleCell(int x, int z, float deltaTime) {
-	auto& entities = m_Cells[x][z]; //vector of entities contained within this cell.
+void dpGrid::PrepareCell(int cell) {
+	auto& shapes = m_CellShapes[cell];
+	shapes.Clear();
 
-	for (auto en : entities) {
-		if (!en) continue;
-		if (en->GetIsStatic() || en->GetSleeping()) continue;
+	for (auto en : m_Cells[cell]) {
+		en->PreUpdate();
 
-		//Check against all entities that are in the same cell as us
-		for (auto other : entities)
-			HandleEntity(en, other);
+		if (en->GetIsStatic()) shapes.Add(en);
+	}
+}
+
+void dpGrid::HandleShapes(dpEntity* entity, const CellShapes& shapes, std::vector<uint8_t>& results, std::vector<CollisionChange>* changes) {
+	const auto count = std::max(shapes.spheres.Size(), shapes.boxes.Size());
+	if (count == 0) return;
 
-		//To try neighbouring cells as well: (can be disabled if needed)
-		//we only check 4 of the 8 neighbouring cells, otherwise we'd get duplicates and cpu cycles wasted...
+	if (results.size() < count) results.resize(count);
 
-		if (x > 0 && z > 0) {
-			for (auto other : m_Cells[x - 1][z - 1])
-				HandleEntity(en, other);
+	auto* shape = entity->GetShape();
+
+	if (shape->GetShapeType() == dpShapeType::Sphere) {
+		const auto radius = static_cast<dpShapeSphere*>(shape)->GetRadius();
+
+		if (shapes.spheres.Size() > 0) {
+			dpCollisionChecks::CheckSpheres(entity->GetPosition(), radius, shapes.spheres, results.data());
+			HandleResults(entity, shapes.sphereEntities, results, changes);
 		}
 
-		if (x > 0) {
-			for (auto other : m_Cells[x - 1][z])
-				HandleEntity(en, other);
+		if (shapes.boxes.Size() > 0) {
+			dpCollisionChecks::CheckSphereBoxes(entity->GetPosition(), radius, shapes.boxes, results.data());
+			HandleResults(entity, shapes.boxEntities, results, changes);
+		}
+	} else if (shape->GetShapeType() == dpShapeType::Box) {
+		auto* box = static_cast<dpShapeBox*>(shape);
+		const NiPoint3 min(box->m_MinX, box->m_MinY, box->m_MinZ);
+		const NiPoint3 max(box->m_MaxX, box->m_MaxY, box->m_MaxZ);
+
+		if (shapes.spheres.Size() > 0) {
+			dpCollisionChecks::CheckBoxSpheres(min, max, shapes.spheres, results.data());
+			HandleResults(entity, shapes.sphereEntities, results, changes);
 		}
 
-		if (z > 0) {
-			for (auto other : m_Cells[x][z - 1])
-				HandleEntity(en, other);
+		if (shapes.boxes.Size() > 0) {
+			dpCollisionChecks::CheckBoxes(min, max, shapes.boxes, results.data());
+			HandleResults(entity, shapes.boxEntities, results, changes);
 		}
+	}
+}
+
+void dpGrid::HandleResults(dpEntity* entity, const std::vector<dpEntity*>& others, const std::vector<uint8_t>& results, std::vector<CollisionChange>* changes) {
+	for (size_t i = 0; i < others.size(); ++i) {
+		auto* other = others[i];
+
+		//swap "other" and "entity" if you want dyn objs to handle collisions.
+		if (results[i] == 0 || !other->CanCollideWith(entity)) continue;
+
+		if (changes) {
+			changes->push_back({ other, entity });
+		} else {
+			other->AddCollision(entity);
+		}
+	}
+}
 
-		if (x > 0 && z < NUM_CELLS - 1) {
-			for (auto other : m_Cells[x - 1][z + 1])
-				HandleEntity(en, other);
+void dpGrid::HandleCell(int cell, float deltaTime, Stripe& stripe, bool applyChanges) {
+	const auto& entities = m_Cells[cell]; //entities contained within this cell.
+	auto* changes = applyChanges ? nullptr : &stripe.changes;
+
+	const auto x = cell / NUM_CELLS;
+	const auto z = cell % NUM_CELLS;
+
+	for (auto en : entities) {
+		if (en->GetIsStatic() || en->GetSleeping() || !en->GetShape()) continue;
+
+		//Check against all entities that are in the same cell as us
+		HandleShapes(en, m_CellShapes[cell], stripe.results, changes);
+
+		//Check against all 8 neighbouring cells as well, the check only goes from dynamic to static entities so
+		//a phantom on any side may reach into our cell.  AddCollision ignores an object found twice in a step.
+		for (int dx = -1; dx <= 1; dx++) {
+			for (int dz = -1; dz <= 1; dz++) {
+				if (dx == 0 && dz == 0) continue;
+
+				const auto nx = x + dx;
+				const auto nz = z + dz;
+
+				if (nx < 0 || nz < 0 || nx >= NUM_CELLS || nz >= NUM_CELLS) continue;
+
+				HandleShapes(en, m_CellShapes[nx * NUM_CELLS + nz], stripe.results, changes);
+			}
 		}
 
-		for (auto other : m_GargantuanObjects)
-			HandleEntity(en, other.second);
+		HandleShapes(en, m_GargantuanShapes, stripe.results, changes);
 	}
 }
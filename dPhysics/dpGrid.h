@@ -1,11 +1,11 @@
 #pragma once
+#include <memory>
 #include <vector>
-#include <list>
-#include <forward_list>
-#include <map>
 #include "dCommonVars.h"
+#include "dpCollisionChecks.h"
 
 class dpEntity;
+class WorkerPool;
 
 class dpGrid {
 public:
@@ -14,7 +14,10 @@ public:
 	int CELL_SIZE = 205; //64 * 3.2 = 204.8 rounded up
 
 public:
-	dpGrid(int numCells, int cellSize);
+	/**
+	 * @param threadCount The number of threads to check collisions on, 0 uses every hardware thread
+	 */
+	dpGrid(int numCells, int cellSize, uint32_t threadCount = 1);
 	~dpGrid();
 
 	void Add(dpEntity* entity);
@@ -30,15 +33,112 @@ public:
 	 */
 	void SetDeleteGrid(bool value) { this->m_DeleteGrid = value; };
 
-	std::vector<std::vector<std::forward_list<dpEntity*>>> GetCells() { return this->m_Cells; };
+	/**
+	 * @return Every entity in the grid
+	 */
+	std::vector<dpEntity*> GetEntities() const;
+
+	/**
+	 * @return The number of cells that currently hold at least one entity
+	 */
+	size_t GetOccupiedCellCount() const { return m_OccupiedCells.size(); }
 
 private:
-	void HandleEntity(dpEntity* entity, dpEntity* other);
-	void HandleCell(int x, int z, float deltaTime);
+	/**
+	 * Gets the cell a position falls in, positions outside of the grid are put in the closest edge cell
+	 */
+	int GetCellIndex(float x, float z) const;
+
+	void AddToCell(dpEntity* entity, int cell);
+	void RemoveFromCell(dpEntity* entity);
+
+	/**
+	 * A collision found by a stripe, kept until it can be added to the colliding objects of entity
+	 */
+	struct CollisionChange {
+		dpEntity* entity;
+		const dpEntity* other;
+	};
+
+	/**
+	 * The shapes of the static entities of a cell, copied into batches so a dynamic entity
+	 * can be checked against all of them at once
+	 */
+	struct CellShapes {
+		dpCollisionChecks::SphereBatch spheres;
+		dpCollisionChecks::BoxBatch boxes;
+		std::vector<dpEntity*> sphereEntities;
+		std::vector<dpEntity*> boxEntities;
+
+		void Add(dpEntity* entity);
+		void Clear();
+	};
+
+	/**
+	 * The memory a thread needs to handle cells, kept between updates
+	 */
+	struct Stripe {
+		std::vector<CollisionChange> changes;
+		std::vector<uint8_t> results;
+	};
+
+	/**
+	 * Pre-updates the entities of a cell and copies the shapes of its static entities into its batches
+	 */
+	void PrepareCell(int cell);
+
+	/**
+	 * Checks a dynamic entity against a batch of static shapes.  Adds the collisions to the static
+	 * entities right away, or only to the changes of the stripe when changes is not null.
+	 */
+	void HandleShapes(dpEntity* entity, const CellShapes& shapes, std::vector<uint8_t>& results, std::vector<CollisionChange>* changes);
+	void HandleResults(dpEntity* entity, const std::vector<dpEntity*>& others, const std::vector<uint8_t>& results, std::vector<CollisionChange>* changes);
+	void HandleCell(int cell, float deltaTime, Stripe& stripe, bool applyChanges);
+
+	/**
+	 * Splits the occupied cells into stripes and tests each stripe on the worker pool.  Tests only read
+	 * entities, the collisions they find are added afterwards in the order of the stripes, which gives the
+	 * same new objects in the same order as a single threaded update.
+	 */
+	void UpdateParallel(float deltaTime);
+
+	/**
+	 * Finishes the update of every static entity, which works out the objects that left them
+	 */
+	void PostUpdate();
 
 private:
-	//cells on X, cells on Y for that X, then another vector that contains the entities within that cell.
-	std::vector<std::vector<std::forward_list<dpEntity*>>> m_Cells;
-	std::map<LWOOBJID, dpEntity*> m_GargantuanObjects;
+	/**
+	 * Below this many entities an update is cheaper than handing it to other threads
+	 */
+	static constexpr size_t MIN_PARALLEL_ENTITIES = 512;
+
+	/**
+	 * Stripes per thread, more stripes than threads keeps threads busy when some stripes are crowded
+	 */
+	static constexpr size_t STRIPES_PER_THREAD = 4;
+
+	// The entities of each cell, indexed by x * NUM_CELLS + z.  Entities know their cell and slot in it,
+	// so they can be removed by swapping the last entity of the cell into their slot.
+	std::vector<std::vector<dpEntity*>> m_Cells;
+
+	// The cells that hold any entities, in no particular order, and the position of each cell in it or -1
+	std::vector<int> m_OccupiedCells;
+	std::vector<int> m_OccupiedSlots;
+
+	std::vector<dpEntity*> m_GargantuanObjects;
 	bool m_DeleteGrid = true;
+
+	// The static shapes of each cell and of the gargantuan objects, copied at the start of every update.
+	// Cells that become empty are cleared, so neighbouring cells never see shapes of entities that left.
+	std::vector<CellShapes> m_CellShapes;
+	CellShapes m_GargantuanShapes;
+
+	size_t m_EntityCount = 0;
+
+	// Only created when checking collisions on more than one thread
+	std::unique_ptr<WorkerPool> m_Workers;
+
+	// The first stripe is also used by single threaded updates
+	std::vector<Stripe> m_Stripes;
 };
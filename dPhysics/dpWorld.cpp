@@ -3,6 +3,7 @@
 #include "dpGrid.h"
 #include "DetourCommon.h"
 
+#include <algorithm>
 #include <string>
 
 #include "Game.h"
@@ -18,7 +19,9 @@ void dpWorld::Initialize(unsigned int zoneID, bool generateNewNavMesh) {
 	//SP will NOT be used unless it is added to ShouldUseSP();
 	if (std::atoi(Game::config->GetValue("phys_spatial_partitioning").c_str()) == 1
 		&& ShouldUseSP(zoneID)) {
-		m_Grid = new dpGrid(phys_sp_tilecount, phys_sp_tilesize);
+		const auto workerThreads = std::atoi(Game::config->GetValue("phys_worker_threads").c_str());
+
+		m_Grid = new dpGrid(phys_sp_tilecount, phys_sp_tilesize, std::max(workerThreads, 0));
 	}
 
 	if (generateNewNavMesh) m_NavMesh = new dNavMesh(zoneID);
@@ -30,17 +33,13 @@ void dpWorld::Initialize(unsigned int zoneID, bool generateNewNavMesh) {
 void dpWorld::Reload() {
 	if (m_Grid) {
 		m_Grid->SetDeleteGrid(false);
-		auto oldGridCells = m_Grid->GetCells();
+		auto oldEntities = m_Grid->GetEntities();
 		delete m_Grid;
 		m_Grid = nullptr;
 
 		Initialize(m_ZoneID, false);
-		for (auto column : oldGridCells) {
-			for (auto row : column) {
-				for (auto entity : row) {
-					AddEntity(entity);
-				}
-			}
+		for (auto entity : oldEntities) {
+			AddEntity(entity);
 		}
 		Game::logger->Log("dpWorld", "Successfully reloaded physics world!");
 	} else {
@@ -63,6 +62,9 @@ dpWorld::~dpWorld() {
 }
 
 void dpWorld::StepWorld(float deltaTime) {
+	//Everything may have moved since the last frame:
+	if (m_NavMesh) m_NavMesh->Update(deltaTime);
+
 	if (m_Grid) {
 		m_Grid->Update(deltaTime);
 		return;
@@ -86,6 +88,12 @@ void dpWorld::StepWorld(float deltaTime) {
 			other->CheckCollision(entity); //swap "other" and "entity" if you want dyn objs to handle collisions.
 		}
 	}
+
+	//Post update, whatever was not found colliding has left:
+	for (auto entity : m_StaticEntities) {
+		if (!entity || entity->GetSleeping()) continue;
+		entity->PostUpdate();
+	}
 }
 
 void dpWorld::AddEntity(dpEntity* entity) {
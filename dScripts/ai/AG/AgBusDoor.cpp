@@ -23,13 +23,13 @@ void AgBusDoor::OnProximityUpdate(Entity* self, Entity* entering, std::string na
 	m_Counter = 0;
 	m_OuterCounter = 0;
 
-	for (const auto& pair : proximityMonitorComponent->GetProximityObjects("busDoor")) {
-		auto* entity = EntityManager::Instance()->GetEntity(pair.first);
+	for (const auto& object : proximityMonitorComponent->GetProximityObjects("busDoor")) {
+		auto* entity = EntityManager::Instance()->GetEntity(object.id);
 		if (entity != nullptr && entity->IsPlayer()) m_Counter++;
 	}
 
-	for (const auto& pair : proximityMonitorComponent->GetProximityObjects("busDoorOuter")) {
-		auto* entity = EntityManager::Instance()->GetEntity(pair.first);
+	for (const auto& object : proximityMonitorComponent->GetProximityObjects("busDoorOuter")) {
+		auto* entity = EntityManager::Instance()->GetEntity(object.id);
 		if (entity != nullptr && entity->IsPlayer()) m_OuterCounter++;
 	}
 
@@ -53,6 +53,7 @@
 #include "Mail.h"
 #include "TeamManager.h"
 #include "SkillComponent.h"
+#include "Behavior.h"
 #include "DestroyableComponent.h"
 #include "Game.h"
 #include "MasterPackets.h"
@@ -252,6 +253,10 @@ int main(int argc, char** argv) {
 		dZoneManager::Instance()->Initialize(LWOZONEID(zoneID, instanceID, cloneID));
 		g_CloneID = cloneID;
 
+		if (Game::config->GetValue("precompile_behaviors") != "0") {
+			Behavior::Precompile(Game::config->GetValue("precompile_zone_skills_only") != "0");
+		}
+
 		// pre calculate the FDB checksum
 		if (Game::config->GetValue("check_fdb") == "1") {
 			std::ifstream fileStream;
@@ -14,6 +14,7 @@
 #include "CDFeatureGatingTable.h"
 #include "CDClientManager.h"
 #include "AssetManager.h"
+#include "ZoneCache.h"
 
 Level::Level(Zone* parentZone, const std::string& filepath) {
 	m_ParentZone = parentZone;
@@ -31,11 +32,63 @@ Level::Level(Zone* parentZone, const std::string& filepath) {
 	buffer.close();
 }
 
+Level::Level(Zone* parentZone) {
+	m_ParentZone = parentZone;
+}
+
 Level::~Level() {
 	for (std::map<uint32_t, Header>::iterator it = m_ChunkHeaders.begin(); it != m_ChunkHeaders.end(); ++it) {
 		if (it->second.id == Level::ChunkTypeID::FileInfo) delete it->second.fileInfo;
 		if (it->second.id == Level::ChunkTypeID::SceneObjectData) delete it->second.sceneObjects;
 	}
+
+	for (auto& obj : m_SceneObjects) {
+		for (auto* setting : obj.settings) delete setting;
+	}
+}
+
+void Level::WriteToCache(ZoneCache::Writer& writer) const {
+	writer.Write<uint32_t>(m_ChunkHeaders.size());
+	for (const auto& [id, header] : m_ChunkHeaders) {
+		writer.Write(header.id);
+		writer.Write(header.chunkVersion);
+		writer.Write(header.chunkType);
+		writer.Write(header.size);
+		writer.Write(header.startPosition);
+
+		if (header.id == ChunkTypeID::FileInfo) writer.Write(*header.fileInfo);
+	}
+
+	writer.Write<uint32_t>(m_SceneObjects.size());
+	for (const auto& obj : m_SceneObjects) {
+		writer.WriteSceneObject(obj);
+	}
+}
+
+void Level::ReadFromCache(ZoneCache::Reader& reader) {
+	const auto headerCount = reader.Read<uint32_t>();
+	for (uint32_t i = 0; i < headerCount; ++i) {
+		Header header{};
+		header.id = reader.Read<uint32_t>();
+		header.chunkVersion = reader.Read<uint16_t>();
+		header.chunkType = reader.Read<ChunkTypeID>();
+		header.size = reader.Read<uint32_t>();
+		header.startPosition = reader.Read<uint32_t>();
+
+		if (header.id == ChunkTypeID::FileInfo) {
+			header.fileInfo = new FileInfoChunk(reader.Read<FileInfoChunk>());
+		} else if (header.id == ChunkTypeID::SceneObjectData) {
+			header.sceneObjects = new SceneObjectDataChunk;
+		}
+
+		m_ChunkHeaders.insert(std::make_pair(header.id, header));
+	}
+
+	const auto objectCount = reader.Read<uint32_t>();
+	m_SceneObjects.reserve(objectCount);
+	for (uint32_t i = 0; i < objectCount; ++i) {
+		m_SceneObjects.push_back(reader.ReadSceneObject());
+	}
 }
 
 const void Level::PrintAllObjects() {
@@ -162,7 +215,7 @@ void Level::ReadSceneObjectDataChunk(std::istream& file, Header& header) {
 	uint32_t objectsCount = 0;
 	BinaryIO::BinaryRead(file, objectsCount);
 
-	CDFeatureGatingTable* featureGatingTable = CDClientManager::Instance()->GetTable<CDFeatureGatingTable>("FeatureGating");
+	m_SceneObjects.reserve(m_SceneObjects.size() + objectsCount);
 
 	for (uint32_t i = 0; i < objectsCount; ++i) {
 		SceneObject obj;
@@ -176,13 +229,6 @@ void Level::ReadSceneObjectDataChunk(std::istream& file, Header& header) {
 		BinaryIO::BinaryRead(file, obj.rotation);
 		BinaryIO::BinaryRead(file, obj.scale);
 
-		//This is a little bit of a bodge, but because the alpha client (HF) doesn't store the
-		//spawn position / rotation like the later versions do, we need to check the LOT for the spawn pos & set it.
-		if (obj.lot == LOT_MARKER_PLAYER_START) {
-			dZoneManager::Instance()->GetZone()->SetSpawnPos(obj.position);
-			dZoneManager::Instance()->GetZone()->SetSpawnRot(obj.rotation);
-		}
-
 		std::u16string ldfString = u"";
 		uint32_t length = 0;
 		BinaryIO::BinaryRead(file, length);
@@ -205,6 +251,23 @@ void Level::ReadSceneObjectDataChunk(std::istream& file, Header& header) {
 
 		BinaryIO::BinaryRead(file, obj.value3);
 
+		m_SceneObjects.push_back(obj);
+	}
+
+	header.sceneObjects = chunk;
+}
+
+void Level::SpawnSceneObjects() {
+	CDFeatureGatingTable* featureGatingTable = CDClientManager::Instance()->GetTable<CDFeatureGatingTable>("FeatureGating");
+
+	for (auto& obj : m_SceneObjects) {
+		//This is a little bit of a bodge, but because the alpha client (HF) doesn't store the
+		//spawn position / rotation like the later versions do, we need to check the LOT for the spawn pos & set it.
+		if (obj.lot == LOT_MARKER_PLAYER_START) {
+			m_ParentZone->SetSpawnPos(obj.position);
+			m_ParentZone->SetSpawnRot(obj.rotation);
+		}
+
 		// Feature gating
 		bool gated = false;
 		for (LDFBaseData* data : obj.settings) {
@@ -347,5 +410,5 @@ void Level::ReadSceneObjectDataChunk(std::istream& file, Header& header) {
 		}
 	}
 
-	header.sceneObjects = chunk;
+	m_SceneObjects.clear();
 }
@@ -4,6 +4,11 @@
 #include <iostream>
 #include "Zone.h"
 
+namespace ZoneCache {
+	class Writer;
+	class Reader;
+};
+
 class Level {
 public:
 	enum ChunkTypeID : uint16_t {
@@ -58,14 +63,30 @@ public:
 
 public:
 	Level(Zone* parentZone, const std::string& filepath);
+
+	/**
+	 * Creates an empty level to be filled by ReadFromCache
+	 */
+	Level(Zone* parentZone);
 	~Level();
 
 	const void PrintAllObjects();
 
+	/**
+	 * Creates the entities and spawners for the objects in this level, taking ownership of their settings.
+	 */
+	void SpawnSceneObjects();
+
+	void WriteToCache(ZoneCache::Writer& writer) const;
+	void ReadFromCache(ZoneCache::Reader& reader);
+
 	std::map<uint32_t, Header> m_ChunkHeaders;
 private:
 	Zone* m_ParentZone;
 
+	// Objects read from the level that have not been spawned yet
+	std::vector<SceneObject> m_SceneObjects;
+
 	//private functions:
 	void ReadChunks(std::istream& file);
 	void ReadFileInfoChunk(std::istream& file, Header& header);
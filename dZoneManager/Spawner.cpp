@@ -4,6 +4,7 @@
 #include "Game.h"
 #include <sstream>
 #include <functional>
+#include <algorithm>
 #include "GeneralUtils.h"
 #include "dZoneManager.h"
 
@@ -41,10 +42,15 @@ Spawner::Spawner(const SpawnerInfo info) {
 		timerCount = m_Info.nodes.size();
 	}
 
+	// The first entities are due right away
+	const auto now = dZoneManager::Instance()->GetTime();
+
 	for (int i = 0; i < timerCount; ++i) {
-		m_WaitTimes.push_back(m_Info.respawnTime);
+		m_RespawnTimes.push_back(now);
 	}
 
+	ScheduleUpdate(now);
+
 	if (m_Info.spawnOnSmashGroupName != "") {
 		std::vector<Entity*> spawnSmashEntities = EntityManager::Instance()->GetEntitiesInGroup(m_Info.spawnOnSmashGroupName);
 		std::vector<Spawner*> spawnSmashSpawners = dZoneManager::Instance()->GetSpawnersInGroup(m_Info.spawnOnSmashGroupName);
@@ -76,6 +82,47 @@ Spawner::~Spawner() {
 }
 
 Entity* Spawner::Spawn() {
+	return Spawn(GetFreeNodes());
+}
+
+Entity* Spawner::Spawn(std::vector<SpawnerNode*> freeNodes, const bool force) {
+	Entity* rezdE = CreateSpawnedEntity(freeNodes, force);
+
+	if (rezdE == nullptr) return nullptr;
+
+	EntityManager::Instance()->ConstructEntity(rezdE);
+
+	for (const auto& cb : m_EntitySpawnedCallbacks) {
+		cb(rezdE);
+	}
+
+	return rezdE;
+}
+
+std::vector<Entity*> Spawner::SpawnBatch(const int32_t count) {
+	std::vector<Entity*> spawned;
+
+	for (int32_t i = 0; i < count; ++i) {
+		Entity* rezdE = CreateSpawnedEntity(GetFreeNodes(), false);
+
+		// Full, the rest would not fit either
+		if (rezdE == nullptr) break;
+
+		spawned.push_back(rezdE);
+	}
+
+	EntityManager::Instance()->ConstructEntities(spawned);
+
+	for (auto* rezdE : spawned) {
+		for (const auto& cb : m_EntitySpawnedCallbacks) {
+			cb(rezdE);
+		}
+	}
+
+	return spawned;
+}
+
+std::vector<SpawnerNode*> Spawner::GetFreeNodes() const {
 	std::vector<SpawnerNode*> freeNodes;
 	for (SpawnerNode* node : m_Info.nodes) {
 		if (node->entities.size() < node->nodeMax) {
@@ -83,10 +130,10 @@ Entity* Spawner::Spawn() {
 		}
 	}
 
-	return Spawn(freeNodes);
+	return freeNodes;
 }
 
-Entity* Spawner::Spawn(std::vector<SpawnerNode*> freeNodes, const bool force) {
+Entity* Spawner::CreateSpawnedEntity(const std::vector<SpawnerNode*>& freeNodes, const bool force) {
 	if (force || ((m_Entities.size() < m_Info.amountMaintained) && (freeNodes.size() > 0) && (m_AmountSpawned < m_Info.maxToSpawn || m_Info.maxToSpawn == -1))) {
 		SpawnerNode* spawnNode = freeNodes[GeneralUtils::GenerateRandomNumber<int>(0, freeNodes.size() - 1)];
 		++m_AmountSpawned;
@@ -106,18 +153,12 @@ Entity* Spawner::Spawn(std::vector<SpawnerNode*> freeNodes, const bool force) {
 
 		rezdE->GetGroups() = m_Info.groups;
 
-		EntityManager::Instance()->ConstructEntity(rezdE);
-
 		m_Entities.insert({ rezdE->GetObjectID(), spawnNode });
 		spawnNode->entities.push_back(rezdE->GetObjectID());
 		if (m_Entities.size() == m_Info.amountMaintained) {
 			m_NeedsUpdate = false;
 		}
 
-		for (const auto& cb : m_EntitySpawnedCallbacks) {
-			cb(rezdE);
-		}
-
 		return rezdE;
 	}
 
@@ -134,6 +175,7 @@ void Spawner::AddEntitySpawnedCallback(std::function<void(Entity*)> callback) {
 
 void Spawner::Reset() {
 	m_Start = true;
+	ScheduleUpdate(dZoneManager::Instance()->GetTime());
 
 	for (auto* node : m_Info.nodes) {
 		for (const auto& spawned : node->entities) {
@@ -156,37 +198,46 @@ void Spawner::SoftReset() {
 	m_Start = true;
 	m_AmountSpawned = 0;
 	m_NeedsUpdate = true;
+
+	ScheduleUpdate(dZoneManager::Instance()->GetTime());
 }
 
 void Spawner::SetRespawnTime(float time) {
 	m_Info.respawnTime = time;
 
-	for (size_t i = 0; i < m_WaitTimes.size(); ++i) {
-		m_WaitTimes[i] = 0;
-	};
+	const auto now = dZoneManager::Instance()->GetTime();
+
+	for (auto& respawnTime : m_RespawnTimes) {
+		respawnTime = now + time;
+	}
 
 	m_Start = true;
 	m_NeedsUpdate = true;
+
+	ScheduleUpdate(now);
 }
 
 void Spawner::SetNumToMaintain(int32_t value) {
 	m_Info.amountMaintained = value;
 }
 
-void Spawner::Update(const float deltaTime) {
+void Spawner::Update(const double time) {
+	// Replaced by an earlier update, which scheduled the next one itself
+	if (!m_UpdateScheduled || time != m_NextUpdate) return;
+
+	m_UpdateScheduled = false;
+
 	if (m_Start && m_Active) {
 		m_Start = false;
 
-		const auto toSpawn = m_Info.amountMaintained - m_AmountSpawned;
-		for (auto i = 0; i < toSpawn; ++i) {
-			Spawn();
-		}
+		SpawnBatch(m_Info.amountMaintained - m_AmountSpawned);
 
-		m_WaitTimes.clear();
+		m_RespawnTimes.clear();
 
 		return;
 	}
 
+	// Activate and NotifyOfEntityDeath schedule the respawns again
 	if (!m_NeedsUpdate) return;
 	if (!m_Active) return;
 	//if (m_Info.noTimedSpawn) return;
@@ -196,14 +247,33 @@ void Spawner::Update(const float deltaTime) {
 		}
 		return;
 	}
-	for (size_t i = 0; i < m_WaitTimes.size(); ++i) {
-		m_WaitTimes[i] += deltaTime;
-		if (m_WaitTimes[i] >= m_Info.respawnTime) {
-			m_WaitTimes.erase(m_WaitTimes.begin() + i);
 
-			Spawn();
-		}
-	}
+	// Spawning runs scripts which may change the spawner, so the due respawns are taken out first
+	const auto now = dZoneManager::Instance()->GetTime();
+	const auto pending = m_RespawnTimes.size();
+
+	m_RespawnTimes.erase(std::remove_if(m_RespawnTimes.begin(), m_RespawnTimes.end(), [now](double respawnTime) {
+		return respawnTime <= now;
+		}), m_RespawnTimes.end());
+
+	SpawnBatch(static_cast<int32_t>(pending - m_RespawnTimes.size()));
+
+	ScheduleNextRespawn();
+}
+
+void Spawner::ScheduleUpdate(const double time) {
+	if (m_UpdateScheduled && m_NextUpdate <= time) return;
+
+	m_UpdateScheduled = true;
+	m_NextUpdate = time;
+
+	dZoneManager::Instance()->ScheduleSpawner(m_Info.spawnerID, time);
+}
+
+void Spawner::ScheduleNextRespawn() {
+	if (m_RespawnTimes.empty()) return;
+
+	ScheduleUpdate(*std::min_element(m_RespawnTimes.begin(), m_RespawnTimes.end()));
 }
 
 void Spawner::NotifyOfEntityDeath(const LWOOBJID& objectID) {
@@ -213,7 +283,8 @@ void Spawner::NotifyOfEntityDeath(const LWOOBJID& objectID) {
 
 	m_NeedsUpdate = true;
 	//m_RespawnTime = 10.0f;
-	m_WaitTimes.push_back(0.0f);
+	m_RespawnTimes.push_back(dZoneManager::Instance()->GetTime() + m_Info.respawnTime);
+	ScheduleNextRespawn();
 	SpawnerNode* node;
 
 	auto it = m_Entities.find(objectID);
@@ -240,9 +311,15 @@ void Spawner::Activate() {
 	m_Active = true;
 	m_NeedsUpdate = true;
 
-	for (auto& time : m_WaitTimes) {
-		time = 0;
+	const auto now = dZoneManager::Instance()->GetTime();
+
+	for (auto& time : m_RespawnTimes) {
+		time = now + m_Info.respawnTime;
 	}
+
+	if (m_Start) ScheduleUpdate(now);
+
+	ScheduleNextRespawn();
 }
 
 void Spawner::SetSpawnLot(LOT lot) {
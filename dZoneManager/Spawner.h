@@ -50,7 +50,19 @@ public:
 
 	Entity* Spawn();
 	Entity* Spawn(std::vector<SpawnerNode*> freeNodes, bool force = false);
-	void Update(float deltaTime);
+
+	/**
+	 * Spawns up to a number of entities and constructs them for the players together
+	 * @param count how many entities to spawn
+	 * @return the spawned entities, fewer than count when the spawner fills up
+	 */
+	std::vector<Entity*> SpawnBatch(int32_t count);
+
+	/**
+	 * Spawns what is due, called by dZoneManager at the time the spawner asked to be woken up at
+	 * @param time the zone time the wake up was scheduled for
+	 */
+	void Update(double time);
 	void NotifyOfEntityDeath(const LWOOBJID& objectID);
 	void Activate();
 	void Deactivate() { m_Active = false; };
@@ -73,8 +85,35 @@ private:
 	std::vector<std::function<void(Entity*)>> m_EntitySpawnedCallbacks = {};
 
 
+	std::vector<SpawnerNode*> GetFreeNodes() const;
+
+	/**
+	 * Creates an entity on one of the free nodes, without constructing it or calling the spawn callbacks
+	 */
+	Entity* CreateSpawnedEntity(const std::vector<SpawnerNode*>& freeNodes, bool force);
+
+	/**
+	 * Asks dZoneManager to call Update at a zone time, unless it already will at or before it
+	 */
+	void ScheduleUpdate(double time);
+
+	/**
+	 * Schedules an update for the earliest pending respawn
+	 */
+	void ScheduleNextRespawn();
+
 	bool m_SpawnSmashFoundGroup = false;
-	std::vector<float> m_WaitTimes = {};
+
+	/**
+	 * The zone times pending respawns are due at, they wait while the spawner is full or inactive
+	 */
+	std::vector<double> m_RespawnTimes = {};
+
+	/**
+	 * The zone time of the update scheduled with dZoneManager, if m_UpdateScheduled
+	 */
+	double m_NextUpdate = 0.0;
+	bool m_UpdateScheduled = false;
 	bool m_NeedsUpdate = true;
 	std::map<LWOOBJID, SpawnerNode*> m_Entities = {};
 	EntityInfo m_EntityInfo;
@@ -1,5 +1,7 @@
 #include "Zone.h"
 #include "Level.h"
+#include <chrono>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include "Game.h"
@@ -13,6 +15,9 @@
 #include "CDZoneTableTable.h"
 #include "Spawner.h"
 #include "dZoneManager.h"
+#include "MappedFile.h"
+#include "Metrics.hpp"
+#include "ZoneCache.h"
 
 #include "eTriggerCommandType.h"
 #include "eTriggerEventType.h"
@@ -35,11 +40,244 @@ Zone::~Zone() {
 }
 
 void Zone::Initalize() {
-	LoadZoneIntoMemory();
-	LoadLevelsIntoMemory();
+	const auto start = std::chrono::steady_clock::now();
+	const auto cachePath = ZoneCache::GetPath(m_ZoneID.GetMapID());
+
+	const auto loadedFromCache = LoadFromCache(cachePath);
+	if (!loadedFromCache) {
+		LoadZoneIntoMemory();
+		LoadLevelsIntoMemory();
+		WriteCache(cachePath);
+	}
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+	Game::logger->Log("Zone", "Loaded zone %i from %s in %lli ms", m_ZoneID.GetMapID(), loadedFromCache ? "zone cache" : "client files", static_cast<long long>(elapsed));
+
+	CreatePathSpawners();
+	for (auto& [sceneID, scene] : m_Scenes) {
+		if (scene.level != nullptr) scene.level->SpawnSceneObjects();
+	}
+
 	m_CheckSum = CalculateChecksum();
 }
 
+bool Zone::LoadFromCache(const std::filesystem::path& cachePath) {
+	m_ZoneFilePath = GetFilePathForZoneID();
+	m_ZonePath = m_ZoneFilePath.substr(0, m_ZoneFilePath.rfind('/') + 1);
+	if (m_ZoneFilePath == "ERR") return false;
+
+	MappedFile cacheFile;
+	if (!cacheFile.Open(cachePath)) return false;
+
+	ZoneCache::Reader reader(cacheFile.GetData(), cacheFile.GetSize());
+
+	try {
+		const auto magic = reader.Read<uint32_t>();
+		if (std::memcmp(&magic, ZoneCache::MAGIC, sizeof(magic)) != 0 || reader.Read<uint32_t>() != ZoneCache::VERSION) return false;
+
+		const auto sourceCount = reader.Read<uint32_t>();
+		for (uint32_t i = 0; i < sourceCount; ++i) {
+			const auto source = reader.ReadString();
+			const auto stamp = reader.Read<uint32_t>();
+
+			uint32_t currentStamp = 0;
+			if (!Game::assetManager->GetFileStamp(source.c_str(), &currentStamp) || currentStamp != stamp) {
+				Game::logger->Log("Zone", "Zone cache is out of date (%s changed), rebuilding it", source.c_str());
+				return false;
+			}
+		}
+
+		m_ZoneFileFormatVersion = reader.Read<ZoneFileFormatVersion>();
+		m_WorldID = reader.Read<uint32_t>();
+		m_Spawnpoint = reader.Read<NiPoint3>();
+		m_SpawnpointRotation = reader.Read<NiQuaternion>();
+
+		const auto revisionCount = reader.Read<uint32_t>();
+		for (uint32_t i = 0; i < revisionCount; ++i) {
+			const auto sceneID = reader.Read<LWOSCENEID>();
+			m_MapRevisions[sceneID] = reader.Read<uint32_t>();
+		}
+
+		m_SceneCount = reader.Read<uint32_t>();
+		for (uint32_t i = 0; i < m_SceneCount; ++i) {
+			const auto lwoSceneID = reader.Read<LWOSCENEID>();
+
+			SceneRef scene;
+			scene.level = nullptr;
+			scene.filename = reader.ReadString();
+			scene.id = reader.Read<uint32_t>();
+			scene.sceneType = reader.Read<uint32_t>();
+			scene.name = reader.ReadString();
+
+			auto& inserted = m_Scenes.insert(std::make_pair(lwoSceneID, scene)).first->second;
+			m_NumberOfScenesLoaded++;
+
+			if (reader.Read<bool>()) {
+				inserted.level = new Level(this);
+				inserted.level->ReadFromCache(reader);
+
+				if (inserted.level->m_ChunkHeaders.size() > 0) inserted.level->m_ChunkHeaders.begin()->second.lwoSceneID = lwoSceneID;
+			}
+
+			LoadSceneTriggers(inserted);
+		}
+
+		m_ZoneRawPath = reader.ReadString();
+		m_ZoneName = reader.ReadString();
+		m_ZoneDesc = reader.ReadString();
+
+		m_NumberOfSceneTransitionsLoaded = reader.Read<uint32_t>();
+		for (uint32_t i = 0; i < m_NumberOfSceneTransitionsLoaded; ++i) {
+			SceneTransition sceneTrans;
+			sceneTrans.name = reader.ReadString();
+
+			const auto pointCount = reader.Read<uint32_t>();
+			for (uint32_t j = 0; j < pointCount; ++j) {
+				SceneTransitionInfo info;
+				info.sceneID = reader.Read<uint64_t>();
+				info.position = reader.Read<NiPoint3>();
+				sceneTrans.points.push_back(info);
+			}
+
+			m_SceneTransitions.push_back(sceneTrans);
+		}
+
+		m_PathDataLength = reader.Read<uint32_t>();
+		m_PathChunkVersion = reader.Read<uint32_t>();
+
+		const auto pathCount = reader.Read<uint32_t>();
+		m_Paths.reserve(pathCount);
+		for (uint32_t i = 0; i < pathCount; ++i) {
+			m_Paths.push_back(reader.ReadPath());
+			m_PathIndices.emplace(m_Paths.back().pathName, m_Paths.size() - 1);
+		}
+	} catch (const std::runtime_error& e) {
+		Game::logger->Log("Zone", "Failed to read zone cache %s: %s", cachePath.string().c_str(), e.what());
+		ClearLoadedData();
+		return false;
+	}
+
+	return true;
+}
+
+void Zone::WriteCache(const std::filesystem::path& cachePath) {
+	if (m_ZoneFilePath == "ERR") return;
+
+	// Every file the zone was read from is stamped so the cache is rebuilt when any of them changes
+	std::vector<std::pair<std::string, uint32_t>> sources;
+	sources.push_back({ m_ZoneFilePath, 0 });
+	for (const auto& [sceneID, scene] : m_Scenes) {
+		if (scene.level != nullptr) sources.push_back({ m_ZonePath + scene.filename, 0 });
+	}
+
+	for (auto& [source, stamp] : sources) {
+		if (!Game::assetManager->GetFileStamp(source.c_str(), &stamp)) {
+			Game::logger->Log("Zone", "Not writing zone cache, %s is missing", source.c_str());
+			return;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories(cachePath.parent_path(), error);
+
+	// Several world servers may load the same zone at once, so each writes to its own temporary file
+	auto tempPath = cachePath;
+	tempPath += "." + std::to_string(Metrics::GetProcessID()) + ".tmp";
+
+	try {
+		std::ofstream file(tempPath, std::ios::binary);
+		if (!file.is_open()) throw std::runtime_error("could not open " + tempPath.string());
+
+		ZoneCache::Writer writer(file);
+		file.write(ZoneCache::MAGIC, sizeof(ZoneCache::MAGIC));
+		writer.Write<uint32_t>(ZoneCache::VERSION);
+
+		writer.Write<uint32_t>(sources.size());
+		for (const auto& [source, stamp] : sources) {
+			writer.WriteString(source);
+			writer.Write(stamp);
+		}
+
+		writer.Write(m_ZoneFileFormatVersion);
+		writer.Write(m_WorldID);
+		writer.Write(m_Spawnpoint);
+		writer.Write(m_SpawnpointRotation);
+
+		writer.Write<uint32_t>(m_MapRevisions.size());
+		for (const auto& [sceneID, revision] : m_MapRevisions) {
+			writer.Write(sceneID);
+			writer.Write(revision);
+		}
+
+		writer.Write<uint32_t>(m_Scenes.size());
+		for (const auto& [sceneID, scene] : m_Scenes) {
+			writer.Write(sceneID);
+			writer.WriteString(scene.filename);
+			writer.Write(scene.id);
+			writer.Write(scene.sceneType);
+			writer.WriteString(scene.name);
+
+			writer.Write(scene.level != nullptr);
+			if (scene.level != nullptr) scene.level->WriteToCache(writer);
+		}
+
+		writer.WriteString(m_ZoneRawPath);
+		writer.WriteString(m_ZoneName);
+		writer.WriteString(m_ZoneDesc);
+
+		writer.Write<uint32_t>(m_SceneTransitions.size());
+		for (const auto& sceneTrans : m_SceneTransitions) {
+			writer.WriteString(sceneTrans.name);
+			writer.Write<uint32_t>(sceneTrans.points.size());
+			for (const auto& info : sceneTrans.points) {
+				writer.Write(info.sceneID);
+				writer.Write(info.position);
+			}
+		}
+
+		writer.Write(m_PathDataLength);
+		writer.Write(m_PathChunkVersion);
+		writer.Write<uint32_t>(m_Paths.size());
+		for (const auto& path : m_Paths) {
+			writer.WritePath(path);
+		}
+
+		file.close();
+		if (file.fail()) throw std::runtime_error("could not write " + tempPath.string());
+	} catch (const std::runtime_error& e) {
+		Game::logger->Log("Zone", "Failed to write zone cache: %s", e.what());
+		std::filesystem::remove(tempPath, error);
+		return;
+	}
+
+	std::filesystem::rename(tempPath, cachePath, error);
+	if (error) {
+		Game::logger->Log("Zone", "Failed to write zone cache %s: %s", cachePath.string().c_str(), error.message().c_str());
+		std::filesystem::remove(tempPath, error);
+	}
+}
+
+void Zone::ClearLoadedData() {
+	for (auto& [sceneID, scene] : m_Scenes) {
+		delete scene.level;
+		for (auto& [triggerID, trigger] : scene.triggers) delete trigger;
+	}
+
+	for (auto& path : m_Paths) {
+		for (auto& waypoint : path.pathWaypoints) {
+			for (auto* data : waypoint.config) delete data;
+		}
+	}
+
+	m_Scenes.clear();
+	m_SceneTransitions.clear();
+	m_Paths.clear();
+	m_PathIndices.clear();
+	m_MapRevisions.clear();
+	m_NumberOfScenesLoaded = 0;
+	m_NumberOfSceneTransitionsLoaded = 0;
+}
+
 void Zone::LoadZoneIntoMemory() {
 	m_ZoneFilePath = GetFilePathForZoneID();
 	m_ZonePath = m_ZoneFilePath.substr(0, m_ZoneFilePath.rfind('/') + 1);
@@ -108,51 +346,6 @@ void Zone::LoadZoneIntoMemory() {
 			BinaryIO::BinaryRead(file, pathCount);
 
 			for (uint32_t i = 0; i < pathCount; ++i) LoadPath(file);
-
-			for (Path path : m_Paths) {
-				if (path.pathType == PathType::Spawner) {
-					SpawnerInfo info = SpawnerInfo();
-					for (PathWaypoint waypoint : path.pathWaypoints) {
-						SpawnerNode* node = new SpawnerNode();
-						node->position = waypoint.position;
-						node->rotation = waypoint.rotation;
-						node->nodeID = 0;
-						node->config = waypoint.config;
-
-						for (LDFBaseData* data : waypoint.config) {
-							if (data) {
-								if (data->GetKey() == u"spawner_node_id") {
-									node->nodeID = std::stoi(data->GetValueAsString());
-								} else if (data->GetKey() == u"spawner_max_per_node") {
-									node->nodeMax = std::stoi(data->GetValueAsString());
-								} else if (data->GetKey() == u"groupID") { // Load object group
-									std::string groupStr = data->GetValueAsString();
-									info.groups = GeneralUtils::SplitString(groupStr, ';');
-									info.groups.erase(info.groups.end() - 1);
-								} else if (data->GetKey() == u"grpNameQBShowBricks") {
-									if (data->GetValueAsString() == "") continue;
-									/*std::string groupStr = data->GetValueAsString();
-									info.groups.push_back(groupStr);*/
-									info.grpNameQBShowBricks = data->GetValueAsString();
-								} else if (data->GetKey() == u"spawner_name") {
-									info.name = data->GetValueAsString();
-								}
-							}
-						}
-						info.nodes.push_back(node);
-					}
-					info.templateID = path.spawner.spawnedLOT;
-					info.spawnerID = path.spawner.spawnerObjID;
-					info.respawnTime = path.spawner.respawnTime;
-					info.amountMaintained = path.spawner.amountMaintained;
-					info.maxToSpawn = path.spawner.maxToSpawn;
-					info.activeOnLoad = path.spawner.spawnerNetActive;
-					info.isNetwork = true;
-					Spawner* spawner = new Spawner(info);
-					dZoneManager::Instance()->AddSpawner(info.spawnerID, spawner);
-				}
-
-			}
 		}
 	} else {
 		Game::logger->Log("Zone", "Failed to open: %s", m_ZoneFilePath.c_str());
@@ -162,6 +355,52 @@ void Zone::LoadZoneIntoMemory() {
 	buffer.close();
 }
 
+void Zone::CreatePathSpawners() {
+	for (Path path : m_Paths) {
+		if (path.pathType == PathType::Spawner) {
+			SpawnerInfo info = SpawnerInfo();
+			for (PathWaypoint waypoint : path.pathWaypoints) {
+				SpawnerNode* node = new SpawnerNode();
+				node->position = waypoint.position;
+				node->rotation = waypoint.rotation;
+				node->nodeID = 0;
+				node->config = waypoint.config;
+
+				for (LDFBaseData* data : waypoint.config) {
+					if (data) {
+						if (data->GetKey() == u"spawner_node_id") {
+							node->nodeID = std::stoi(data->GetValueAsString());
+						} else if (data->GetKey() == u"spawner_max_per_node") {
+							node->nodeMax = std::stoi(data->GetValueAsString());
+						} else if (data->GetKey() == u"groupID") { // Load object group
+							std::string groupStr = data->GetValueAsString();
+							info.groups = GeneralUtils::SplitString(groupStr, ';');
+							info.groups.erase(info.groups.end() - 1);
+						} else if (data->GetKey() == u"grpNameQBShowBricks") {
+							if (data->GetValueAsString() == "") continue;
+							/*std::string groupStr = data->GetValueAsString();
+							info.groups.push_back(groupStr);*/
+							info.grpNameQBShowBricks = data->GetValueAsString();
+						} else if (data->GetKey() == u"spawner_name") {
+							info.name = data->GetValueAsString();
+						}
+					}
+				}
+				info.nodes.push_back(node);
+			}
+			info.templateID = path.spawner.spawnedLOT;
+			info.spawnerID = path.spawner.spawnerObjID;
+			info.respawnTime = path.spawner.respawnTime;
+			info.amountMaintained = path.spawner.amountMaintained;
+			info.maxToSpawn = path.spawner.maxToSpawn;
+			info.activeOnLoad = path.spawner.spawnerNetActive;
+			info.isNetwork = true;
+			Spawner* spawner = new Spawner(info);
+			dZoneManager::Instance()->AddSpawner(info.spawnerID, spawner);
+		}
+	}
+}
+
 std::string Zone::GetFilePathForZoneID() {
 	//We're gonna go ahead and presume we've got the db loaded already:
 	CDZoneTableTable* zoneTable = CDClientManager::Instance()->GetTable<CDZoneTableTable>("ZoneTable");
@@ -236,13 +475,7 @@ void Zone::LoadScene(std::istream& file) {
 	BinaryIO::BinaryRead(file, sceneFilenameLength);
 	scene.filename = BinaryIO::ReadString(file, sceneFilenameLength);
 
-	std::string luTriggersPath = scene.filename.substr(0, scene.filename.size() - 4) + ".lutriggers";
-	std::vector<LUTriggers::Trigger*> triggers;
-	if(Game::assetManager->HasFile((m_ZonePath + luTriggersPath).c_str())) triggers = LoadLUTriggers(luTriggersPath, scene.id);
-
-	for (LUTriggers::Trigger* trigger : triggers) {
-		scene.triggers.insert({ trigger->id, trigger });
-	}
+	LoadSceneTriggers(scene);
 
 	BinaryIO::BinaryRead(file, scene.id);
 	BinaryIO::BinaryRead(file, scene.sceneType);
@@ -259,6 +492,16 @@ void Zone::LoadScene(std::istream& file) {
 	m_NumberOfScenesLoaded++;
 }
 
+void Zone::LoadSceneTriggers(SceneRef& scene) {
+	std::string luTriggersPath = scene.filename.substr(0, scene.filename.size() - 4) + ".lutriggers";
+	std::vector<LUTriggers::Trigger*> triggers;
+	if(Game::assetManager->HasFile((m_ZonePath + luTriggersPath).c_str())) triggers = LoadLUTriggers(luTriggersPath, scene.id);
+
+	for (LUTriggers::Trigger* trigger : triggers) {
+		scene.triggers.insert({ trigger->id, trigger });
+	}
+}
+
 std::vector<LUTriggers::Trigger*> Zone::LoadLUTriggers(std::string triggerFile, LWOSCENEID sceneID) {
 	std::vector<LUTriggers::Trigger*> lvlTriggers;
 
@@ -333,14 +576,14 @@ LUTriggers::Trigger* Zone::GetTrigger(uint32_t sceneID, uint32_t triggerID) {
 	return m_Scenes[sceneID].triggers[triggerID];
 }
 
-const Path* Zone::GetPath(std::string name) const {
-	for (const auto& path : m_Paths) {
-		if (name == path.pathName) {
-			return &path;
-		}
+const Path* Zone::GetPath(const std::string& name) const {
+	const auto& index = m_PathIndices.find(name);
+
+	if (index == m_PathIndices.end()) {
+		return nullptr;
 	}
 
-	return nullptr;
+	return &m_Paths[index->second];
 }
 
 void Zone::LoadSceneTransition(std::istream& file) {
@@ -549,5 +792,6 @@ void Zone::LoadPath(std::istream& file) {
 
 
 
+	m_PathIndices.emplace(path.pathName, m_Paths.size());
 	m_Paths.push_back(path);
 }
@@ -6,6 +6,8 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <filesystem>
 
 namespace LUTriggers {
 	struct Trigger;
@@ -201,7 +203,7 @@ public:
 	const uint32_t GetChecksum() const { return m_CheckSum; }
 	const void PrintAllGameObjects();
 	LUTriggers::Trigger* GetTrigger(uint32_t sceneID, uint32_t triggerID);
-	const Path* GetPath(std::string name) const;
+	const Path* GetPath(const std::string& name) const;
 
 	uint32_t GetWorldID() const { return m_WorldID; }
 	[[nodiscard]] std::string GetZoneName() const { return m_ZoneName; }
@@ -239,10 +241,36 @@ private:
 	uint32_t m_PathChunkVersion;
 	std::vector<Path> m_Paths;
 
+	/**
+	 * The index in m_Paths of the first path with each name
+	 */
+	std::unordered_map<std::string, size_t> m_PathIndices;
+
 	std::map<LWOSCENEID, uint32_t, mapCompareLwoSceneIDs> m_MapRevisions; //rhs is the revision!
 
 	//private ("helper") functions:
+
+	/**
+	 * Loads the zone and its levels from the zone cache, if it is up to date with the client files
+	 *
+	 * @param cachePath The cache file to load
+	 * @return Whether or not the zone was loaded
+	 */
+	bool LoadFromCache(const std::filesystem::path& cachePath);
+
+	/**
+	 * Writes the parsed zone and its levels to the zone cache.  Must be called before any objects are spawned.
+	 */
+	void WriteCache(const std::filesystem::path& cachePath);
+
+	/**
+	 * Frees everything read by a partial load, so the zone can be loaded again
+	 */
+	void ClearLoadedData();
+
+	void CreatePathSpawners();
 	void LoadScene(std::istream& file);
+	void LoadSceneTriggers(SceneRef& scene);
 	std::vector<LUTriggers::Trigger*> LoadLUTriggers(std::string triggerFile, LWOSCENEID sceneID);
 	void LoadSceneTransition(std::istream& file);
 	SceneTransitionInfo LoadSceneTransitionInfo(std::istream& file);
@@ -0,0 +1,286 @@
+#include "ZoneCache.h"
+
+#include <memory>
+
+#include "BinaryPathFinder.h"
+#include "Zone.h"
+
+std::filesystem::path ZoneCache::GetPath(LWOMAPID mapID) {
+	return BinaryPathFinder::GetBinaryDir() / "resServer" / "zones" / (std::to_string(mapID) + ".zonecache");
+}
+
+void ZoneCache::Writer::WriteString(const std::string& value) {
+	Write<uint32_t>(value.size());
+	m_Stream.write(value.data(), value.size());
+}
+
+void ZoneCache::Writer::WriteString(const std::u16string& value) {
+	Write<uint32_t>(value.size());
+	m_Stream.write(reinterpret_cast<const char*>(value.data()), value.size() * sizeof(char16_t));
+}
+
+void ZoneCache::Writer::WriteLDF(const std::vector<LDFBaseData*>& config) {
+	Write<uint32_t>(config.size());
+
+	for (auto* data : config) {
+		if (data == nullptr) {
+			Write<int32_t>(LDF_TYPE_UNKNOWN);
+			continue;
+		}
+
+		const auto type = data->GetValueType();
+		Write<int32_t>(type);
+		WriteString(data->GetKey());
+
+		switch (type) {
+		case LDF_TYPE_UTF_16:
+			WriteString(static_cast<LDFData<std::u16string>*>(data)->GetValue());
+			break;
+		case LDF_TYPE_S32:
+			Write(static_cast<LDFData<int32_t>*>(data)->GetValue());
+			break;
+		case LDF_TYPE_FLOAT:
+			Write(static_cast<LDFData<float>*>(data)->GetValue());
+			break;
+		case LDF_TYPE_DOUBLE:
+			Write(static_cast<LDFData<double>*>(data)->GetValue());
+			break;
+		case LDF_TYPE_U32:
+			Write(static_cast<LDFData<uint32_t>*>(data)->GetValue());
+			break;
+		case LDF_TYPE_BOOLEAN:
+			Write(static_cast<LDFData<bool>*>(data)->GetValue());
+			break;
+		case LDF_TYPE_U64:
+			Write(static_cast<LDFData<uint64_t>*>(data)->GetValue());
+			break;
+		case LDF_TYPE_OBJID:
+			Write(static_cast<LDFData<LWOOBJID>*>(data)->GetValue());
+			break;
+		case LDF_TYPE_UTF_8:
+			WriteString(static_cast<LDFData<std::string>*>(data)->GetValue());
+			break;
+		default:
+			throw std::runtime_error("Cannot write LDF of unknown type to the zone cache.");
+		}
+	}
+}
+
+std::vector<LDFBaseData*> ZoneCache::Reader::ReadLDF() {
+	const auto count = Read<uint32_t>();
+
+	std::vector<std::unique_ptr<LDFBaseData>> config;
+	config.reserve(count);
+
+	for (uint32_t i = 0; i < count; ++i) {
+		const auto type = Read<int32_t>();
+		if (type == LDF_TYPE_UNKNOWN) {
+			config.emplace_back(nullptr);
+			continue;
+		}
+
+		const auto key = ReadU16String();
+
+		switch (type) {
+		case LDF_TYPE_UTF_16:
+			config.emplace_back(new LDFData<std::u16string>(key, ReadU16String()));
+			break;
+		case LDF_TYPE_S32:
+			config.emplace_back(new LDFData<int32_t>(key, Read<int32_t>()));
+			break;
+		case LDF_TYPE_FLOAT:
+			config.emplace_back(new LDFData<float>(key, Read<float>()));
+			break;
+		case LDF_TYPE_DOUBLE:
+			config.emplace_back(new LDFData<double>(key, Read<double>()));
+			break;
+		case LDF_TYPE_U32:
+			config.emplace_back(new LDFData<uint32_t>(key, Read<uint32_t>()));
+			break;
+		case LDF_TYPE_BOOLEAN:
+			config.emplace_back(new LDFData<bool>(key, Read<bool>()));
+			break;
+		case LDF_TYPE_U64:
+			config.emplace_back(new LDFData<uint64_t>(key, Read<uint64_t>()));
+			break;
+		case LDF_TYPE_OBJID:
+			config.emplace_back(new LDFData<LWOOBJID>(key, Read<LWOOBJID>()));
+			break;
+		case LDF_TYPE_UTF_8:
+			config.emplace_back(new LDFData<std::string>(key, ReadString()));
+			break;
+		default:
+			throw std::runtime_error("Unknown LDF type in zone cache.");
+		}
+	}
+
+	std::vector<LDFBaseData*> result;
+	result.reserve(config.size());
+	for (auto& data : config) result.push_back(data.release());
+
+	return result;
+}
+
+std::string ZoneCache::Reader::ReadString() {
+	const auto length = Read<uint32_t>();
+	Require(length);
+
+	std::string value(m_Data + m_Offset, length);
+	m_Offset += length;
+
+	return value;
+}
+
+std::u16string ZoneCache::Reader::ReadU16String() {
+	const auto length = Read<uint32_t>();
+	Require(static_cast<size_t>(length) * sizeof(char16_t));
+
+	std::u16string value(length, u'\0');
+	std::memcpy(value.data(), m_Data + m_Offset, length * sizeof(char16_t));
+	m_Offset += length * sizeof(char16_t);
+
+	return value;
+}
+
+void ZoneCache::Writer::WritePath(const Path& path) {
+	Write(path.pathVersion);
+	Write(path.pathType);
+	WriteString(path.pathName);
+	Write(path.flags);
+	Write(path.pathBehavior);
+	Write(path.waypointCount);
+
+	Write(path.spawner.spawnedLOT);
+	Write(path.spawner.respawnTime);
+	Write(path.spawner.maxToSpawn);
+	Write(path.spawner.amountMaintained);
+	Write(path.spawner.spawnerObjID);
+	Write(path.spawner.spawnerNetActive);
+
+	WriteString(path.movingPlatform.platformTravelSound);
+	Write(path.movingPlatform.timeBasedMovement);
+
+	Write(path.property.pathType);
+	Write(path.property.price);
+	Write(path.property.rentalTimeUnit);
+	Write(path.property.associatedZone);
+	WriteString(path.property.displayName);
+	WriteString(path.property.displayDesc);
+	Write(path.property.type);
+	Write(path.property.cloneLimit);
+	Write(path.property.repMultiplier);
+	Write(path.property.achievementRequired);
+	Write(path.property.playerZoneCoords);
+	Write(path.property.maxBuildHeight);
+
+	WriteString(path.camera.nextPath);
+	Write(path.camera.rotatePlayer);
+
+	Write<uint32_t>(path.pathWaypoints.size());
+	for (const auto& waypoint : path.pathWaypoints) {
+		Write(waypoint.position);
+		Write(waypoint.rotation);
+
+		Write(waypoint.movingPlatform.lockPlayer);
+		Write(waypoint.movingPlatform.speed);
+		Write(waypoint.movingPlatform.wait);
+		WriteString(waypoint.movingPlatform.departSound);
+		WriteString(waypoint.movingPlatform.arriveSound);
+
+		Write(waypoint.camera);
+		Write(waypoint.racing);
+		Write(waypoint.rail);
+
+		WriteLDF(waypoint.config);
+	}
+}
+
+Path ZoneCache::Reader::ReadPath() {
+	Path path = Path();
+
+	path.pathVersion = Read<uint32_t>();
+	path.pathType = Read<PathType>();
+	path.pathName = ReadString();
+	path.flags = Read<uint32_t>();
+	path.pathBehavior = Read<PathBehavior>();
+	path.waypointCount = Read<uint32_t>();
+
+	path.spawner.spawnedLOT = Read<LOT>();
+	path.spawner.respawnTime = Read<uint32_t>();
+	path.spawner.maxToSpawn = Read<int32_t>();
+	path.spawner.amountMaintained = Read<uint32_t>();
+	path.spawner.spawnerObjID = Read<LWOOBJID>();
+	path.spawner.spawnerNetActive = Read<uint8_t>();
+
+	path.movingPlatform.platformTravelSound = ReadString();
+	path.movingPlatform.timeBasedMovement = Read<uint8_t>();
+
+	path.property.pathType = Read<PropertyPathType>();
+	path.property.price = Read<int32_t>();
+	path.property.rentalTimeUnit = Read<PropertyRentalTimeUnit>();
+	path.property.associatedZone = Read<uint64_t>();
+	path.property.displayName = ReadString();
+	path.property.displayDesc = ReadString();
+	path.property.type = Read<PropertyType>();
+	path.property.cloneLimit = Read<int32_t>();
+	path.property.repMultiplier = Read<float>();
+	path.property.achievementRequired = Read<PropertyAchievmentRequired>();
+	path.property.playerZoneCoords = Read<NiPoint3>();
+	path.property.maxBuildHeight = Read<float>();
+
+	path.camera.nextPath = ReadString();
+	path.camera.rotatePlayer = Read<uint8_t>();
+
+	const auto waypointCount = Read<uint32_t>();
+	path.pathWaypoints.reserve(waypointCount);
+	for (uint32_t i = 0; i < waypointCount; ++i) {
+		PathWaypoint waypoint = PathWaypoint();
+
+		waypoint.position = Read<NiPoint3>();
+		waypoint.rotation = Read<NiQuaternion>();
+
+		waypoint.movingPlatform.lockPlayer = Read<uint8_t>();
+		waypoint.movingPlatform.speed = Read<float>();
+		waypoint.movingPlatform.wait = Read<float>();
+		waypoint.movingPlatform.departSound = ReadString();
+		waypoint.movingPlatform.arriveSound = ReadString();
+
+		waypoint.camera = Read<CameraPathWaypoint>();
+		waypoint.racing = Read<RacingPathWaypoint>();
+		waypoint.rail = Read<RailPathWaypoint>();
+
+		waypoint.config = ReadLDF();
+
+		path.pathWaypoints.push_back(waypoint);
+	}
+
+	return path;
+}
+
+void ZoneCache::Writer::WriteSceneObject(const SceneObject& object) {
+	Write(object.id);
+	Write(object.lot);
+	Write(object.value1);
+	Write(object.value2);
+	Write(object.position);
+	Write(object.rotation);
+	Write(object.scale);
+	Write(object.value3);
+	WriteLDF(object.settings);
+}
+
+SceneObject ZoneCache::Reader::ReadSceneObject() {
+	SceneObject object;
+
+	object.id = Read<LWOOBJID>();
+	object.lot = Read<LOT>();
+	object.value1 = Read<uint32_t>();
+	object.value2 = Read<uint32_t>();
+	object.position = Read<NiPoint3>();
+	object.rotation = Read<NiQuaternion>();
+	object.scale = Read<float>();
+	object.value3 = Read<uint32_t>();
+	object.settings = ReadLDF();
+
+	return object;
+}
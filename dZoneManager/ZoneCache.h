@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BinaryIO.h"
+#include "dZMCommon.h"
+
+struct Path;
+
+/**
+ * A compiled copy of a zone (.luz) and its levels (.lvl), so a world server can skip parsing them.
+ * The cache stores the parsed scenes, paths and scene objects with their LDF already decoded, and is
+ * loaded with a single mapping.  It is written the first time a zone is loaded and rebuilt whenever
+ * the stamp of any file it was compiled from changes, which in practice is once per client version.
+ *
+ * File layout (little endian):
+ *   char[4] magic "ZNCC", uint32 version, uint32 source count, then for each source:
+ *   string asset path, uint32 stamp (see AssetManager::GetFileStamp)
+ *   followed by the zone as written by Zone::WriteCache.
+ */
+namespace ZoneCache {
+	constexpr char MAGIC[4] = { 'Z', 'N', 'C', 'C' };
+
+	/**
+	 * Bump this whenever the layout or what Zone and Level store in it changes
+	 */
+	constexpr uint32_t VERSION = 1;
+
+	/**
+	 * Gets the path of the cache file for a zone
+	 */
+	std::filesystem::path GetPath(LWOMAPID mapID);
+
+	class Writer {
+	public:
+		Writer(std::ostream& stream) : m_Stream(stream) {}
+
+		template<typename T>
+		void Write(const T& value) { BinaryIO::BinaryWrite(m_Stream, value); }
+
+		void WriteString(const std::string& value);
+		void WriteString(const std::u16string& value);
+
+		/**
+		 * Writes LDF with its values in binary, null entries are preserved
+		 */
+		void WriteLDF(const std::vector<LDFBaseData*>& config);
+		void WritePath(const Path& path);
+		void WriteSceneObject(const SceneObject& object);
+
+	private:
+		std::ostream& m_Stream;
+	};
+
+	/**
+	 * Reads from a mapped cache file.  Reading past the end throws a std::runtime_error.
+	 */
+	class Reader {
+	public:
+		Reader(const char* data, size_t size) : m_Data(data), m_Size(size) {}
+
+		template<typename T>
+		T Read() {
+			T value;
+			Require(sizeof(T));
+			std::memcpy(reinterpret_cast<char*>(&value), m_Data + m_Offset, sizeof(T));
+			m_Offset += sizeof(T);
+			return value;
+		}
+
+		std::string ReadString();
+		std::u16string ReadU16String();
+
+		/**
+		 * Reads LDF written by Writer::WriteLDF, the caller owns the returned data
+		 */
+		std::vector<LDFBaseData*> ReadLDF();
+		Path ReadPath();
+		SceneObject ReadSceneObject();
+
+	private:
+		void Require(size_t size) const {
+			if (m_Offset + size > m_Size) throw std::runtime_error("Unexpected end of zone cache.");
+		}
+
+		const char* m_Data;
+		size_t m_Size;
+		size_t m_Offset = 0;
+	};
+};
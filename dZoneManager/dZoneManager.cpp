@@ -9,12 +9,48 @@
 #include "GameMessages.h"
 #include "VanityUtilities.h"
 #include "WorldConfig.h"
+#include "AssetManager.h"
 #include <chrono>
+#include <algorithm>
 
 #include "../dWorldServer/ObjectIDManager.h"
 
 dZoneManager* dZoneManager::m_Address = nullptr;
 
+namespace {
+	using IndexedSpawners = std::vector<std::pair<LWOOBJID, Spawner*>>;
+
+	void InsertSpawner(IndexedSpawners& spawners, const LWOOBJID id, Spawner* spawner) {
+		const auto position = std::upper_bound(spawners.begin(), spawners.end(), id, [](LWOOBJID value, const auto& entry) {
+			return value < entry.first;
+			});
+
+		spawners.insert(position, { id, spawner });
+	}
+
+	void EraseSpawner(IndexedSpawners& spawners, const LWOOBJID id) {
+		spawners.erase(std::remove_if(spawners.begin(), spawners.end(), [id](const auto& entry) {
+			return entry.first == id;
+			}), spawners.end());
+	}
+
+	std::vector<Spawner*> GetIndexedSpawners(const std::unordered_map<std::string, IndexedSpawners>& index, const std::string& key) {
+		std::vector<Spawner*> spawners;
+
+		const auto& found = index.find(key);
+
+		if (found == index.end()) return spawners;
+
+		spawners.reserve(found->second.size());
+
+		for (const auto& entry : found->second) {
+			spawners.push_back(entry.second);
+		}
+
+		return spawners;
+	}
+}
+
 void dZoneManager::Initialize(const LWOZONEID& zoneID) {
 	Game::logger->Log("dZoneManager", "Preparing zone: %i/%i/%i", zoneID.GetMapID(), zoneID.GetInstanceID(), zoneID.GetCloneID());
 
@@ -57,6 +93,8 @@ void dZoneManager::Initialize(const LWOZONEID& zoneID) {
 	LoadWorldConfig();
 
 	Game::logger->Log("dZoneManager", "Zone prepared in: %llu ms", (endTime - startTime));
+	Game::logger->Log("dZoneManager", "Asset lookups so far: %llu taking %f ms", static_cast<unsigned long long>(Game::assetManager->GetLookupCount()), Game::assetManager->GetLookupTimeMs());
+	Game::logger->Log("dZoneManager", "Asset cache: %llu hits, %llu misses, %llu bytes", static_cast<unsigned long long>(Game::assetManager->GetCacheHits()), static_cast<unsigned long long>(Game::assetManager->GetCacheMisses()), static_cast<unsigned long long>(Game::assetManager->GetCacheSize()));
 
 	VanityUtilities::SpawnVanity();
 }
@@ -114,7 +152,44 @@ void dZoneManager::NotifyZone(const dZoneNotifier& notifier, const LWOOBJID& obj
 }
 
 void dZoneManager::AddSpawner(LWOOBJID id, Spawner* spawner) {
+	const auto& existing = m_Spawners.find(id);
+
+	if (existing != m_Spawners.end()) {
+		UnindexSpawner(id, existing->second);
+	}
+
 	m_Spawners.insert_or_assign(id, spawner);
+
+	IndexSpawner(id, spawner);
+}
+
+void dZoneManager::IndexSpawner(const LWOOBJID id, Spawner* spawner) {
+	InsertSpawner(m_SpawnersByName[spawner->m_Info.name], id, spawner);
+
+	// A spawner listed in a group twice is returned twice, like it always has been
+	for (const auto& group : spawner->m_Info.groups) {
+		InsertSpawner(m_SpawnersByGroup[group], id, spawner);
+	}
+}
+
+void dZoneManager::UnindexSpawner(const LWOOBJID id, Spawner* spawner) {
+	const auto& byName = m_SpawnersByName.find(spawner->m_Info.name);
+
+	if (byName != m_SpawnersByName.end()) {
+		EraseSpawner(byName->second, id);
+
+		if (byName->second.empty()) m_SpawnersByName.erase(byName);
+	}
+
+	for (const auto& group : spawner->m_Info.groups) {
+		const auto& byGroup = m_SpawnersByGroup.find(group);
+
+		if (byGroup == m_SpawnersByGroup.end()) continue;
+
+		EraseSpawner(byGroup->second, id);
+
+		if (byGroup->second.empty()) m_SpawnersByGroup.erase(byGroup);
+	}
 }
 
 LWOZONEID dZoneManager::GetZoneID() const {
@@ -122,11 +197,31 @@ LWOZONEID dZoneManager::GetZoneID() const {
 }
 
 void dZoneManager::Update(float deltaTime) {
-	for (auto spawner : m_Spawners) {
-		spawner.second->Update(deltaTime);
+	m_Time += deltaTime;
+
+	// Spawners scheduled while these update wait for the next frame
+	std::vector<ScheduledSpawner> due;
+
+	while (!m_SpawnerSchedule.empty() && m_SpawnerSchedule.top().time <= m_Time) {
+		due.push_back(m_SpawnerSchedule.top());
+
+		m_SpawnerSchedule.pop();
+	}
+
+	for (const auto& scheduled : due) {
+		// Removed since it was scheduled
+		auto* spawner = GetSpawner(scheduled.id);
+
+		if (spawner == nullptr) continue;
+
+		spawner->Update(scheduled.time);
 	}
 }
 
+void dZoneManager::ScheduleSpawner(const LWOOBJID id, const double time) {
+	m_SpawnerSchedule.push({ time, id });
+}
+
 LWOOBJID dZoneManager::MakeSpawner(SpawnerInfo info) {
 	auto objectId = info.spawnerID;
 
@@ -197,34 +292,20 @@ void dZoneManager::RemoveSpawner(const LWOOBJID id) {
 
 	Game::logger->Log("dZoneManager", "Destroying spawner (%llu)", id);
 
+	UnindexSpawner(id, spawner);
+
 	m_Spawners.erase(id);
 
 	delete spawner;
 }
 
 
-std::vector<Spawner*> dZoneManager::GetSpawnersByName(std::string spawnerName) {
-	std::vector<Spawner*> spawners;
-	for (const auto& spawner : m_Spawners) {
-		if (spawner.second->GetName() == spawnerName) {
-			spawners.push_back(spawner.second);
-		}
-	}
-
-	return spawners;
+std::vector<Spawner*> dZoneManager::GetSpawnersByName(const std::string& spawnerName) {
+	return GetIndexedSpawners(m_SpawnersByName, spawnerName);
 }
 
-std::vector<Spawner*> dZoneManager::GetSpawnersInGroup(std::string group) {
-	std::vector<Spawner*> spawnersInGroup;
-	for (auto spawner : m_Spawners) {
-		for (std::string entityGroup : spawner.second->m_Info.groups) {
-			if (entityGroup == group) {
-				spawnersInGroup.push_back(spawner.second);
-			}
-		}
-	}
-
-	return spawnersInGroup;
+std::vector<Spawner*> dZoneManager::GetSpawnersInGroup(const std::string& group) {
+	return GetIndexedSpawners(m_SpawnersByGroup, group);
 }
 
 uint32_t dZoneManager::GetUniqueMissionIdStartingValue() {
@@ -3,6 +3,8 @@
 #include "Zone.h"
 #include "Spawner.h"
 #include <map>
+#include <queue>
+#include <unordered_map>
 
 class WorldConfig;
 
@@ -24,6 +26,14 @@ private:
 	 */
 	void LoadWorldConfig();
 
+	using SpawnerIndex = std::unordered_map<std::string, std::vector<std::pair<LWOOBJID, Spawner*>>>;
+
+	/**
+	 * Adds a spawner to the name and group indices, or takes it out of them
+	 */
+	void IndexSpawner(LWOOBJID id, Spawner* spawner);
+	void UnindexSpawner(LWOOBJID id, Spawner* spawner);
+
 public:
 	static dZoneManager* Instance() {
 		if (!m_Address) {
@@ -44,9 +54,22 @@ public:
 	LWOOBJID MakeSpawner(SpawnerInfo info);
 	Spawner* GetSpawner(LWOOBJID id);
 	void RemoveSpawner(LWOOBJID id);
-	std::vector<Spawner*> GetSpawnersByName(std::string spawnerName);
-	std::vector<Spawner*> GetSpawnersInGroup(std::string group);
+	std::vector<Spawner*> GetSpawnersByName(const std::string& spawnerName);
+	std::vector<Spawner*> GetSpawnersInGroup(const std::string& group);
+	const std::map<LWOOBJID, Spawner*>& GetSpawners() const { return m_Spawners; }
 	void Update(float deltaTime);
+
+	/**
+	 * Has a spawner updated once the zone time reaches a point, instead of every spawner updating every frame
+	 * @param id the id the spawner was added with
+	 * @param time the zone time to update the spawner at, see GetTime
+	 */
+	void ScheduleSpawner(LWOOBJID id, double time);
+
+	/**
+	 * @return the seconds the zone has been updated for
+	 */
+	double GetTime() const { return m_Time; }
 	Entity* GetZoneControlObject() { return m_ZoneControlObject; }
 	bool GetPlayerLoseCoinOnDeath() { return m_PlayerLoseCoinsOnDeath; }
 	uint32_t GetUniqueMissionIdStartingValue();
@@ -68,6 +91,26 @@ private:
 	LWOZONEID m_ZoneID;
 	bool m_PlayerLoseCoinsOnDeath; //Do players drop coins in this zone when smashed
 	std::map<LWOOBJID, Spawner*> m_Spawners;
+
+	/**
+	 * The spawners by name and by group, each list ordered by id like m_Spawners
+	 */
+	SpawnerIndex m_SpawnersByName;
+	SpawnerIndex m_SpawnersByGroup;
+
+	struct ScheduledSpawner {
+		double time;
+		LWOOBJID id;
+
+		bool operator>(const ScheduledSpawner& other) const { return time > other.time; }
+	};
+
+	/**
+	 * The spawners waiting to be updated, earliest first
+	 */
+	std::priority_queue<ScheduledSpawner, std::vector<ScheduledSpawner>, std::greater<ScheduledSpawner>> m_SpawnerSchedule;
+
+	double m_Time = 0.0;
 	WorldConfig* m_WorldConfig = nullptr;
 
 	Entity* m_ZoneControlObject = nullptr;
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Crc32.h"
+
+class Crc32Test : public ::testing::Test {
+protected:
+	void SetUp() override {
+		std::mt19937 random(1234);
+		data.resize(4096);
+		for (auto& byte : data) byte = static_cast<uint8_t>(random());
+	}
+
+	std::vector<uint8_t> data;
+};
+
+/**
+ * @brief Check that every implementation matches the bitwise reference for all lengths and alignments
+ *
+ */
+TEST_F(Crc32Test, ImplementationsMatchReference) {
+	const uint32_t bases[] = { 0xFFFFFFFF, 0x00000000, 0x12345678 };
+
+	for (const auto base : bases) {
+		for (size_t offset = 0; offset < 16; offset++) {
+			for (size_t length = 0; length < 300; length++) {
+				const auto expected = Crc32::CalculateBitwise(base, data.data() + offset, length);
+
+				ASSERT_EQ(Crc32::CalculateSlicing8(base, data.data() + offset, length), expected) << "length " << length << " offset " << offset;
+				ASSERT_EQ(Crc32::Calculate(base, data.data() + offset, length), expected) << "length " << length << " offset " << offset;
+
+				if (Crc32::HasHardwareSupport()) {
+					ASSERT_EQ(Crc32::CalculateHardware(base, data.data() + offset, length), expected) << "length " << length << " offset " << offset;
+				}
+			}
+		}
+
+		const auto expected = Crc32::CalculateBitwise(base, data.data(), data.size());
+		ASSERT_EQ(Crc32::Calculate(base, data.data(), data.size()), expected);
+	}
+}
+
+/**
+ * @brief Check the crc of a pack path, including the 4 null bytes the client appends
+ *
+ */
+TEST_F(Crc32Test, PackPathCrc) {
+	const std::string path = "client\\res\\maps\\01_live_maps\\avant_gardens\\nd_avant_gardens.luz";
+
+	auto crc = Crc32::CalculateBitwise(0xFFFFFFFF, reinterpret_cast<const uint8_t*>(path.c_str()), path.size());
+	crc = Crc32::CalculateBitwise(crc, reinterpret_cast<const uint8_t*>("\0\0\0\0"), 4);
+
+	auto fastCrc = Crc32::Calculate(0xFFFFFFFF, reinterpret_cast<const uint8_t*>(path.c_str()), path.size());
+	fastCrc = Crc32::Calculate(fastCrc, reinterpret_cast<const uint8_t*>("\0\0\0\0"), 4);
+
+	ASSERT_EQ(fastCrc, crc);
+}
+
+/**
+ * @brief Microbenchmark of each implementation over typical asset path lengths, run with --gtest_also_run_disabled_tests.
+ * The timings are recorded as test properties in the XML output.
+ *
+ */
+TEST_F(Crc32Test, DISABLED_Benchmark) {
+	const size_t lengths[] = { 64, 128, 4096 };
+
+	auto measure = [&](uint32_t(*implementation)(uint32_t, const uint8_t*, size_t), size_t length) {
+		const size_t iterations = (1 << 20) / length;
+		uint32_t crc = 0xFFFFFFFF;
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < iterations; i++) {
+			crc = implementation(crc, data.data(), length);
+		}
+		const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+		EXPECT_NE(crc, 0u); // Keeps the loop from being optimized away
+		return static_cast<int>(elapsed / iterations);
+	};
+
+	for (const auto length : lengths) {
+		const auto prefix = "ns_" + std::to_string(length) + "_bytes_";
+
+		RecordProperty(prefix + "bitwise", measure(&Crc32::CalculateBitwise, length));
+		RecordProperty(prefix + "slicing8", measure(&Crc32::CalculateSlicing8, length));
+
+		if (Crc32::HasHardwareSupport()) {
+			RecordProperty(prefix + "pclmul", measure(&Crc32::CalculateHardware, length));
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "MappedFile.h"
+
+/**
+ * @brief Check that writes to a copy on write mapping stay out of the file and only make the written pages private
+ *
+ */
+TEST(MappedFileTests, CopyOnWrite) {
+	const auto path = std::filesystem::temp_directory_path() / "MappedFileTests.bin";
+	const std::string contents(256 * 1024, 'a');
+
+	{
+		std::ofstream file(path, std::ios::binary);
+		file.write(contents.data(), contents.size());
+	}
+
+	{
+		MappedFile readOnly(path);
+		ASSERT_TRUE(readOnly.IsOpen());
+		ASSERT_EQ(readOnly.GetWritableData(), nullptr);
+
+		MappedFile copyOnWrite(path, true);
+		ASSERT_TRUE(copyOnWrite.IsOpen());
+		ASSERT_EQ(copyOnWrite.GetSize(), contents.size());
+		ASSERT_NE(copyOnWrite.GetWritableData(), nullptr);
+
+		copyOnWrite.GetWritableData()[0] = 'b';
+
+		ASSERT_EQ(copyOnWrite.GetData()[0], 'b');
+		ASSERT_EQ(readOnly.GetData()[0], 'a');
+
+		size_t privateBytes = 0;
+		if (copyOnWrite.GetPrivateBytes(privateBytes)) {
+			ASSERT_GT(privateBytes, 0);
+			ASSERT_LT(privateBytes, contents.size());
+		}
+	}
+
+	MappedFile reopened(path);
+	ASSERT_EQ(reopened.GetData()[0], 'a');
+	reopened.Close();
+
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "SmallVector.h"
+
+/**
+ * @brief Check that elements stay inline up to the inline capacity and keep their order once spilled
+ *
+ */
+TEST(SmallVectorTest, GrowsPastInlineStorage) {
+	SmallVector<int, 4> vector;
+
+	for (int i = 0; i < 4; i++) vector.push_back(i);
+	ASSERT_FALSE(vector.IsOnHeap());
+
+	for (int i = 4; i < 100; i++) vector.push_back(i);
+	ASSERT_TRUE(vector.IsOnHeap());
+	ASSERT_EQ(vector.size(), 100);
+
+	for (int i = 0; i < 100; i++) ASSERT_EQ(vector[i], i);
+}
+
+/**
+ * @brief Check that erasing keeps the order of the remaining elements and destroys the erased ones
+ *
+ */
+TEST(SmallVectorTest, EraseKeepsOrder) {
+	auto tracker = std::make_shared<int>(0);
+	SmallVector<std::shared_ptr<int>, 2> vector;
+
+	for (int i = 0; i < 6; i++) vector.push_back(tracker);
+	ASSERT_EQ(tracker.use_count(), 7);
+
+	vector.erase(vector.begin() + 1, vector.begin() + 3);
+	ASSERT_EQ(vector.size(), 4);
+	ASSERT_EQ(tracker.use_count(), 5);
+
+	SmallVector<int, 8> numbers;
+	for (int i = 0; i < 8; i++) numbers.push_back(i);
+
+	numbers.erase(std::remove_if(numbers.begin(), numbers.end(), [](int value) { return value % 2 == 0; }), numbers.end());
+	ASSERT_EQ(numbers.size(), 4);
+	for (size_t i = 0; i < numbers.size(); i++) ASSERT_EQ(numbers[i], i * 2 + 1);
+
+	vector.clear();
+	ASSERT_EQ(tracker.use_count(), 1);
+}
+
+/**
+ * @brief Check that inserting keeps a sorted vector sorted, also while it grows past its inline storage
+ *
+ */
+TEST(SmallVectorTest, InsertKeepsOrder) {
+	SmallVector<int, 2> numbers;
+	const int values[] = { 5, 1, 4, 2, 3, 0 };
+
+	for (const auto value : values) {
+		numbers.insert(std::lower_bound(numbers.begin(), numbers.end(), value), value);
+	}
+
+	ASSERT_EQ(numbers.size(), 6);
+	for (size_t i = 0; i < numbers.size(); i++) ASSERT_EQ(numbers[i], i);
+
+	numbers.insert(numbers.end(), numbers[0]);
+	ASSERT_EQ(numbers.back(), 0);
+}
+
+/**
+ * @brief Check copying and moving both inline and spilled vectors
+ *
+ */
+TEST(SmallVectorTest, CopyAndMove) {
+	SmallVector<std::string, 2> small;
+	small.push_back("a");
+
+	SmallVector<std::string, 2> large;
+	for (int i = 0; i < 5; i++) large.push_back(std::to_string(i));
+
+	auto smallCopy = small;
+	auto largeCopy = large;
+	ASSERT_EQ(smallCopy.size(), 1);
+	ASSERT_EQ(largeCopy.size(), 5);
+	ASSERT_EQ(largeCopy[4], "4");
+
+	auto smallMoved = std::move(small);
+	auto largeMoved = std::move(large);
+	ASSERT_TRUE(small.empty());
+	ASSERT_TRUE(large.empty());
+	ASSERT_FALSE(large.IsOnHeap());
+	ASSERT_EQ(smallMoved[0], "a");
+	ASSERT_EQ(largeMoved[3], "3");
+
+	// Pushing an element of the vector itself while it has to grow
+	SmallVector<std::string, 1> self;
+	self.push_back("self");
+	self.push_back(self[0]);
+	ASSERT_EQ(self[1], "self");
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "WorkerPool.h"
+
+/**
+ * @brief Check that every task of a run is run exactly once, over many runs
+ *
+ */
+TEST(WorkerPoolTests, RunsEveryTaskOnce) {
+	WorkerPool pool(4);
+	ASSERT_EQ(pool.GetThreadCount(), 4);
+
+	for (size_t run = 0; run < 200; run++) {
+		const auto taskCount = run % 17;
+		std::vector<std::atomic<uint32_t>> counts(taskCount);
+
+		pool.Run(taskCount, [&counts](size_t index) { counts[index]++; });
+
+		for (const auto& count : counts) {
+			ASSERT_EQ(count, 1);
+		}
+	}
+}
+
+/**
+ * @brief Check that a pool of one thread runs its tasks on the calling thread
+ *
+ */
+TEST(WorkerPoolTests, SingleThread) {
+	WorkerPool pool(1);
+	ASSERT_EQ(pool.GetThreadCount(), 1);
+
+	std::vector<size_t> order;
+	pool.Run(5, [&order](size_t index) { order.push_back(index); });
+
+	ASSERT_EQ(order, std::vector<size_t>({ 0, 1, 2, 3, 4 }));
+}
@@ -0,0 +1,98 @@
+#include "GameDependencies.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "DestroyableComponent.h"
+#include "Entity.h"
+#include "SpatialQueryManager.h"
+#include "eReplicaComponentType.h"
+
+class SpatialQueryManagerTest : public GameDependenciesTest {
+protected:
+	std::vector<Entity*> entities;
+
+	void SetUp() override {
+		SetUpDependencies();
+	}
+
+	void TearDown() override {
+		for (auto* entity : entities) {
+			SpatialQueryManager::Instance()->Remove(entity->GetObjectID());
+			delete entity;
+		}
+
+		TearDownDependencies();
+	}
+
+	Entity* AddEntity(const NiPoint3& position, int32_t faction = -1) {
+		auto* entity = new Entity(100 + entities.size(), GameDependenciesTest::info);
+
+		if (faction != -1) {
+			auto* destroyableComponent = new DestroyableComponent(entity);
+			destroyableComponent->AddFactionNoLookup(faction);
+			entity->AddComponent(eReplicaComponentType::DESTROYABLE, destroyableComponent);
+		}
+
+		SpatialQueryManager::Instance()->Add(entity, position);
+		entities.push_back(entity);
+
+		return entity;
+	}
+
+	std::vector<LWOOBJID> Query(const SpatialQuery& query, uint64_t factionFilter = SpatialQueryManager::ANY_FACTION) {
+		std::vector<LWOOBJID> results;
+		SpatialQueryManager::Instance()->Query(query, factionFilter, results);
+		std::sort(results.begin(), results.end());
+		return results;
+	}
+};
+
+/**
+ * Test that every shape only finds the entities within it, across cell borders
+ */
+TEST_F(SpatialQueryManagerTest, ShapesFindContainedEntities) {
+	auto* origin = AddEntity(NiPoint3(0, 0, 0));
+	auto* near = AddEntity(NiPoint3(-5, 0, 3));
+	auto* ahead = AddEntity(NiPoint3(0, 0, 40));
+	auto* far = AddEntity(NiPoint3(500, 0, -500));
+
+	ASSERT_EQ(Query(SpatialQuery::All()).size(), 4);
+	ASSERT_EQ(Query(SpatialQuery::Sphere(NiPoint3(0, 0, 0), 10)), std::vector<LWOOBJID>({ origin->GetObjectID(), near->GetObjectID() }));
+	ASSERT_EQ(Query(SpatialQuery::Sphere(NiPoint3(0, 0, 0), 1000)).size(), 4);
+
+	// Facing +z with a narrow arc only reaches the entity straight ahead
+	ASSERT_EQ(Query(SpatialQuery::Arc(NiPoint3(0, 0, 0), NiPoint3(0, 0, 1), 1, 50, 15)), std::vector<LWOOBJID>({ ahead->GetObjectID() }));
+
+	ASSERT_EQ(Query(SpatialQuery::Box(NiPoint3(400, -10, -600), NiPoint3(600, 10, -400))), std::vector<LWOOBJID>({ far->GetObjectID() }));
+}
+
+/**
+ * Test that moved and removed entities are found where they are now
+ */
+TEST_F(SpatialQueryManagerTest, MoveAndRemove) {
+	auto* mover = AddEntity(NiPoint3(0, 0, 0));
+	auto* other = AddEntity(NiPoint3(1, 0, 1));
+
+	SpatialQueryManager::Instance()->Move(mover->GetObjectID(), NiPoint3(300, 0, 300));
+	ASSERT_EQ(Query(SpatialQuery::Sphere(NiPoint3(0, 0, 0), 10)), std::vector<LWOOBJID>({ other->GetObjectID() }));
+	ASSERT_EQ(Query(SpatialQuery::Sphere(NiPoint3(300, 0, 300), 10)), std::vector<LWOOBJID>({ mover->GetObjectID() }));
+
+	SpatialQueryManager::Instance()->Remove(other->GetObjectID());
+	ASSERT_TRUE(Query(SpatialQuery::Sphere(NiPoint3(0, 0, 0), 10)).empty());
+	ASSERT_EQ(SpatialQueryManager::Instance()->GetCount(), 1);
+}
+
+/**
+ * Test that the faction filter rejects entities without a matching faction
+ */
+TEST_F(SpatialQueryManagerTest, FactionFilter) {
+	auto* enemy = AddEntity(NiPoint3(0, 0, 0), 4);
+	AddEntity(NiPoint3(1, 0, 0), 6);
+	AddEntity(NiPoint3(2, 0, 0));
+
+	const auto filter = SpatialQueryManager::GetFactionMask({ 4 });
+	ASSERT_EQ(Query(SpatialQuery::Sphere(NiPoint3(0, 0, 0), 10), filter), std::vector<LWOOBJID>({ enemy->GetObjectID() }));
+	ASSERT_TRUE(Query(SpatialQuery::Sphere(NiPoint3(0, 0, 0), 10), 0).empty());
+	ASSERT_EQ(Query(SpatialQuery::Sphere(NiPoint3(0, 0, 0), 10)).size(), 3);
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dpCollisionChecks.h"
+#include "dpEntity.h"
+#include "dpShapeBox.h"
+#include "dpShapeSphere.h"
+
+using namespace dpCollisionChecks;
+
+class dpCollisionChecksTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		std::mt19937 random(99);
+		std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+		std::uniform_real_distribution<float> size(0.5f, 15.0f);
+
+		// An odd count, so every level has elements left over for the scalar code
+		for (LWOOBJID id = 1; id <= 1003; id++) {
+			const NiPoint3 center(position(random), position(random), position(random));
+
+			if (id % 2 == 0) {
+				spheres.emplace_back(new dpEntity(id, size(random), true));
+				spheres.back()->SetPosition(center);
+				sphereBatch.Add(center, static_cast<dpShapeSphere*>(spheres.back()->GetShape())->GetRadius());
+			} else {
+				boxes.emplace_back(new dpEntity(id, size(random), size(random), size(random), true));
+				boxes.back()->SetPosition(center);
+				auto* box = static_cast<dpShapeBox*>(boxes.back()->GetShape());
+				boxBatch.Add(NiPoint3(box->m_MinX, box->m_MinY, box->m_MinZ), NiPoint3(box->m_MaxX, box->m_MaxY, box->m_MaxZ));
+			}
+		}
+	}
+
+	static NiPoint3 GetMin(dpEntity* entity) {
+		auto* box = static_cast<dpShapeBox*>(entity->GetShape());
+		return NiPoint3(box->m_MinX, box->m_MinY, box->m_MinZ);
+	}
+
+	static NiPoint3 GetMax(dpEntity* entity) {
+		auto* box = static_cast<dpShapeBox*>(entity->GetShape());
+		return NiPoint3(box->m_MaxX, box->m_MaxY, box->m_MaxZ);
+	}
+
+	static float GetRadius(dpEntity* entity) {
+		return static_cast<dpShapeSphere*>(entity->GetShape())->GetRadius();
+	}
+
+	std::vector<SimdLevel> GetLevels() const {
+		std::vector<SimdLevel> levels = { SimdLevel::Scalar };
+		if (GetSimdLevel() >= SimdLevel::SSE2) levels.push_back(SimdLevel::SSE2);
+		if (GetSimdLevel() >= SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+		return levels;
+	}
+
+	std::vector<std::unique_ptr<dpEntity>> spheres;
+	std::vector<std::unique_ptr<dpEntity>> boxes;
+	SphereBatch sphereBatch;
+	BoxBatch boxBatch;
+};
+
+/**
+ * @brief Check that every batched check agrees with the pair by pair checks on every supported instruction set
+ *
+ */
+TEST_F(dpCollisionChecksTest, BatchesMatchPairs) {
+	std::vector<uint8_t> results(std::max(spheres.size(), boxes.size()));
+	size_t hits = 0;
+
+	for (const auto level : GetLevels()) {
+		for (size_t i = 0; i < 20; i++) {
+			auto* sphere = spheres[i].get();
+			auto* box = boxes[i].get();
+
+			CheckSpheres(sphere->GetPosition(), GetRadius(sphere), sphereBatch, results.data(), level);
+			for (size_t j = 0; j < spheres.size(); j++) {
+				ASSERT_EQ(results[j] != 0, CheckSpheres(spheres[j].get(), sphere)) << j;
+				hits += results[j];
+			}
+
+			CheckSphereBoxes(sphere->GetPosition(), GetRadius(sphere), boxBatch, results.data(), level);
+			for (size_t j = 0; j < boxes.size(); j++) {
+				ASSERT_EQ(results[j] != 0, CheckSphereBox(boxes[j].get(), sphere)) << j;
+				hits += results[j];
+			}
+
+			CheckBoxSpheres(GetMin(box), GetMax(box), sphereBatch, results.data(), level);
+			for (size_t j = 0; j < spheres.size(); j++) {
+				ASSERT_EQ(results[j] != 0, CheckSphereBox(spheres[j].get(), box)) << j;
+				hits += results[j];
+			}
+
+			CheckBoxes(GetMin(box), GetMax(box), boxBatch, results.data(), level);
+			for (size_t j = 0; j < boxes.size(); j++) {
+				ASSERT_EQ(results[j] != 0, CheckBoxes(boxes[j].get(), box)) << j;
+				hits += results[j];
+			}
+		}
+	}
+
+	ASSERT_GT(hits, 0);
+}
+
+/**
+ * @brief Check that boxes overlapping without a corner inside each other collide, and that every pair of shapes is dispatched
+ *
+ */
+TEST_F(dpCollisionChecksTest, CompleteShapePairs) {
+	// A long thin box crossing through a wide flat one
+	dpEntity wide(1, 10.0f, 1.0f, 10.0f, true);
+	wide.SetPosition(NiPoint3(0, 5, 0));
+	dpEntity tall(2, 1.0f, 20.0f, 1.0f, true);
+	tall.SetPosition(NiPoint3(0, -5, 0));
+
+	ASSERT_TRUE(AreColliding(&wide, &tall));
+	ASSERT_TRUE(AreColliding(&tall, &wide));
+
+	dpEntity sphere(3, 2.0f, true);
+	sphere.SetPosition(NiPoint3(0, 7.5f, 0));
+
+	ASSERT_TRUE(AreColliding(&sphere, &wide));
+	ASSERT_TRUE(AreColliding(&wide, &sphere));
+
+	sphere.SetPosition(NiPoint3(20, 5, 0));
+	ASSERT_FALSE(AreColliding(&sphere, &wide));
+}
+
+/**
+ * @brief Benchmark of checking one shape against many with each instruction set, run with --gtest_also_run_disabled_tests.
+ * The timings are recorded as test properties in the XML output.
+ *
+ */
+TEST_F(dpCollisionChecksTest, DISABLED_Benchmark) {
+	const size_t repeats = 2000;
+	std::vector<uint8_t> results(std::max(spheres.size(), boxes.size()));
+	const char* names[] = { "scalar", "sse2", "avx2" };
+
+	for (const auto level : GetLevels()) {
+		size_t hits = 0;
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < repeats; i++) {
+			auto* sphere = spheres[i % spheres.size()].get();
+			auto* box = boxes[i % boxes.size()].get();
+
+			CheckSpheres(sphere->GetPosition(), GetRadius(sphere), sphereBatch, results.data(), level);
+			hits += results[i % spheres.size()];
+			CheckSphereBoxes(sphere->GetPosition(), GetRadius(sphere), boxBatch, results.data(), level);
+			hits += results[i % boxes.size()];
+			CheckBoxSpheres(GetMin(box), GetMax(box), sphereBatch, results.data(), level);
+			hits += results[i % spheres.size()];
+			CheckBoxes(GetMin(box), GetMax(box), boxBatch, results.data(), level);
+			hits += results[i % boxes.size()];
+		}
+		const auto time = std::chrono::high_resolution_clock::now() - start;
+
+		const auto checks = repeats * 2 * (spheres.size() + boxes.size());
+		RecordProperty(std::string("ns_per_1000_checks_") + names[static_cast<int>(level)], static_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() * 1000 / checks));
+		EXPECT_GT(hits, 0u); // Keeps the checks from being optimized away
+	}
+
+	// The pair by pair checks, as the grid used to call them
+	size_t hits = 0;
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < repeats; i++) {
+		auto* sphere = spheres[i % spheres.size()].get();
+		auto* box = boxes[i % boxes.size()].get();
+
+		for (auto& other : spheres) hits += other->GetShape()->IsColliding(sphere->GetShape());
+		for (auto& other : boxes) hits += other->GetShape()->IsColliding(sphere->GetShape());
+		for (auto& other : spheres) hits += other->GetShape()->IsColliding(box->GetShape());
+		for (auto& other : boxes) hits += other->GetShape()->IsColliding(box->GetShape());
+	}
+	const auto time = std::chrono::high_resolution_clock::now() - start;
+
+	const auto checks = repeats * 2 * (spheres.size() + boxes.size());
+	RecordProperty("ns_per_1000_checks_pairs", static_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() * 1000 / checks));
+	EXPECT_GT(hits, 0u);
+}
@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dpEntity.h"
+#include "dpGrid.h"
+
+class dpGridTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		grid = new dpGrid(12, 205);
+	}
+
+	void TearDown() override {
+		delete grid;
+	}
+
+	dpEntity* AddEntity(LWOOBJID id, const NiPoint3& position, float radius, bool isStatic) {
+		return AddEntity(grid, id, position, radius, isStatic);
+	}
+
+	static dpEntity* AddEntity(dpGrid* target, LWOOBJID id, const NiPoint3& position, float radius, bool isStatic) {
+		auto* entity = new dpEntity(id, radius, isStatic);
+		entity->SetPosition(position);
+		entity->SetGrid(target);
+		return entity;
+	}
+
+
+	static bool IsColliding(dpEntity* phantom, dpEntity* other) {
+		return phantom->IsCollidingWith(other);
+	}
+
+	dpGrid* grid;
+};
+
+/**
+ * @brief Check that phantoms see entities entering and leaving them as they move between cells
+ *
+ */
+TEST_F(dpGridTest, EnterAndLeave) {
+	auto* phantom = AddEntity(1, NiPoint3(10, 0, 10), 5, true);
+	auto* player = AddEntity(2, NiPoint3(12, 0, 12), 1, false);
+
+	grid->Update(0.1f);
+	ASSERT_TRUE(IsColliding(phantom, player));
+	ASSERT_EQ(phantom->GetNewObjects().size(), 1);
+
+	player->SetPosition(NiPoint3(40, 0, 40));
+	grid->Update(0.1f);
+	ASSERT_FALSE(IsColliding(phantom, player));
+	ASSERT_EQ(phantom->GetRemovedObjects().size(), 1);
+
+	player->SetPosition(NiPoint3(800, 0, 800));
+	grid->Update(0.1f);
+	ASSERT_EQ(grid->GetOccupiedCellCount(), 2);
+
+	player->SetPosition(NiPoint3(9, 0, 9));
+	grid->Update(0.1f);
+	ASSERT_TRUE(IsColliding(phantom, player));
+	ASSERT_EQ(grid->GetOccupiedCellCount(), 1);
+
+	// Staying inside is not a new enter
+	grid->Update(0.1f);
+	ASSERT_TRUE(phantom->GetNewObjects().empty());
+	ASSERT_TRUE(phantom->GetRemovedObjects().empty());
+}
+
+/**
+ * @brief Check that objects leave when they are no longer found colliding, even if they were never checked against the phantom again
+ *
+ */
+TEST_F(dpGridTest, LeaveWithoutCheck) {
+	auto* phantom = AddEntity(1, NiPoint3(10, 0, 10), 5, true);
+	auto* teleported = AddEntity(2, NiPoint3(12, 0, 12), 1, false);
+	auto* deleted = AddEntity(3, NiPoint3(8, 0, 8), 1, false);
+	auto* staying = AddEntity(4, NiPoint3(10, 0, 10), 1, false);
+
+	grid->Update(0.1f);
+	ASSERT_EQ(phantom->GetNewObjects(), std::vector<LWOOBJID>({ 2, 3, 4 }));
+	ASSERT_EQ(phantom->GetCurrentlyCollidingObjects().size(), 3);
+
+	// Far enough away that the cells of the phantom and the player are not neighbours
+	teleported->SetPosition(NiPoint3(1000, 0, 1000));
+	grid->Delete(deleted);
+	grid->Update(0.1f);
+
+	ASSERT_EQ(phantom->GetRemovedObjects(), std::vector<LWOOBJID>({ 2, 3 }));
+	ASSERT_TRUE(IsColliding(phantom, staying));
+	ASSERT_FALSE(IsColliding(phantom, teleported));
+	ASSERT_EQ(phantom->GetCurrentlyCollidingObjects().size(), 1);
+}
+
+/**
+ * @brief Check that a phantom reaching into the cell of an entity from any side keeps colliding with it, including the cells the entity is checked from after crossing over
+ *
+ */
+TEST_F(dpGridTest, NeighbouringCells) {
+	// Phantoms in the cells on the +x and +z side of the cell the player moves into
+	auto* phantomX = AddEntity(1, NiPoint3(210, 0, 0), 80, true);
+	auto* phantomZ = AddEntity(2, NiPoint3(0, 0, 210), 80, true);
+	auto* player = AddEntity(3, NiPoint3(215, 0, 0), 1, false);
+
+	grid->Update(0.1f);
+	ASSERT_TRUE(IsColliding(phantomX, player));
+	ASSERT_FALSE(IsColliding(phantomZ, player));
+
+	player->SetPosition(NiPoint3(190, 0, 0));
+	grid->Update(0.1f);
+	ASSERT_TRUE(IsColliding(phantomX, player));
+	ASSERT_TRUE(phantomX->GetRemovedObjects().empty());
+
+	player->SetPosition(NiPoint3(0, 0, 190));
+	grid->Update(0.1f);
+	ASSERT_TRUE(IsColliding(phantomZ, player));
+	ASSERT_EQ(phantomZ->GetNewObjects(), std::vector<LWOOBJID>({ 3 }));
+	ASSERT_EQ(phantomX->GetRemovedObjects(), std::vector<LWOOBJID>({ 3 }));
+}
+
+/**
+ * @brief Check that positions beyond the grid are clamped into its edge cells, and that deleting keeps the rest intact
+ *
+ */
+TEST_F(dpGridTest, EdgesAndDelete) {
+	std::vector<dpEntity*> entities;
+	for (int i = 0; i < 8; i++) {
+		entities.push_back(AddEntity(10 + i, NiPoint3(100000.0f, 0, 100000.0f + i), 5, true));
+	}
+
+	auto* player = AddEntity(100, NiPoint3(100000.0f, 0, 100003.0f), 1, false);
+
+	grid->Delete(entities[0]);
+	grid->Delete(entities[5]);
+
+	grid->Update(0.1f);
+
+	for (size_t i = 1; i < entities.size(); i++) {
+		if (i == 5) continue;
+		ASSERT_TRUE(IsColliding(entities[i], player)) << i;
+	}
+
+	ASSERT_EQ(grid->GetEntities().size(), 7);
+	ASSERT_EQ(grid->GetOccupiedCellCount(), 1);
+}
+
+/**
+ * @brief Check that updating on several threads finds the same new and removed objects, in the same order, as a single thread
+ *
+ */
+TEST_F(dpGridTest, ParallelMatchesSingleThreaded) {
+	auto* parallelGrid = new dpGrid(12, 205, 4);
+	std::vector<dpEntity*> phantoms[2];
+	std::vector<dpEntity*> players[2];
+
+	for (int i = 0; i < 2; i++) {
+		auto* target = i == 0 ? grid : parallelGrid;
+
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> position(-600.0f, 600.0f);
+		std::uniform_real_distribution<float> radius(5.0f, 60.0f);
+
+		LWOOBJID id = 1;
+		for (int j = 0; j < 2000; j++) {
+			phantoms[i].push_back(AddEntity(target, id++, NiPoint3(position(random), 0, position(random)), radius(random), true));
+		}
+
+		for (int j = 0; j < 300; j++) {
+			players[i].push_back(AddEntity(target, id++, NiPoint3(position(random), 0, position(random)), 1.5f, false));
+		}
+	}
+
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> offset(-40.0f, 40.0f);
+	size_t changes = 0;
+
+	for (int step = 0; step < 10; step++) {
+		grid->Update(0.1f);
+		parallelGrid->Update(0.1f);
+
+		for (size_t j = 0; j < phantoms[0].size(); j++) {
+			ASSERT_EQ(phantoms[0][j]->GetNewObjects(), phantoms[1][j]->GetNewObjects());
+			ASSERT_EQ(phantoms[0][j]->GetRemovedObjects(), phantoms[1][j]->GetRemovedObjects());
+			ASSERT_EQ(phantoms[0][j]->GetCurrentlyCollidingObjects().size(), phantoms[1][j]->GetCurrentlyCollidingObjects().size());
+
+			changes += phantoms[0][j]->GetNewObjects().size() + phantoms[0][j]->GetRemovedObjects().size();
+		}
+
+		for (size_t j = 0; j < players[0].size(); j++) {
+			const auto moved = players[0][j]->GetPosition() + NiPoint3(offset(random), 0, offset(random));
+			players[0][j]->SetPosition(moved);
+			players[1][j]->SetPosition(moved);
+		}
+	}
+
+	ASSERT_GT(changes, 0);
+
+	delete parallelGrid;
+}
+
+/**
+ * @brief Benchmark of a physics step in synthetic zones full of phantoms with moving players, run with --gtest_also_run_disabled_tests.
+ * The timings are recorded as test properties in the XML output.
+ *
+ */
+TEST_F(dpGridTest, DISABLED_Benchmark) {
+	const size_t phantomCounts[] = { 5000, 10000, 20000 };
+	const uint32_t threadCounts[] = { 1, 0 };
+	const size_t playerCount = 200;
+	const size_t steps = 20;
+	const float extent = 6 * 205.0f;
+
+	for (const auto threadCount : threadCounts) {
+		for (const auto phantomCount : phantomCounts) {
+			delete grid;
+			grid = new dpGrid(12, 205, threadCount);
+
+			std::mt19937 random(1234);
+			std::uniform_real_distribution<float> position(-extent, extent);
+			std::uniform_real_distribution<float> radius(1.0f, 20.0f);
+
+			LWOOBJID id = 1;
+			for (size_t i = 0; i < phantomCount; i++) {
+				AddEntity(id++, NiPoint3(position(random), 0, position(random)), radius(random), true);
+			}
+
+			std::vector<dpEntity*> players;
+			for (size_t i = 0; i < playerCount; i++) {
+				players.push_back(AddEntity(id++, NiPoint3(position(random), 0, position(random)), 1.5f, false));
+			}
+
+			std::chrono::nanoseconds moveTime{ 0 };
+			std::chrono::nanoseconds updateTime{ 0 };
+
+			for (size_t step = 0; step < steps; step++) {
+				auto start = std::chrono::high_resolution_clock::now();
+				for (auto* player : players) {
+					player->SetPosition(NiPoint3(position(random), 0, position(random)));
+				}
+				moveTime += std::chrono::high_resolution_clock::now() - start;
+
+				start = std::chrono::high_resolution_clock::now();
+				grid->Update(1.0f / 60.0f);
+				updateTime += std::chrono::high_resolution_clock::now() - start;
+			}
+
+			const auto prefix = std::string(threadCount == 0 ? "us_all_threads_" : "us_1_thread_") + std::to_string(phantomCount) + "_phantoms_";
+
+			RecordProperty(prefix + "step", static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(updateTime).count() / steps));
+			RecordProperty(prefix + "moves", static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(moveTime).count() / steps));
+		}
+	}
+}